@@ -0,0 +1,100 @@
+/** @file ex_codec.cpp
+ *
+ *  Benchmark: delta/zigzag varint and bitpack codecs
+ *  on a monotone nanosecond timestamp column.
+ **/
+
+#include "xo/unit/column_codec.hpp"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cstring>
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    template <typename Fn>
+    double
+    ns_per_value(std::size_t n_rep, std::size_t n_value, Fn && fn)
+    {
+        auto t0 = clock_type::now();
+        for (std::size_t i = 0; i < n_rep; ++i)
+            fn();
+        auto t1 = clock_type::now();
+
+        return (std::chrono::duration<double, std::nano>(t1 - t0).count()
+                / static_cast<double>(n_rep * n_value));
+    }
+}
+
+int
+main() {
+    using namespace xo::qty;
+    using namespace std;
+
+    using t_type = quantity<u::nanosecond, std::int64_t>;
+
+    constexpr std::size_t n_block = 4096;
+    constexpr std::size_t n_value = 1 << 22;
+    constexpr std::size_t n_rep = 10;
+
+    /* ~1us spacing with exponential jitter */
+    std::mt19937_64 rng(12345);
+    std::exponential_distribution<double> gap(1.0 / 1000.0);
+
+    std::vector<t_type> t_v(n_value);
+    std::int64_t t = 1700000000000000000;
+    for (auto & x : t_v) {
+        t += 1 + static_cast<std::int64_t>(gap(rng));
+        x = t_type(t);
+    }
+
+    std::size_t raw_z = n_value * sizeof(t_type);
+
+    for (int_codec codec : { int_codec::varint, int_codec::bitpack }) {
+        std::vector<std::byte> buf((n_value / n_block) * encoded_block_bound(n_block));
+        std::vector<std::size_t> block_z_v;
+
+        std::size_t z = 0;
+        for (std::size_t i = 0; i < n_value; i += n_block) {
+            std::size_t bz = encode_block(codec,
+                                          std::span<const t_type>(t_v).subspan(i, n_block),
+                                          std::span<std::byte>(buf).subspan(z));
+            block_z_v.push_back(bz);
+            z += bz;
+        }
+
+        std::vector<t_type> out_v(n_value);
+
+        double decode_ns = ns_per_value(n_rep, n_value, [&]() {
+            std::size_t pos = 0;
+            for (std::size_t i = 0, b = 0; i < n_value; i += n_block, ++b) {
+                decode_block(std::span<const std::byte>(buf).subspan(pos, block_z_v[b]),
+                             std::span<t_type>(out_v).subspan(i, n_block));
+                pos += block_z_v[b];
+            }
+        });
+
+        bool ok = (std::memcmp(out_v.data(), t_v.data(), raw_z) == 0);
+
+        cerr << ((codec == int_codec::varint) ? "varint:  " : "bitpack: ")
+             << "ratio " << static_cast<double>(raw_z) / static_cast<double>(z)
+             << ", decode " << decode_ns << " ns/value"
+             << " (" << 1e3 / decode_ns << " Mvalue/s)"
+             << (ok ? "" : " MISMATCH") << endl;
+    }
+
+    /* baseline: memcpy of uncompressed column */
+    {
+        std::vector<t_type> out_v(n_value);
+
+        double copy_ns = ns_per_value(n_rep, n_value, [&]() {
+            std::memcpy(out_v.data(), t_v.data(), raw_z);
+        });
+
+        cerr << "memcpy:  ratio 1, " << copy_ns << " ns/value" << endl;
+    }
+}
+
+/** end ex_codec.cpp **/
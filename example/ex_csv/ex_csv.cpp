@@ -0,0 +1,68 @@
+/** @file ex_csv.cpp
+ *
+ *  Benchmark: parallel ingest of a unit-annotated CSV,
+ *  converting microseconds -> milliseconds on load.
+ **/
+
+#include "xo/unit/csv_reader.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+
+int
+main() {
+    using namespace xo::qty;
+    using namespace std;
+
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr std::size_t n_row = 4000000;
+
+    std::mt19937_64 rng(12345);
+    std::uniform_real_distribution<double> u01(0.0, 1.0);
+
+    std::string text = "ts[ns],latency[us],notional[ccy]\n";
+    text.reserve(n_row * 48);
+
+    std::int64_t t = 1700000000000000000;
+    for (std::size_t i = 0; i < n_row; ++i) {
+        t += 1000;
+        text += std::to_string(t);
+        text += ',';
+        text += std::to_string(10.0 + 90.0 * u01(rng));
+        text += ',';
+        text += std::to_string(1e6 * u01(rng));
+        text += '\n';
+    }
+
+    std::size_t hw = std::max(1u, std::thread::hardware_concurrency());
+
+    for (std::size_t n_thread = 1; n_thread <= hw; n_thread *= 2) {
+        csv_reader rdr;
+        rdr.attach(text);
+
+        std::vector<quantity<u::nanosecond, std::int64_t>> ts_v;
+        std::vector<quantity<u::millisecond>> latency_v;
+        std::vector<xquantity<double>> notional_v;
+
+        rdr.bind("ts", &ts_v);
+        rdr.bind("latency", &latency_v);
+        rdr.bind("notional", &notional_v);
+
+        auto t0 = clock_type::now();
+        std::size_t n = rdr.read(n_thread);
+        auto t1 = clock_type::now();
+
+        double sec = std::chrono::duration<double>(t1 - t0).count();
+
+        cerr << "threads " << n_thread
+             << ": " << n << " rows in " << sec * 1e3 << " ms"
+             << " (" << static_cast<double>(text.size()) / sec / 1e6 << " MB/s)"
+             << ", errors " << rdr.n_error() << endl;
+    }
+}
+
+/** end ex_csv.cpp **/
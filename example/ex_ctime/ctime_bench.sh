@@ -0,0 +1,134 @@
+#!/usr/bin/env bash
+#
+# xo-unit/example/ex_ctime/ctime_bench.sh
+#
+# Compile-time benchmark for quantity-heavy translation units.
+#
+# Generates N translation units,  each exercising quantity multiply,
+# divide, add, subtract and rescale across a different rotation of units,
+# then compiles each one and reports wall time.
+# Also reports cost of a TU that only includes the header.
+#
+# With gcc,  per-phase totals come from -ftime-report;
+# with clang,  a -ftime-trace json is written beside each object
+# (load in chrome://tracing or speedscope).
+#
+# usage:
+#   ctime_bench.sh [-n N] [-o OUTDIR] [-I DIR]...
+#
+# environment:
+#   CXX       compiler (default: c++)
+#   CXXFLAGS  extra flags (default: -O2)
+#
+# example:
+#   CXX=g++ ./ctime_bench.sh -n 8 -I include -I ~/local/include
+
+set -euo pipefail
+
+n_tu=4
+outdir=$(mktemp -d /tmp/xo-unit-ctime.XXXXXX)
+incdirs=()
+
+while getopts "n:o:I:" opt; do
+    case ${opt} in
+        n) n_tu=${OPTARG} ;;
+        o) outdir=${OPTARG} ;;
+        I) incdirs+=(-I "${OPTARG}") ;;
+        *) echo "usage: $0 [-n N] [-o OUTDIR] [-I DIR]..." >&2; exit 1 ;;
+    esac
+done
+
+cxx=${CXX:-c++}
+cxxflags=(-std=c++20 ${CXXFLAGS:--O2})
+
+if ${cxx} --version | grep -qi clang; then
+    timeflag=-ftime-trace
+else
+    timeflag=-ftime-report
+fi
+
+mkdir -p "${outdir}"
+
+units=(meters kilometers seconds milliseconds minutes hours grams kilograms bytes kilobytes)
+n_unit=${#units[@]}
+
+# write TU number $1 to stdout
+gen_tu() {
+    local k=$1
+
+    echo '#include "xo/unit/quantity.hpp"'
+    echo ''
+    echo 'using namespace xo::qty;'
+    echo ''
+    echo "double f${k}(double x) {"
+    echo '    double s = 0.0;'
+
+    for ((i = 0; i < n_unit; ++i)); do
+        local a=${units[$(( (i + k) % n_unit ))]}
+
+        for ((j = 0; j < n_unit; ++j)); do
+            local b=${units[$(( (j + 2 * k) % n_unit ))]}
+
+            echo "    s += (qty::${a}(x) * qty::${b}(x)).scale() + (qty::${a}(x) / qty::${b}(2.0)).scale();"
+        done
+
+        echo "    s += (qty::${a}(x) + qty::${a}(1.0)).scale() + (qty::${a}(x) - qty::${a}(1.0)).scale();"
+    done
+
+    echo '    s += qty::kilometers(x).rescale_ext<u::meter>().scale();'
+    echo '    s += (qty::meters(x) / qty::seconds(1.0)).rescale_ext<u::kilometer / u::hour>().scale();'
+    echo '    return s;'
+    echo '}'
+}
+
+# compile $1;  print wall-clock milliseconds.  Per-phase report to $1.time
+compile_ms() {
+    local src=$1
+    local t0 t1
+
+    t0=$(date +%s%N)
+    ${cxx} "${cxxflags[@]}" "${incdirs[@]}" ${timeflag} -c "${src}" -o "${src%.cpp}.o" 2> "${src}.time"
+    t1=$(date +%s%N)
+
+    echo $(( (t1 - t0) / 1000000 ))
+}
+
+echo '#include "xo/unit/quantity.hpp"' > "${outdir}/header_only.cpp"
+
+for ((k = 0; k < n_tu; ++k)); do
+    gen_tu ${k} > "${outdir}/tu${k}.cpp"
+done
+
+echo "compiler: $(${cxx} --version | head -1)"
+echo "flags:    ${cxxflags[*]}"
+echo "outdir:   ${outdir}"
+echo
+
+printf "%-20s %8s\n" "tu" "ms"
+printf "%-20s %8d\n" "header_only" "$(compile_ms "${outdir}/header_only.cpp")"
+
+total=0
+for ((k = 0; k < n_tu; ++k)); do
+    ms=$(compile_ms "${outdir}/tu${k}.cpp")
+    total=$(( total + ms ))
+    printf "%-20s %8d\n" "tu${k}" "${ms}"
+done
+
+printf "%-20s %8d\n" "total" "${total}"
+printf "%-20s %8d\n" "mean" "$(( total / n_tu ))"
+
+if [[ ${timeflag} == -ftime-report ]]; then
+    echo
+    echo "gcc phases,  summed wall seconds over generated TUs:"
+    cat "${outdir}"/tu*.cpp.time \
+        | awk -F: '/phase|template instantiation|constant expression evaluation/ {
+                       t = $2; gsub(/\([^)]*\)/, "", t);
+                       split(t, f, " ");
+                       name = $1; gsub(/^ +| +$/, "", name);
+                       wall[name] += f[3];
+                   }
+                   END { for (x in wall) printf("  %7.2f  %s\n", wall[x], x); }' \
+        | sort -rn
+fi
+
+# end ctime_bench.sh
@@ -0,0 +1,179 @@
+#!/usr/bin/env bash
+#
+# xo-unit/example/ex_mangle/mangle_bench.sh
+#
+# Symbol-size benchmark:  plain quantity vs tagged_quantity (see unit_tag.hpp)
+# at API boundaries.
+#
+# Generates N translation units,  each defining M out-of-line functions
+# that take and return quantities over a rotation of units,
+# plus a main() calling all of them.
+# Builds the workload twice:
+#   plain:   parameters/results spelled quantity<u::...>
+#   tagged:  parameters/results spelled tagged_quantity<..._tag>
+# and reports symbol-name bytes,  object/binary size and link time.
+#
+# usage:
+#   mangle_bench.sh [-n N] [-m M] [-o OUTDIR] [-I DIR]...
+#
+# environment:
+#   CXX       compiler (default: c++)
+#   CXXFLAGS  extra flags (default: -O2 -g)
+#
+# example:
+#   CXX=g++ ./mangle_bench.sh -n 8 -m 64 -I include -I ~/local/include
+
+set -euo pipefail
+
+n_tu=4
+n_fn=32
+outdir=$(mktemp -d /tmp/xo-unit-mangle.XXXXXX)
+incdirs=()
+
+while getopts "n:m:o:I:" opt; do
+    case ${opt} in
+        n) n_tu=${OPTARG} ;;
+        m) n_fn=${OPTARG} ;;
+        o) outdir=${OPTARG} ;;
+        I) incdirs+=(-I "${OPTARG}") ;;
+        *) echo "usage: $0 [-n N] [-m M] [-o OUTDIR] [-I DIR]..." >&2; exit 1 ;;
+    esac
+done
+
+cxx=${CXX:-c++}
+cxxflags=(-std=c++20 ${CXXFLAGS:--O2 -g})
+
+mkdir -p "${outdir}"
+
+# unit expression, tag name
+units=("u::meter"                 m_tag
+       "u::kilometer"             km_tag
+       "u::second"                s_tag
+       "u::millisecond"           ms_tag
+       "u::meter / u::second"     mps_tag
+       "u::kilometer / u::hour"   kph_tag
+       "u::kilogram"              kg_tag
+       "u::kilogram * u::meter / (u::second * u::second)" newton_tag)
+n_unit=$(( ${#units[@]} / 2 ))
+
+# common header:  Q(i) names the i'th unit's quantity type
+gen_header() {
+    echo '#pragma once'
+    echo '#include "xo/unit/unit_tag.hpp"'
+    echo ''
+    echo 'using namespace xo::qty;'
+    echo ''
+    for ((i = 0; i < n_unit; ++i)); do
+        echo "XO_UNIT_TAG(${units[$(( 2 * i + 1 ))]}, ${units[$(( 2 * i ))]});"
+    done
+    echo ''
+    echo '#ifdef MANGLE_TAGGED'
+    for ((i = 0; i < n_unit; ++i)); do
+        echo "using q${i} = tagged_quantity<${units[$(( 2 * i + 1 ))]}>;"
+    done
+    echo '#else'
+    for ((i = 0; i < n_unit; ++i)); do
+        echo "using q${i} = quantity<${units[$(( 2 * i ))]}>;"
+    done
+    echo '#endif'
+    echo ''
+    for ((k = 0; k < n_tu; ++k)); do
+        for ((j = 0; j < n_fn; ++j)); do
+            local a=$(( (j + k) % n_unit ))
+            local b=$(( (2 * j + k + 1) % n_unit ))
+            echo "q${a} f${k}_${j}(q${a} x, q${b} y);"
+        done
+    done
+}
+
+# TU number $1:  function bodies
+gen_tu() {
+    local k=$1
+
+    echo '#include "decl.hpp"'
+    echo ''
+    for ((j = 0; j < n_fn; ++j)); do
+        local a=$(( (j + k) % n_unit ))
+        local b=$(( (2 * j + k + 1) % n_unit ))
+        echo "q${a} f${k}_${j}(q${a} x, q${b} y) { return q${a}(x.scale() * ${j}.5 + y.scale()); }"
+    done
+}
+
+gen_main() {
+    echo '#include "decl.hpp"'
+    echo ''
+    echo 'int main() {'
+    echo '    double s = 0.0;'
+    for ((k = 0; k < n_tu; ++k)); do
+        for ((j = 0; j < n_fn; ++j)); do
+            local a=$(( (j + k) % n_unit ))
+            local b=$(( (2 * j + k + 1) % n_unit ))
+            echo "    s += f${k}_${j}(q${a}(1.0), q${b}(2.0)).scale();"
+        done
+    done
+    echo '    return (s > 0.0) ? 0 : 1;'
+    echo '}'
+}
+
+gen_header > "${outdir}/decl.hpp"
+for ((k = 0; k < n_tu; ++k)); do
+    gen_tu ${k} > "${outdir}/tu${k}.cpp"
+done
+gen_main > "${outdir}/main.cpp"
+
+# build variant $1 (plain|tagged) into ${outdir}/$1;  print link milliseconds
+build() {
+    local variant=$1
+    local dir=${outdir}/${variant}
+    local defs=()
+    local t0 t1
+
+    [[ ${variant} == tagged ]] && defs=(-DMANGLE_TAGGED)
+
+    mkdir -p "${dir}"
+    for src in "${outdir}"/tu*.cpp "${outdir}/main.cpp"; do
+        local obj=${dir}/$(basename "${src%.cpp}").o
+        ${cxx} "${cxxflags[@]}" "${defs[@]}" "${incdirs[@]}" -I "${outdir}" -c "${src}" -o "${obj}"
+    done
+
+    t0=$(date +%s%N)
+    ${cxx} "${cxxflags[@]}" "${dir}"/*.o -o "${dir}/bench"
+    t1=$(date +%s%N)
+
+    "${dir}/bench"
+
+    echo $(( (t1 - t0) / 1000000 ))
+}
+
+# total bytes of mangled symbol names defined or referenced by objects in dir $1
+symbol_bytes() {
+    nm "$1"/*.o | awk 'NF >= 2 { n += length($NF) } END { print n }'
+}
+
+# longest symbol name in dir $1
+symbol_max() {
+    nm "$1"/*.o | awk 'NF >= 2 && length($NF) > n { n = length($NF) } END { print n }'
+}
+
+# total object bytes in dir $1
+object_bytes() {
+    cat "$1"/*.o | wc -c
+}
+
+echo "compiler: $(${cxx} --version | head -1)"
+echo "flags:    ${cxxflags[*]}"
+echo "workload: ${n_tu} TUs x ${n_fn} functions"
+echo "outdir:   ${outdir}"
+echo
+
+link_plain=$(build plain)
+link_tagged=$(build tagged)
+
+printf "%-24s %12s %12s\n" "" "plain" "tagged"
+printf "%-24s %12d %12d\n" "symbol name bytes" "$(symbol_bytes "${outdir}/plain")" "$(symbol_bytes "${outdir}/tagged")"
+printf "%-24s %12d %12d\n" "longest symbol" "$(symbol_max "${outdir}/plain")" "$(symbol_max "${outdir}/tagged")"
+printf "%-24s %12d %12d\n" "object bytes" "$(object_bytes "${outdir}/plain")" "$(object_bytes "${outdir}/tagged")"
+printf "%-24s %12d %12d\n" "binary bytes" "$(wc -c < "${outdir}/plain/bench")" "$(wc -c < "${outdir}/tagged/bench")"
+printf "%-24s %12d %12d\n" "link ms" "${link_plain}" "${link_tagged}"
+
+# end mangle_bench.sh
@@ -0,0 +1,120 @@
+/** @file ex_policy.cpp
+ *
+ *  Benchmark: result-unit policies on typical multiply/divide chains
+ *  over mixed-unit columns.
+ **/
+
+#include "xo/unit/unit_policy.hpp"
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    template <typename Fn>
+    double
+    ns_per_value(std::size_t n_rep, std::size_t n_value, Fn && fn)
+    {
+        auto t0 = clock_type::now();
+        for (std::size_t i = 0; i < n_rep; ++i)
+            fn();
+        auto t1 = clock_type::now();
+
+        return (std::chrono::duration<double, std::nano>(t1 - t0).count()
+                / static_cast<double>(n_rep * n_value));
+    }
+
+    using namespace xo::qty;
+
+    using km_type = quantity<u::kilometer>;
+    using m_type = quantity<u::meter>;
+    using ms_type = quantity<u::millisecond>;
+    using s_type = quantity<u::second>;
+
+    /** volume = a * b * c,  then density-like ratio volume / (t * t) **/
+    template <typename Policy>
+    double
+    chain(const std::vector<km_type> & a_v,
+          const std::vector<m_type> & b_v,
+          const std::vector<m_type> & c_v,
+          const std::vector<ms_type> & t_v,
+          const std::vector<s_type> & t2_v)
+    {
+        using arith = policy_arith<Policy>;
+
+        double sum = 0.0;
+
+        for (std::size_t i = 0, n = a_v.size(); i < n; ++i) {
+            auto vol = arith::multiply(arith::multiply(a_v[i], b_v[i]), c_v[i]);
+            auto r = arith::divide(vol, arith::multiply(t_v[i], t2_v[i]));
+
+            sum += r.scale();
+        }
+
+        return sum;
+    }
+
+    /** same chain using operator* and operator/ **/
+    double
+    chain_operators(const std::vector<km_type> & a_v,
+                    const std::vector<m_type> & b_v,
+                    const std::vector<m_type> & c_v,
+                    const std::vector<ms_type> & t_v,
+                    const std::vector<s_type> & t2_v)
+    {
+        double sum = 0.0;
+
+        for (std::size_t i = 0, n = a_v.size(); i < n; ++i) {
+            auto vol = a_v[i] * b_v[i] * c_v[i];
+            auto r = vol / (t_v[i] * t2_v[i]);
+
+            sum += r.scale();
+        }
+
+        return sum;
+    }
+}
+
+int
+main() {
+    using namespace std;
+
+    constexpr std::size_t n_value = 1 << 20;
+    constexpr std::size_t n_rep = 20;
+
+    std::mt19937_64 rng(12345);
+    std::uniform_real_distribution<double> unif(1.0, 2.0);
+
+    std::vector<km_type> a_v(n_value);
+    std::vector<m_type> b_v(n_value);
+    std::vector<m_type> c_v(n_value);
+    std::vector<ms_type> t_v(n_value);
+    std::vector<s_type> t2_v(n_value);
+
+    for (std::size_t i = 0; i < n_value; ++i) {
+        a_v[i] = km_type(unif(rng));
+        b_v[i] = m_type(unif(rng));
+        c_v[i] = m_type(unif(rng));
+        t_v[i] = ms_type(unif(rng));
+        t2_v[i] = s_type(unif(rng));
+    }
+
+    double sink = 0.0;
+
+    auto report = [&](const char * name, auto && fn) {
+        double ns = ns_per_value(n_rep, n_value, [&]() { sink += fn(); });
+
+        cerr << name << ns << " ns/row" << endl;
+    };
+
+    report("operators:    ", [&]() { return chain_operators(a_v, b_v, c_v, t_v, t2_v); });
+    report("left_wins:    ", [&]() { return chain<unit_policy::left_wins>(a_v, b_v, c_v, t_v, t2_v); });
+    report("si_canonical: ", [&]() { return chain<unit_policy::si_canonical>(a_v, b_v, c_v, t_v, t2_v); });
+    report("finest_unit:  ", [&]() { return chain<unit_policy::finest_unit>(a_v, b_v, c_v, t_v, t2_v); });
+
+    cerr << "(checksum " << sink << ")" << endl;
+}
+
+/** end ex_policy.cpp **/
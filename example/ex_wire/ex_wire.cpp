@@ -0,0 +1,114 @@
+/** @file ex_wire.cpp
+ *
+ *  Benchmark: binary wire format for xquantity vs. text round-trip
+ *  (scale + unit abbreviation).
+ **/
+
+#include "xo/unit/unit_wire.hpp"
+#include "xo/unit/xquantity_iostream.hpp"
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+    using clock_type = std::chrono::steady_clock;
+
+    template <typename Fn>
+    double
+    ns_per_item(std::size_t n_item, Fn && fn)
+    {
+        auto t0 = clock_type::now();
+        fn();
+        auto t1 = clock_type::now();
+
+        return (std::chrono::duration<double, std::nano>(t1 - t0).count()
+                / static_cast<double>(n_item));
+    }
+}
+
+int
+main() {
+    using namespace xo::qty;
+    namespace wire = xo::qty::detail::wire;
+    using namespace std;
+
+    using xq_type = xquantity<double>;
+
+    constexpr std::size_t n_item = 1000000;
+
+    std::vector<xq_type> src_v;
+    src_v.reserve(n_item);
+    for (std::size_t i = 0; i < n_item; ++i) {
+        src_v.push_back(xq_type(0.5 * static_cast<double>(i),
+                                wire::builtin_unit_v[i % wire::n_builtin]));
+    }
+
+    /* binary */
+    std::vector<std::byte> buf(n_item * 16);
+    std::vector<xq_type> bin_v(n_item);
+
+    double bin_encode_ns = ns_per_item(n_item, [&]() {
+        wire_writer<> w(buf);
+        for (const auto & x : src_v)
+            w.write(x);
+        buf.resize(w.size());
+    });
+
+    double bin_decode_ns = ns_per_item(n_item, [&]() {
+        wire_reader<> r(buf);
+        for (auto & x : bin_v)
+            r.read(&x);
+    });
+
+    /* text:  "%.17g abbrev\n";  decode by matching abbrev against built-in units */
+    std::vector<char> text(n_item * 40);
+    std::vector<xq_type> text_v(n_item);
+    std::size_t text_z = 0;
+
+    double text_encode_ns = ns_per_item(n_item, [&]() {
+        char * p = text.data();
+        for (const auto & x : src_v)
+            p += snprintf(p, 40, "%.17g %s\n", x.scale(), x.unit().abbrev().c_str());
+        text_z = p - text.data();
+    });
+
+    double text_decode_ns = ns_per_item(n_item, [&]() {
+        char * p = text.data();
+        for (auto & x : text_v) {
+            double scale = strtod(p, &p);
+            ++p;
+            char * e = strchr(p, '\n');
+            *e = '\0';
+
+            for (unit_code_type i = 0; i < wire::n_builtin; ++i) {
+                if (strcmp(wire::builtin_unit_v[i].abbrev().c_str(), p) == 0) {
+                    x = xq_type(scale, wire::builtin_unit_v[i]);
+                    break;
+                }
+            }
+
+            p = e + 1;
+        }
+    });
+
+    std::size_t n_mismatch = 0;
+    for (std::size_t i = 0; i < n_item; ++i) {
+        if ((bin_v[i].scale() != src_v[i].scale()) || (bin_v[i].unit() != src_v[i].unit()))
+            ++n_mismatch;
+        if ((text_v[i].scale() != src_v[i].scale()) || (text_v[i].unit() != src_v[i].unit()))
+            ++n_mismatch;
+    }
+
+    cerr << "binary: " << buf.size() << " bytes"
+         << ", encode " << bin_encode_ns << " ns/item"
+         << ", decode " << bin_decode_ns << " ns/item" << endl;
+    cerr << "text:   " << text_z << " bytes"
+         << ", encode " << text_encode_ns << " ns/item"
+         << ", decode " << text_decode_ns << " ns/item" << endl;
+    cerr << "mismatches: " << n_mismatch << endl;
+}
+
+/** end ex_wire.cpp **/
@@ -0,0 +1,185 @@
+/** @file atomic_quantity.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "rescale_column.hpp"
+#include <atomic>
+#include <array>
+#include <cmath>
+
+namespace xo {
+    namespace qty {
+        /** @class atomic_quantity
+         *  @brief quantity with compile-time unit,  supporting atomic operations.
+         *
+         *  Wraps @c std::atomic<Repr>.  Arguments in a different (but same-dimension)
+         *  unit are converted by a compile-time factor before the atomic operation;
+         *  arguments with different dimension fail to compile.
+         *
+         *  @code
+         *  atomic_quantity<u::second> busy;
+         *  busy.fetch_add(qty::milliseconds(250));   // adds 0.25
+         *  @endcode
+         **/
+        template <auto ScaledUnit, typename Repr = double>
+        requires (ScaledUnit.is_natural())
+        class atomic_quantity {
+        public:
+            using value_type = quantity<ScaledUnit, Repr>;
+            using repr_type = Repr;
+
+            static constexpr bool is_always_lock_free = std::atomic<Repr>::is_always_lock_free;
+
+        public:
+            constexpr atomic_quantity() : scale_{0} {}
+            explicit constexpr atomic_quantity(const value_type & x) : scale_{x.scale()} {}
+
+            atomic_quantity(const atomic_quantity &) = delete;
+            atomic_quantity & operator=(const atomic_quantity &) = delete;
+
+            /** @defgroup atomic-quantity-methods atomic_quantity methods **/
+            ///@{
+
+            bool is_lock_free() const { return scale_.is_lock_free(); }
+
+            value_type load(std::memory_order order = std::memory_order_seq_cst) const {
+                return value_type(scale_.load(order));
+            }
+
+            template <typename Q2>
+            requires (quantity_concept<Q2> && Q2::always_constexpr_unit)
+            void store(const Q2 & x, std::memory_order order = std::memory_order_seq_cst) {
+                scale_.store(detail::scale_in<ScaledUnit, Repr>(x), order);
+            }
+
+            template <typename Q2>
+            requires (quantity_concept<Q2> && Q2::always_constexpr_unit)
+            value_type exchange(const Q2 & x, std::memory_order order = std::memory_order_seq_cst) {
+                return value_type(scale_.exchange(detail::scale_in<ScaledUnit, Repr>(x), order));
+            }
+
+            /** add @p x (converted to @c ScaledUnit).  @return previous value **/
+            template <typename Q2>
+            requires (quantity_concept<Q2> && Q2::always_constexpr_unit)
+            value_type fetch_add(const Q2 & x, std::memory_order order = std::memory_order_seq_cst) {
+                return value_type(scale_.fetch_add(detail::scale_in<ScaledUnit, Repr>(x), order));
+            }
+
+            /** subtract @p x (converted to @c ScaledUnit).  @return previous value **/
+            template <typename Q2>
+            requires (quantity_concept<Q2> && Q2::always_constexpr_unit)
+            value_type fetch_sub(const Q2 & x, std::memory_order order = std::memory_order_seq_cst) {
+                return value_type(scale_.fetch_sub(detail::scale_in<ScaledUnit, Repr>(x), order));
+            }
+
+            /** replace value with @p desired if it equals @p *p_expected;
+             *  otherwise load current value into @p *p_expected.
+             **/
+            bool compare_exchange_weak(value_type * p_expected, const value_type & desired,
+                                       std::memory_order order = std::memory_order_seq_cst) {
+                Repr expected = p_expected->scale();
+                bool retval = scale_.compare_exchange_weak(expected, desired.scale(), order);
+
+                *p_expected = value_type(expected);
+                return retval;
+            }
+
+            /** strong version of @ref compare_exchange_weak **/
+            bool compare_exchange_strong(value_type * p_expected, const value_type & desired,
+                                         std::memory_order order = std::memory_order_seq_cst) {
+                Repr expected = p_expected->scale();
+                bool retval = scale_.compare_exchange_strong(expected, desired.scale(), order);
+
+                *p_expected = value_type(expected);
+                return retval;
+            }
+
+            ///@}
+
+        private:
+            std::atomic<Repr> scale_;
+        };
+
+        /** @class sharded_counter
+         *  @brief contention-free accumulator for high-rate metrics (bytes sent,  fills ..)
+         *
+         *  Holds @p NShard atomic accumulators,  each on its own cache line.
+         *  Each thread is assigned a shard (round-robin,  on first use),
+         *  and adds to it with a relaxed @c fetch_add,  so concurrent writers
+         *  on different cores don't share a cache line.
+         *  @ref load sums all shards.
+         *
+         *  With more than @p NShard writer threads,  threads share shards;
+         *  result remains exact,  only contention increases.
+         **/
+        template <auto ScaledUnit, typename Repr = double, std::size_t NShard = 64>
+        requires (ScaledUnit.is_natural() && (NShard > 0))
+        class sharded_counter {
+        public:
+            using value_type = quantity<ScaledUnit, Repr>;
+            using repr_type = Repr;
+
+            static constexpr std::size_t c_cache_line = 64;
+            static constexpr std::size_t n_shard = NShard;
+
+        public:
+            sharded_counter() = default;
+            sharded_counter(const sharded_counter &) = delete;
+            sharded_counter & operator=(const sharded_counter &) = delete;
+
+            /** @defgroup sharded-counter-methods sharded_counter methods **/
+            ///@{
+
+            /** add @p x (converted to @c ScaledUnit) to calling thread's shard **/
+            template <typename Q2>
+            requires (quantity_concept<Q2> && Q2::always_constexpr_unit)
+            void add(const Q2 & x) {
+                shard_v_[this_shard()].scale_.fetch_add(detail::scale_in<ScaledUnit, Repr>(x),
+                                                        std::memory_order_relaxed);
+            }
+
+            /** sum over all shards.
+             *  Not a snapshot:  concurrent adds may or may not be included.
+             **/
+            value_type load() const {
+                Repr sum = 0;
+
+                for (const auto & s : shard_v_)
+                    sum += s.scale_.load(std::memory_order_relaxed);
+
+                return value_type(sum);
+            }
+
+            /** reset all shards to zero.  Adds concurrent with reset may be lost **/
+            void reset() {
+                for (auto & s : shard_v_)
+                    s.scale_.store(0, std::memory_order_relaxed);
+            }
+
+            ///@}
+
+        private:
+            struct alignas(c_cache_line) shard {
+                std::atomic<Repr> scale_{0};
+            };
+
+            static_assert(sizeof(shard) == c_cache_line);
+
+            /** shard index for calling thread;  assigned once per thread **/
+            static std::size_t this_shard() {
+                static std::atomic<std::size_t> s_next{0};
+                thread_local std::size_t t_shard = s_next.fetch_add(1, std::memory_order_relaxed) % NShard;
+
+                return t_shard;
+            }
+
+        private:
+            std::array<shard, NShard> shard_v_;
+        };
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end atomic_quantity.hpp **/
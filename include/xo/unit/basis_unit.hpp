@@ -86,25 +86,25 @@ namespace xo {
                 /** @defgroup basis-unit-mass-units basis_unit mass units **/
                 ///@{
                 /** basis unit of 10^-12 grams **/
-                constexpr basis_unit picogram         = mass_unit(               1, 1000000000000);
+                inline constexpr basis_unit picogram         = mass_unit(               1, 1000000000000);
                 /** basis unit of 10^-9 grams **/
-                constexpr basis_unit nanogram         = mass_unit(               1,    1000000000);
+                inline constexpr basis_unit nanogram         = mass_unit(               1,    1000000000);
                 /** basis unit of 10^-6 grams **/
-                constexpr basis_unit microgram        = mass_unit(               1,       1000000);
+                inline constexpr basis_unit microgram        = mass_unit(               1,       1000000);
                 /** basis unit of 10^-3 grams **/
-                constexpr basis_unit milligram        = mass_unit(               1,          1000);
+                inline constexpr basis_unit milligram        = mass_unit(               1,          1000);
                 /** basis unit of 1 gram **/
-                constexpr basis_unit gram             = mass_unit(               1,             1);
+                inline constexpr basis_unit gram             = mass_unit(               1,             1);
                 /** basis unit of 10^3 grams **/
-                constexpr basis_unit kilogram         = mass_unit(            1000,             1);
+                inline constexpr basis_unit kilogram         = mass_unit(            1000,             1);
                 /** basis unit of 10^6 grams = 10^3 kilograms **/
-                constexpr basis_unit tonne            = mass_unit(         1000000,             1);
+                inline constexpr basis_unit tonne            = mass_unit(         1000000,             1);
                 /** basis unit of 10^9 grams = 10^6 kilograms = 10^3 tonnes **/
-                constexpr basis_unit kilotonne        = mass_unit(      1000000000,             1);
+                inline constexpr basis_unit kilotonne        = mass_unit(      1000000000,             1);
                 /** basis unit of 10^12 grams = 10^9 kilograms = 10^6 tonnes **/
-                constexpr basis_unit megatonne        = mass_unit(   1000000000000,             1);
+                inline constexpr basis_unit megatonne        = mass_unit(   1000000000000,             1);
                 /** basis unit of 10^15 grams = 10^12 kilograms = 10^9 tonnes **/
-                constexpr basis_unit gigatonne        = mass_unit(1000000000000000,             1);
+                inline constexpr basis_unit gigatonne        = mass_unit(1000000000000000,             1);
                 ///@}
 
                 // ----- distance -----
@@ -117,53 +117,53 @@ namespace xo {
                 ///@{
                 /* US spelling */
                 /** basis unit of 10^-12 meters **/
-                constexpr basis_unit picometer        = distance_unit(            1, 1000000000000);
+                inline constexpr basis_unit picometer        = distance_unit(            1, 1000000000000);
                 /** basis unit of 10^-9 meters **/
-                constexpr basis_unit nanometer        = distance_unit(            1,    1000000000);
+                inline constexpr basis_unit nanometer        = distance_unit(            1,    1000000000);
                 /** basis unit of 10^-6 meters **/
-                constexpr basis_unit micrometer       = distance_unit(            1,       1000000);
+                inline constexpr basis_unit micrometer       = distance_unit(            1,       1000000);
                 /** basis unit of 10^-3 meters **/
-                constexpr basis_unit millimeter       = distance_unit(            1,          1000);
+                inline constexpr basis_unit millimeter       = distance_unit(            1,          1000);
                 /** basis unit of 1 meter **/
-                constexpr basis_unit meter            = distance_unit(            1,             1);
+                inline constexpr basis_unit meter            = distance_unit(            1,             1);
                 /** basis unit of 10^3 meters **/
-                constexpr basis_unit kilometer        = distance_unit(         1000,             1);
+                inline constexpr basis_unit kilometer        = distance_unit(         1000,             1);
                 /** basis unit of 10^6 meters (for form's sake -- not commonly used) **/
-                constexpr basis_unit megameter        = distance_unit(      1000000,             1);
+                inline constexpr basis_unit megameter        = distance_unit(      1000000,             1);
                 /** basis unit of 10^9 meters (for form's sake -- not commonly used) **/
-                constexpr basis_unit gigameter        = distance_unit(   1000000000,             1);
+                inline constexpr basis_unit gigameter        = distance_unit(   1000000000,             1);
 
                 /** basis unit of 1 light-second = distance light travels in a vacuum in 1 second **/
-                constexpr basis_unit lightsecond      = distance_unit(    299792458,             1);
+                inline constexpr basis_unit lightsecond      = distance_unit(    299792458,             1);
                 /** basis unit of 1 astronomical unit, representing approximate radius of earth orbit. **/
-                constexpr basis_unit astronomicalunit = distance_unit( 149597870700,             1);
+                inline constexpr basis_unit astronomicalunit = distance_unit( 149597870700,             1);
 
                 /* Int'l spelling */
                 /** international spelling for picometer **/
-                constexpr basis_unit picometre        = picometer;
+                inline constexpr basis_unit picometre        = picometer;
                 /** international spelling for nanometer **/
-                constexpr basis_unit nanometre        = nanometer;
+                inline constexpr basis_unit nanometre        = nanometer;
                 /** international spelling for micrometer **/
-                constexpr basis_unit micrometre       = micrometer;
+                inline constexpr basis_unit micrometre       = micrometer;
                 /** international spelling for millimeter **/
-                constexpr basis_unit millimetre       = millimeter;
+                inline constexpr basis_unit millimetre       = millimeter;
                 /** international spelling for meter **/
-                constexpr basis_unit metre            = meter;
+                inline constexpr basis_unit metre            = meter;
                 /** international spelling for kilometer **/
-                constexpr basis_unit kilometre        = kilometer;
+                inline constexpr basis_unit kilometre        = kilometer;
                 /** international spelling for megameter **/
-                constexpr basis_unit megametre        = megameter;
+                inline constexpr basis_unit megametre        = megameter;
                 /** international spelling for gigameter **/
-                constexpr basis_unit gigametre        = gigameter;
+                inline constexpr basis_unit gigametre        = gigameter;
 
                 /** @brief basis-unit representing 1 inch; defined as exactly 1/12 feet **/
-                constexpr basis_unit inch             = distance_unit(       3048, 120000);
+                inline constexpr basis_unit inch             = distance_unit(       3048, 120000);
                 /** @brief basis-unit representing 1 foot; defined as exactly 0.3048 meters **/
-                constexpr basis_unit foot             = distance_unit(       3048,  10000);
+                inline constexpr basis_unit foot             = distance_unit(       3048,  10000);
                 /** @brief basis-unit representing 1 yard; defined as exactly 3 feet **/
-                constexpr basis_unit yard             = distance_unit(     3*3048,  10000);
+                inline constexpr basis_unit yard             = distance_unit(     3*3048,  10000);
                 /** @brief basis-unit representing 1 mile; defined as exactly 1760 yards = 5280 feet **/
-                constexpr basis_unit mile             = distance_unit(  5280*3048,  10000);
+                inline constexpr basis_unit mile             = distance_unit(  5280*3048,  10000);
                 ///@}
 
                 // ----- time -----
@@ -175,37 +175,37 @@ namespace xo {
                 /** @defgroup basis-unit-time-units basis_unit time units **/
                 ///@{
                 /** basis unit of 10^-12 seconds **/
-                constexpr basis_unit picosecond       = time_unit(                   1, 1000000000000);
+                inline constexpr basis_unit picosecond       = time_unit(                   1, 1000000000000);
                 /** basis unit of 10^-9 seconds **/
-                constexpr basis_unit nanosecond       = time_unit(                   1,    1000000000);
+                inline constexpr basis_unit nanosecond       = time_unit(                   1,    1000000000);
                 /** basis unit of 10^-6 seconds **/
-                constexpr basis_unit microsecond      = time_unit(                   1,       1000000);
+                inline constexpr basis_unit microsecond      = time_unit(                   1,       1000000);
                 /** basis unit of 10^-3 seconds **/
-                constexpr basis_unit millisecond      = time_unit(                   1,          1000);
+                inline constexpr basis_unit millisecond      = time_unit(                   1,          1000);
                 /** basis unit of 1 second **/
-                constexpr basis_unit second           = time_unit(                   1,             1);
+                inline constexpr basis_unit second           = time_unit(                   1,             1);
                 /** basis unit of 1 minute = 60 seconds **/
-                constexpr basis_unit minute           = time_unit(                  60,             1);
+                inline constexpr basis_unit minute           = time_unit(                  60,             1);
                 /** basis unit of 1 hour = 3600 seconds **/
-                constexpr basis_unit hour             = time_unit(                3600,             1);
+                inline constexpr basis_unit hour             = time_unit(                3600,             1);
                 /** basis unit of 1 day = exactly 24 hours **/
-                constexpr basis_unit day              = time_unit(             24*3600,             1);
+                inline constexpr basis_unit day              = time_unit(             24*3600,             1);
                 /** basis unit of 1 week = exactly 7 days **/
-                constexpr basis_unit week             = time_unit(           7*24*3600,             1);
+                inline constexpr basis_unit week             = time_unit(           7*24*3600,             1);
                 /** basis unit of 1 month = exactly 30 days **/
-                constexpr basis_unit month            = time_unit(          30*24*3600,             1);
+                inline constexpr basis_unit month            = time_unit(          30*24*3600,             1);
                 /** basis unit of 1 year, defined as 365.25 days **/
-                constexpr basis_unit year             = time_unit(     (365*24+6)*3600,             1);
+                inline constexpr basis_unit year             = time_unit(     (365*24+6)*3600,             1);
 
                 /* alt conventions used in finance */
                 /** basis unit of 1 year365 = exactly 365 days **/
-                constexpr basis_unit year365          = time_unit(         365*24*3600,             1);
+                inline constexpr basis_unit year365          = time_unit(         365*24*3600,             1);
                 /** basis unit of 1 year360 = exactly 360 days **/
-                constexpr basis_unit year360          = time_unit(         360*24*3600,             1);
+                inline constexpr basis_unit year360          = time_unit(         360*24*3600,             1);
                 /** basis unit of 1 year250 = exactly 250 days.
                  *  Approximate number of business days in one year
                  **/
-                constexpr basis_unit year250          = time_unit(         250*24*3600,             1);
+                inline constexpr basis_unit year250          = time_unit(         250*24*3600,             1);
 
                 //constexpr basis_unit century          = time_unit( 100L*(365*24+6)*3600,             1);
                 //constexpr basis_unit millenium        = time_unit(1000L*(365*24+6)*3600,             1);
@@ -221,7 +221,7 @@ namespace xo {
                 }
 
                 /** pseudounit -- placeholder for any actual currency amount **/
-                constexpr basis_unit currency = currency_unit(1, 1);
+                inline constexpr basis_unit currency = currency_unit(1, 1);
 
                 // ----- price -----
 
@@ -230,7 +230,59 @@ namespace xo {
                 }
 
                 /** psuedounit -- context-dependent interpretation for a screen price **/
-                constexpr basis_unit price = price_unit(1, 1);
+                inline constexpr basis_unit price = price_unit(1, 1);
+                ///@}
+
+                // ----- information -----
+
+                constexpr basis_unit information_unit(std::int64_t num, std::int64_t den) {
+                    return basis_unit(dimension::information, scalefactor_ratio_type(num, den));
+                }
+
+                /** @defgroup basis-unit-information-units basis_unit information units **/
+                ///@{
+                /** basis unit of 1 bit = 1/8 byte **/
+                inline constexpr basis_unit bit              = information_unit(                1,             8);
+                /** basis unit of 1 byte **/
+                inline constexpr basis_unit byte             = information_unit(                1,             1);
+
+                /* SI (decimal) prefixes */
+                /** basis unit of 10^3 bytes **/
+                inline constexpr basis_unit kilobyte         = information_unit(             1000,             1);
+                /** basis unit of 10^6 bytes **/
+                inline constexpr basis_unit megabyte         = information_unit(          1000000,             1);
+                /** basis unit of 10^9 bytes **/
+                inline constexpr basis_unit gigabyte         = information_unit(       1000000000,             1);
+                /** basis unit of 10^12 bytes **/
+                inline constexpr basis_unit terabyte         = information_unit(    1000000000000,             1);
+
+                /* IEC (binary) prefixes */
+                /** basis unit of 2^10 bytes **/
+                inline constexpr basis_unit kibibyte         = information_unit(std::int64_t(1) << 10,             1);
+                /** basis unit of 2^20 bytes **/
+                inline constexpr basis_unit mebibyte         = information_unit(std::int64_t(1) << 20,             1);
+                /** basis unit of 2^30 bytes **/
+                inline constexpr basis_unit gibibyte         = information_unit(std::int64_t(1) << 30,             1);
+                /** basis unit of 2^40 bytes **/
+                inline constexpr basis_unit tebibyte         = information_unit(std::int64_t(1) << 40,             1);
+                ///@}
+
+                // ----- packet, message -----
+
+                constexpr basis_unit packet_unit(std::int64_t num, std::int64_t den) {
+                    return basis_unit(dimension::packet, scalefactor_ratio_type(num, den));
+                }
+
+                constexpr basis_unit message_unit(std::int64_t num, std::int64_t den) {
+                    return basis_unit(dimension::message, scalefactor_ratio_type(num, den));
+                }
+
+                /** @defgroup basis-unit-count-units basis_unit packet and message units **/
+                ///@{
+                /** basis unit of 1 network packet **/
+                inline constexpr basis_unit packet           = packet_unit(                   1,             1);
+                /** basis unit of 1 application message **/
+                inline constexpr basis_unit message          = message_unit(                  1,             1);
                 ///@}
             } /*namespace bu*/
         } /*namespace detail*/
@@ -42,7 +42,7 @@ namespace xo {
             }
 
             /** construct suffix abbreviation for a basis-power-unit **/
-            static constexpr bpu_abbrev_type
+            constexpr bpu_abbrev_type
             bpu_abbrev(dim native_dim,
                        const scalefactor_ratio_type & scalefactor,
                        const power_ratio_type & power)
@@ -6,6 +6,7 @@
 #include "basis_unit.hpp"
 #include "xo/ratio/ratio.hpp"
 #include <array>
+#include <string_view>
 #include <cstdint>
 
 namespace xo {
@@ -182,6 +183,24 @@ namespace xo {
 
                     this->bu_establish_abbrev(detail::bu::currency,         bu_abbrev_type::from_chars("ccy"));
                     this->bu_establish_abbrev(detail::bu::price,            bu_abbrev_type::from_chars("px"));
+
+                    // ----- information -----
+
+                    this->bu_establish_abbrev(detail::bu::bit,              bu_abbrev_type::from_chars("bit"));
+                    this->bu_establish_abbrev(detail::bu::byte,             bu_abbrev_type::from_chars("B"));
+                    this->bu_establish_abbrev(detail::bu::kilobyte,         bu_abbrev_type::from_chars("kB"));
+                    this->bu_establish_abbrev(detail::bu::kibibyte,         bu_abbrev_type::from_chars("KiB"));
+                    this->bu_establish_abbrev(detail::bu::megabyte,         bu_abbrev_type::from_chars("MB"));
+                    this->bu_establish_abbrev(detail::bu::mebibyte,         bu_abbrev_type::from_chars("MiB"));
+                    this->bu_establish_abbrev(detail::bu::gigabyte,         bu_abbrev_type::from_chars("GB"));
+                    this->bu_establish_abbrev(detail::bu::gibibyte,         bu_abbrev_type::from_chars("GiB"));
+                    this->bu_establish_abbrev(detail::bu::terabyte,         bu_abbrev_type::from_chars("TB"));
+                    this->bu_establish_abbrev(detail::bu::tebibyte,         bu_abbrev_type::from_chars("TiB"));
+
+                    // ----- packet, message -----
+
+                    this->bu_establish_abbrev(detail::bu::packet,           bu_abbrev_type::from_chars("pkt"));
+                    this->bu_establish_abbrev(detail::bu::message,          bu_abbrev_type::from_chars("msg"));
                 }
                 ///@}
 
@@ -230,6 +249,30 @@ namespace xo {
                             return bu_fallback_abbrev(bu.native_dim(), bu.scalefactor());
                         }
                     }
+
+                /** @brief find basis unit with abbreviation @p abbrev.
+                 *
+                 *  Inverse of @ref bu_abbrev,  for established abbreviations only.
+                 *  @return true and set @p *p_bu if found;  false otherwise
+                 **/
+                constexpr bool bu_from_abbrev(std::string_view abbrev, basis_unit * p_bu) const
+                    {
+                        for (std::size_t d = 0; d < n_dim; ++d) {
+                            const auto & bu_abbrev_v = bu_abbrev_vv_[d];
+
+                            for (std::size_t i = 0, n = bu_abbrev_v.size(); i < n; ++i) {
+                                if (std::string_view(bu_abbrev_v[i].second.c_str()) == abbrev) {
+                                    const auto & sf = bu_abbrev_v[i].first;
+
+                                    *p_bu = basis_unit(static_cast<dimension>(d),
+                                                       scalefactor_ratio_type(sf.num(), sf.den()));
+                                    return true;
+                                }
+                            }
+                        }
+
+                        return false;
+                    }
                 ///@}
 
                 /** @addtogroup bu-store-implementation-methods **/
@@ -265,7 +308,7 @@ namespace xo {
          *  Extending the contents of this store at runtime is not supported,
          *  in favor of preserving constexpr abbreviations.
          **/
-        static constexpr detail::bu_store bu_abbrev_store;
+        inline constexpr detail::bu_store bu_abbrev_store;
 
         /** @brief get abbreviation for basis-unit @p bu **/
         constexpr bu_abbrev_type
@@ -273,6 +316,15 @@ namespace xo {
         {
             return bu_abbrev_store.bu_abbrev(bu);
         }
+
+        /** @brief get basis-unit with abbreviation @p abbrev (e.g. @c "ms").
+         *  @return true and set @p *p_bu if found
+         **/
+        constexpr bool
+        bu_from_abbrev(std::string_view abbrev, basis_unit * p_bu)
+        {
+            return bu_abbrev_store.bu_from_abbrev(abbrev, p_bu);
+        }
     } /*namespace qty*/
 } /*namespace xo*/
 
@@ -0,0 +1,296 @@
+/** @file ccy_quantity.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "currency.hpp"
+#include "quantity.hpp"
+#include <compare>
+#include <type_traits>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            /** exponent of @c dim::currency in compile-time-unit quantity type @p Quantity **/
+            template <typename Quantity>
+            inline constexpr power_ratio_type ccy_power_v
+            = Quantity::s_scaled_unit.lookup_dim(dim::currency).power();
+        }
+
+        /** @class ccy_quantity
+         *  @brief amount in actual currency @p Ccy,  e.g. US dollars.
+         *
+         *  All currency amounts share @c dimension::currency,
+         *  so a plain @c quantity<u::currency> can't tell dollars from euros.
+         *  @c ccy_quantity carries the actual currency in its type:
+         *  - amounts in the same currency add, subtract and compare;
+         *  - amounts in different currencies don't:  @c (usd + eur) does not compile;
+         *  - multiplying or dividing by a number,  or by a quantity without currency,
+         *    keeps the currency,  e.g. @c (usd/share * share) is in usd;
+         *  - when currency cancels (@c usd / @c usd),  the result is a plain quantity.
+         *
+         *  The currency never changes without an exchange rate;
+         *  see @ref fx_matrix::convert.
+         *
+         *  Same size and layout as @p Quantity.
+         *
+         *  @code
+         *  using usd_t = ccy_quantity<ccy::usd, quantity<u::currency>>;
+         *  using eur_t = ccy_quantity<ccy::eur, quantity<u::currency>>;
+         *
+         *  usd_t x(qty::currency(10.0));
+         *  eur_t y(qty::currency(10.0));
+         *
+         *  auto z = x + x;   // usd_t
+         *  auto w = x + y;   // does not compile
+         *  @endcode
+         **/
+        template <currency_code Ccy, typename Quantity>
+        requires (quantity_concept<Quantity>
+                  && Quantity::always_constexpr_unit
+                  && !detail::ccy_power_v<Quantity>.is_zero())
+        class ccy_quantity {
+        public:
+            /** @defgroup ccy-quantity-type-traits ccy_quantity type traits **/
+            ///@{
+            /** quantity type for amount in currency @p Ccy **/
+            using quantity_type = Quantity;
+            /** representation for amount **/
+            using repr_type = typename Quantity::repr_type;
+
+            /** actual currency **/
+            static constexpr currency_code s_ccy = Ccy;
+            ///@}
+
+        public:
+            /** @defgroup ccy-quantity-ctors ccy_quantity constructors **/
+            ///@{
+
+            /** zero amount **/
+            constexpr ccy_quantity() = default;
+            /** amount @p x,  understood to be in currency @p Ccy **/
+            explicit constexpr ccy_quantity(const Quantity & x) : amount_{x} {}
+            /** same currency,  any unit of the same dimension (e.g. cents -> dollars) **/
+            template <typename Q2>
+            constexpr ccy_quantity(const ccy_quantity<Ccy, Q2> & x) : amount_{x.amount()} {}
+
+            ///@}
+
+            /** @defgroup ccy-quantity-access-methods ccy_quantity access methods **/
+            ///@{
+
+            /** actual currency **/
+            static constexpr currency_code currency() { return Ccy; }
+
+            /** amount,  without currency **/
+            constexpr const Quantity & amount() const { return amount_; }
+            /** amount in units of @c Quantity::s_scaled_unit **/
+            constexpr const repr_type & scale() const { return amount_.scale(); }
+
+            ///@}
+
+            /** @defgroup ccy-quantity-operators ccy_quantity operators **/
+            ///@{
+
+            ccy_quantity operator-() const { return ccy_quantity(-amount_); }
+
+            template <typename Q2>
+            ccy_quantity & operator+=(const ccy_quantity<Ccy, Q2> & y) {
+                amount_ += y.amount();
+                return *this;
+            }
+
+            template <typename Q2>
+            ccy_quantity & operator-=(const ccy_quantity<Ccy, Q2> & y) {
+                amount_ -= y.amount();
+                return *this;
+            }
+
+            template <typename Dimensionless>
+            requires std::is_arithmetic_v<Dimensionless>
+            ccy_quantity & operator*=(Dimensionless y) {
+                amount_ *= y;
+                return *this;
+            }
+
+            template <typename Dimensionless>
+            requires std::is_arithmetic_v<Dimensionless>
+            ccy_quantity & operator/=(Dimensionless y) {
+                amount_ /= y;
+                return *this;
+            }
+
+            ///@}
+
+        private:
+            /** @defgroup ccy-quantity-instance-vars ccy_quantity instance variables **/
+            ///@{
+
+            /** amount in currency @p Ccy **/
+            Quantity amount_;
+
+            ///@}
+        }; /*ccy_quantity*/
+
+        /** @defgroup ccy-quantity-traits ccy_quantity traits **/
+        ///@{
+
+        template <typename T>
+        struct is_ccy_quantity : std::false_type {};
+
+        template <currency_code Ccy, typename Quantity>
+        struct is_ccy_quantity<ccy_quantity<Ccy, Quantity>> : std::true_type {};
+
+        template <typename T>
+        inline constexpr bool is_ccy_quantity_v = is_ccy_quantity<T>::value;
+
+        ///@}
+
+        namespace detail {
+            /** quantity @p x,  tagged with currency @p Ccy unless currency cancelled out **/
+            template <currency_code Ccy, typename Quantity>
+            constexpr auto
+            with_ccy(const Quantity & x)
+            {
+                if constexpr (ccy_power_v<Quantity>.is_zero())
+                    return x;
+                else
+                    return ccy_quantity<Ccy, Quantity>(x);
+            }
+
+            /** true for a compile-time-unit quantity that does not involve currency **/
+            template <typename Quantity>
+            concept ccy_free_quantity = (quantity_concept<Quantity>
+                                         && Quantity::always_constexpr_unit
+                                         && ccy_power_v<Quantity>.is_zero());
+        }
+
+        /** @defgroup ccy-quantity-arithmetic ccy_quantity arithmetic **/
+        ///@{
+
+        /** add amounts @p x, @p y in the same currency.  Result has the same unit as @p x **/
+        template <currency_code Ccy, typename Q1, typename Q2>
+        constexpr auto
+        operator+ (const ccy_quantity<Ccy, Q1> & x, const ccy_quantity<Ccy, Q2> & y)
+        {
+            return detail::with_ccy<Ccy>(x.amount() + y.amount());
+        }
+
+        /** subtract amount @p y from @p x,  in the same currency.  Result has the same unit as @p x **/
+        template <currency_code Ccy, typename Q1, typename Q2>
+        constexpr auto
+        operator- (const ccy_quantity<Ccy, Q1> & x, const ccy_quantity<Ccy, Q2> & y)
+        {
+            return detail::with_ccy<Ccy>(x.amount() - y.amount());
+        }
+
+        /** product of two amounts in the same currency,  e.g. usd^2 **/
+        template <currency_code Ccy, typename Q1, typename Q2>
+        constexpr auto
+        operator* (const ccy_quantity<Ccy, Q1> & x, const ccy_quantity<Ccy, Q2> & y)
+        {
+            return detail::with_ccy<Ccy>(x.amount() * y.amount());
+        }
+
+        /** amount @p x times currency-free quantity @p y **/
+        template <currency_code Ccy, typename Q1, typename Q2>
+        requires detail::ccy_free_quantity<Q2>
+        constexpr auto
+        operator* (const ccy_quantity<Ccy, Q1> & x, const Q2 & y)
+        {
+            return detail::with_ccy<Ccy>(x.amount() * y);
+        }
+
+        /** currency-free quantity @p x times amount @p y **/
+        template <typename Q1, currency_code Ccy, typename Q2>
+        requires detail::ccy_free_quantity<Q1>
+        constexpr auto
+        operator* (const Q1 & x, const ccy_quantity<Ccy, Q2> & y)
+        {
+            return detail::with_ccy<Ccy>(x * y.amount());
+        }
+
+        template <currency_code Ccy, typename Q1, typename Dimensionless>
+        requires std::is_arithmetic_v<Dimensionless>
+        constexpr auto
+        operator* (const ccy_quantity<Ccy, Q1> & x, Dimensionless y)
+        {
+            return detail::with_ccy<Ccy>(x.amount() * y);
+        }
+
+        template <typename Dimensionless, currency_code Ccy, typename Q2>
+        requires std::is_arithmetic_v<Dimensionless>
+        constexpr auto
+        operator* (Dimensionless x, const ccy_quantity<Ccy, Q2> & y)
+        {
+            return detail::with_ccy<Ccy>(x * y.amount());
+        }
+
+        /** ratio of two amounts in the same currency;  plain quantity if currency cancels **/
+        template <currency_code Ccy, typename Q1, typename Q2>
+        constexpr auto
+        operator/ (const ccy_quantity<Ccy, Q1> & x, const ccy_quantity<Ccy, Q2> & y)
+        {
+            return detail::with_ccy<Ccy>(x.amount() / y.amount());
+        }
+
+        /** amount @p x divided by currency-free quantity @p y,  e.g. usd/share **/
+        template <currency_code Ccy, typename Q1, typename Q2>
+        requires detail::ccy_free_quantity<Q2>
+        constexpr auto
+        operator/ (const ccy_quantity<Ccy, Q1> & x, const Q2 & y)
+        {
+            return detail::with_ccy<Ccy>(x.amount() / y);
+        }
+
+        /** currency-free quantity @p x divided by amount @p y,  e.g. share/usd **/
+        template <typename Q1, currency_code Ccy, typename Q2>
+        requires detail::ccy_free_quantity<Q1>
+        constexpr auto
+        operator/ (const Q1 & x, const ccy_quantity<Ccy, Q2> & y)
+        {
+            return detail::with_ccy<Ccy>(x / y.amount());
+        }
+
+        template <currency_code Ccy, typename Q1, typename Dimensionless>
+        requires std::is_arithmetic_v<Dimensionless>
+        constexpr auto
+        operator/ (const ccy_quantity<Ccy, Q1> & x, Dimensionless y)
+        {
+            return detail::with_ccy<Ccy>(x.amount() / y);
+        }
+
+        template <typename Dimensionless, currency_code Ccy, typename Q2>
+        requires std::is_arithmetic_v<Dimensionless>
+        constexpr auto
+        operator/ (Dimensionless x, const ccy_quantity<Ccy, Q2> & y)
+        {
+            return detail::with_ccy<Ccy>(x / y.amount());
+        }
+
+        ///@}
+
+        /** @defgroup ccy-quantity-comparison ccy_quantity comparison **/
+        ///@{
+
+        template <currency_code Ccy, typename Q1, typename Q2>
+        constexpr bool
+        operator== (const ccy_quantity<Ccy, Q1> & x, const ccy_quantity<Ccy, Q2> & y)
+        {
+            return x.amount() == y.amount();
+        }
+
+        template <currency_code Ccy, typename Q1, typename Q2>
+        constexpr auto
+        operator<=> (const ccy_quantity<Ccy, Q1> & x, const ccy_quantity<Ccy, Q2> & y)
+        {
+            return x.amount() <=> y.amount();
+        }
+
+        ///@}
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end ccy_quantity.hpp **/
@@ -0,0 +1,421 @@
+/** @file column_codec.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "unit_wire.hpp"
+#include <array>
+#include <bit>
+#include <cstring>
+
+namespace xo {
+    namespace qty {
+        /** @enum int_codec
+         *  @brief compression scheme for a block of integer-represented quantities.
+         *
+         *  Both schemes store successive differences (delta),
+         *  mapped to unsigned with zigzag encoding,  so small negative
+         *  differences stay small.
+         **/
+        enum class int_codec : std::uint8_t {
+            /** not a codec **/
+            invalid,
+            /** LEB128 varint per delta;  good for irregular deltas **/
+            varint,
+            /** fixed bit width per block,  4 interleaved lanes;  decode is vectorized **/
+            bitpack,
+        };
+
+        namespace detail {
+            namespace codec {
+                /** block layout:
+                 *  @code
+                 *  unit (see detail::wire::put_unit)
+                 *  codec:u8 n:u32 first:i64
+                 *  [bitpack only: width:u8]
+                 *  payload
+                 *  @endcode
+                 *
+                 *  Varint payload: deltas x[i] - x[i-1] for i in [1,n).
+                 *
+                 *  Bitpack payload splits the block into @ref c_lane lanes;
+                 *  value i goes to lane i % c_lane,  row i / c_lane.
+                 *  Each lane stores its own deltas x[i] - x[i-c_lane]
+                 *  (@c first for the first row) in @c width bits per row,
+                 *  so row r begins at bit r*width of its lane.
+                 *  Lanes are interleaved one 64-bit word at a time:
+                 *  word t of lane k is at word index t*c_lane + k.
+                 *  A short last row is padded with zero deltas.
+                 *
+                 *  With this layout every lane in a row uses the same shift,
+                 *  and the prefix sum runs independently in each lane,
+                 *  so one row decodes as a single 4-wide SIMD step.
+                 **/
+                constexpr std::size_t c_fixed_bytes = 1 + 4 + 8;
+                /** number of interleaved lanes in bitpack payload **/
+                constexpr std::size_t c_lane = 4;
+
+                /** number of 64-bit words per lane,  for @p n values at @p w bits each **/
+                constexpr std::size_t lane_words(std::size_t n, unsigned w) {
+                    return (((n + c_lane - 1) / c_lane) * w + 63) / 64;
+                }
+
+                constexpr std::uint64_t zigzag(std::int64_t x) {
+                    return (static_cast<std::uint64_t>(x) << 1) ^ static_cast<std::uint64_t>(x >> 63);
+                }
+
+                constexpr std::int64_t unzigzag(std::uint64_t u) {
+                    return static_cast<std::int64_t>((u >> 1) ^ (~(u & 1) + 1));
+                }
+
+                /** zigzag-encoded difference x - prev,  computed without signed overflow **/
+                constexpr std::uint64_t zz_delta(std::int64_t x, std::int64_t prev) {
+                    return zigzag(static_cast<std::int64_t>(static_cast<std::uint64_t>(x)
+                                                            - static_cast<std::uint64_t>(prev)));
+                }
+
+                inline std::uint64_t load_u64(const std::byte * p) {
+                    std::uint64_t u;
+                    std::memcpy(&u, p, 8);
+                    if constexpr (std::endian::native == std::endian::big)
+                        u = __builtin_bswap64(u);
+                    return u;
+                }
+
+                inline void store_u64(std::byte * p, std::uint64_t u) {
+                    if constexpr (std::endian::native == std::endian::big)
+                        u = __builtin_bswap64(u);
+                    std::memcpy(p, &u, 8);
+                }
+            } /*namespace codec*/
+        } /*namespace detail*/
+
+        /** @brief upper bound on encoded size of a block of @p n values **/
+        constexpr std::size_t
+        encoded_block_bound(std::size_t n)
+        {
+            return (detail::wire::unit_bytes(natural_unit<std::int64_t>())
+                    + n_dim * detail::wire::c_bpu_bytes
+                    + detail::codec::c_fixed_bytes
+                    + 1
+                    + 10 * n
+                    + detail::codec::c_lane * 8);
+        }
+
+        /** encode block of integer values @p v,  expressed in unit @p nu,
+         *  into @p out using scheme @p codec.
+         *
+         *  @return number of bytes written,  or 0 if @p out too small.
+         **/
+        template <typename Int>
+        requires (std::is_integral_v<Int> && std::is_signed_v<Int>)
+        std::size_t
+        encode_block(int_codec codec,
+                     const natural_unit<std::int64_t> & nu,
+                     std::span<const Int> v,
+                     std::span<std::byte> out)
+        {
+            namespace cc = detail::codec;
+
+            std::size_t n = v.size();
+            std::size_t hz = detail::wire::unit_bytes(nu) + cc::c_fixed_bytes;
+
+            if (out.size() < hz)
+                return 0;
+
+            std::byte * p = detail::wire::put_unit(out.data(), nu);
+
+            *p++ = static_cast<std::byte>(codec);
+            detail::wire::put_le(p, static_cast<std::uint32_t>(n)); p += 4;
+            detail::wire::put_le(p, static_cast<std::int64_t>((n > 0) ? v[0] : 0)); p += 8;
+
+            std::byte * end = out.data() + out.size();
+
+            if (codec == int_codec::varint) {
+                for (std::size_t i = 1; i < n; ++i) {
+                    std::uint64_t u = cc::zz_delta(v[i], v[i-1]);
+
+                    if (end - p < 10)
+                        return 0;
+
+                    while (u >= 0x80) {
+                        *p++ = static_cast<std::byte>((u & 0x7f) | 0x80);
+                        u >>= 7;
+                    }
+                    *p++ = static_cast<std::byte>(u);
+                }
+            } else if (codec == int_codec::bitpack) {
+                constexpr std::size_t L = cc::c_lane;
+
+                /* delta from same lane in previous row */
+                auto lane_delta = [v](std::size_t i) {
+                    return cc::zz_delta(v[i], (i < L) ? v[0] : v[i - L]);
+                };
+
+                std::uint64_t all = 0;
+                for (std::size_t i = 1; i < n; ++i)
+                    all |= lane_delta(i);
+
+                unsigned w = 64 - std::countl_zero(all);
+                std::size_t pz = cc::lane_words(n, w) * L * 8;
+
+                if (static_cast<std::size_t>(end - p) < 1 + pz)
+                    return 0;
+
+                *p++ = static_cast<std::byte>(w);
+
+                std::memset(p, 0, pz);
+
+                if (w > 0) {
+                    for (std::size_t i = 1; i < n; ++i) {
+                        std::uint64_t u = lane_delta(i);
+                        std::size_t bit = (i / L) * w;
+                        unsigned s = bit & 63;
+                        std::byte * q = p + ((bit >> 6) * L + (i % L)) * 8;
+
+                        cc::store_u64(q, cc::load_u64(q) | (u << s));
+
+                        /* bits that didn't fit: next word in same lane */
+                        if (s + w > 64)
+                            cc::store_u64(q + L * 8, cc::load_u64(q + L * 8) | (u >> (64 - s)));
+                    }
+                }
+
+                p += pz;
+            } else {
+                return 0;
+            }
+
+            return p - out.data();
+        }
+
+        /** encode block of quantities @p v,  recording unit once **/
+        template <typename Quantity>
+        requires (quantity_concept<Quantity>
+                  && Quantity::always_constexpr_unit
+                  && std::is_integral_v<typename Quantity::repr_type>)
+        std::size_t
+        encode_block(int_codec codec,
+                     std::span<const Quantity> v,
+                     std::span<std::byte> out)
+        {
+            using repr_type = typename Quantity::repr_type;
+
+            static_assert(sizeof(Quantity) == sizeof(repr_type));
+
+            return encode_block(codec,
+                                Quantity::s_scaled_unit.natural_unit_.template to_repr<std::int64_t>(),
+                                std::span<const repr_type>(reinterpret_cast<const repr_type *>(v.data()), v.size()),
+                                out);
+        }
+
+        /** @class block_info
+         *  @brief header of an encoded block
+         **/
+        struct block_info {
+            /** unit for every value in block **/
+            natural_unit<std::int64_t> unit_;
+            /** compression scheme **/
+            int_codec codec_ = int_codec::invalid;
+            /** number of values **/
+            std::uint32_t n_ = 0;
+        };
+
+        /** read header of encoded block @p in into @p *p_info.
+         *  @return header size,  or 0 if malformed
+         **/
+        inline std::size_t
+        decode_block_info(std::span<const std::byte> in, block_info * p_info)
+        {
+            std::size_t uz = detail::wire::get_unit(in, &p_info->unit_);
+
+            if ((uz == 0) || (in.size() < uz + detail::codec::c_fixed_bytes))
+                return 0;
+
+            p_info->codec_ = static_cast<int_codec>(in[uz]);
+            p_info->n_ = detail::wire::get_le<std::uint32_t>(&in[uz + 1]);
+
+            return uz + 1 + 4;
+        }
+
+        /** decode block @p in into @p out.  Writes unit to @p *p_unit,  if non-null.
+         *
+         *  Bitpack decode handles one row (@ref detail::codec::c_lane values) per step:
+         *  per lane,  one 64-bit load (two when a row straddles a word),
+         *  shift by the row's common offset,  mask,  unzigzag,  add to lane sum.
+         *  The lane loops have no cross-lane dependency;  gcc -O3 emits them as
+         *  4 x 64-bit vector ops (AVX2 vpsrlvq/vpaddq;  2 x SSE2 without -mavx2).
+         *
+         *  @return number of bytes consumed,  or 0 if malformed
+         *          or @p out smaller than block
+         **/
+        template <typename Int>
+        requires (std::is_integral_v<Int> && std::is_signed_v<Int>)
+        std::size_t
+        decode_block(std::span<const std::byte> in,
+                     std::span<Int> out,
+                     natural_unit<std::int64_t> * p_unit = nullptr)
+        {
+            namespace cc = detail::codec;
+
+            block_info info;
+            std::size_t hz = decode_block_info(in, &info);
+
+            if ((hz == 0) || (out.size() < info.n_))
+                return 0;
+
+            if (p_unit)
+                *p_unit = info.unit_;
+
+            const std::byte * p = in.data() + hz;
+            const std::byte * end = in.data() + in.size();
+            std::size_t n = info.n_;
+
+            std::int64_t x = detail::wire::get_le<std::int64_t>(p);
+            p += 8;
+
+            if (n == 0) {
+                if (info.codec_ == int_codec::bitpack) {
+                    /* width byte only */
+                    if (p == end)
+                        return 0;
+                    ++p;
+                }
+
+                return p - in.data();
+            }
+
+            out[0] = static_cast<Int>(x);
+
+            if (info.codec_ == int_codec::varint) {
+                for (std::size_t i = 1; i < n; ++i) {
+                    std::uint64_t u = 0;
+                    unsigned s = 0;
+
+                    for (;;) {
+                        if ((p == end) || (s > 63))
+                            return 0;
+
+                        std::uint64_t b = static_cast<std::uint64_t>(*p++);
+
+                        u |= (b & 0x7f) << s;
+                        s += 7;
+
+                        if (b < 0x80)
+                            break;
+                    }
+
+                    x = static_cast<std::int64_t>(static_cast<std::uint64_t>(x)
+                                                  + static_cast<std::uint64_t>(cc::unzigzag(u)));
+                    out[i] = static_cast<Int>(x);
+                }
+            } else if (info.codec_ == int_codec::bitpack) {
+                if (p == end)
+                    return 0;
+
+                unsigned w = static_cast<unsigned>(*p++);
+
+                if (w > 64)
+                    return 0;
+
+                constexpr std::size_t L = cc::c_lane;
+
+                std::size_t pz = cc::lane_words(n, w) * L * 8;
+
+                if (static_cast<std::size_t>(end - p) < pz)
+                    return 0;
+
+                if (w == 0) {
+                    /* all deltas zero;  payload empty */
+                    for (std::size_t i = 1; i < n; ++i)
+                        out[i] = static_cast<Int>(x);
+
+                    return p - in.data();
+                }
+
+                std::uint64_t mask = (w == 64) ? ~0ull : ((1ull << w) - 1);
+
+                /* running sum for each lane */
+                std::array<std::uint64_t, L> acc;
+                acc.fill(static_cast<std::uint64_t>(x));
+
+                /* deltas for one row,  lanes [0,L) */
+                auto unpack_row = [p, w, mask](std::size_t r, std::array<std::uint64_t, L> & u) {
+                    std::size_t bit = r * w;
+                    unsigned s = bit & 63;
+                    const std::byte * q = p + (bit >> 6) * L * 8;
+
+                    if (s + w <= 64) {
+                        for (std::size_t k = 0; k < L; ++k)
+                            u[k] = cc::load_u64(q + 8 * k) >> s;
+                    } else {
+                        for (std::size_t k = 0; k < L; ++k)
+                            u[k] = ((cc::load_u64(q + 8 * k) >> s)
+                                    | (cc::load_u64(q + 8 * (L + k)) << (64 - s)));
+                    }
+
+                    for (std::size_t k = 0; k < L; ++k)
+                        u[k] = static_cast<std::uint64_t>(cc::unzigzag(u[k] & mask));
+                };
+
+                std::size_t n_full = n / L;
+                std::array<std::uint64_t, L> u;
+
+                for (std::size_t r = 0; r < n_full; ++r) {
+                    unpack_row(r, u);
+
+                    for (std::size_t k = 0; k < L; ++k) {
+                        acc[k] += u[k];
+                        out[r * L + k] = static_cast<Int>(acc[k]);
+                    }
+                }
+
+                /* short last row */
+                if (n_full * L < n) {
+                    unpack_row(n_full, u);
+
+                    for (std::size_t i = n_full * L; i < n; ++i)
+                        out[i] = static_cast<Int>(acc[i % L] + u[i % L]);
+                }
+
+                p += pz;
+            } else {
+                return 0;
+            }
+
+            return p - in.data();
+        }
+
+        /** decode block @p in directly into quantity column @p out.
+         *  @return number of bytes consumed,
+         *          or 0 if malformed,  @p out too small,
+         *          or block unit differs from @c Quantity unit
+         **/
+        template <typename Quantity>
+        requires (quantity_concept<Quantity>
+                  && Quantity::always_constexpr_unit
+                  && std::is_integral_v<typename Quantity::repr_type>)
+        std::size_t
+        decode_block(std::span<const std::byte> in,
+                     std::span<Quantity> out)
+        {
+            using repr_type = typename Quantity::repr_type;
+
+            static_assert(sizeof(Quantity) == sizeof(repr_type));
+
+            constexpr auto c_nu = Quantity::s_scaled_unit.natural_unit_.template to_repr<std::int64_t>();
+
+            block_info info;
+
+            if ((decode_block_info(in, &info) == 0) || (info.unit_ != c_nu))
+                return 0;
+
+            return decode_block(in,
+                                std::span<repr_type>(reinterpret_cast<repr_type *>(out.data()), out.size()));
+        }
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end column_codec.hpp **/
@@ -0,0 +1,555 @@
+/** @file column_file.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "unit_wire.hpp"
+#include "int_rescale.hpp"
+#include <vector>
+#include <string_view>
+#include <cstdio>
+#include <cstring>
+#include <cmath>
+#include <type_traits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            namespace colfile {
+                /** file layout:
+                 *  @code
+                 *  [header: c_header_bytes]
+                 *  [column directory: n_col * c_entry_bytes]
+                 *  [column 0 values] [column 1 values] ...
+                 *  @endcode
+                 *  Column values are contiguous,  in host byte order,  each column
+                 *  starting on a @ref c_align boundary,  so a mapped column can be used in-place.
+                 *
+                 *  header:
+                 *  @code
+                 *  magic[8] byte_order:u32 n_col:u32 n_row:u64 (zero-padded)
+                 *  @endcode
+                 *  directory entry:
+                 *  @code
+                 *  name[48] repr:u8 pad[7] offset:u64 unit (see detail::wire::put_unit) (zero-padded)
+                 *  @endcode
+                 **/
+                /** last byte is format version;  v2 widened directory entries for packet/message dimensions **/
+                constexpr char c_magic[8] = { 'x', 'o', 'q', 'c', 'o', 'l', 0, 2 };
+                /** written in host order;  reader rejects files from a different byte order **/
+                constexpr std::uint32_t c_byte_order = 0x01020304;
+                constexpr std::size_t c_header_bytes = 64;
+                constexpr std::size_t c_name_bytes = 48;
+                constexpr std::size_t c_entry_bytes = 256;
+                constexpr std::size_t c_align = 64;
+
+                static_assert(c_name_bytes + 16 + 1 + n_dim * wire::c_bpu_bytes <= c_entry_bytes);
+
+                /** code identifying column representation **/
+                enum class repr_code : std::uint8_t {
+                    invalid,
+                    f64,
+                    f32,
+                    i64,
+                    i32,
+                };
+
+                template <typename Repr>
+                constexpr repr_code repr2code() {
+                    if constexpr (std::is_same_v<Repr, double>)
+                        return repr_code::f64;
+                    else if constexpr (std::is_same_v<Repr, float>)
+                        return repr_code::f32;
+                    else if constexpr (std::is_same_v<Repr, std::int64_t>)
+                        return repr_code::i64;
+                    else if constexpr (std::is_same_v<Repr, std::int32_t>)
+                        return repr_code::i32;
+                    else
+                        return repr_code::invalid;
+                }
+
+                constexpr std::size_t repr_bytes(repr_code x) {
+                    switch (x) {
+                    case repr_code::f64: return 8;
+                    case repr_code::f32: return 4;
+                    case repr_code::i64: return 8;
+                    case repr_code::i32: return 4;
+                    default: break;
+                    }
+                    return 0;
+                }
+
+                constexpr std::size_t align_up(std::size_t x) {
+                    return (x + c_align - 1) & ~(c_align - 1);
+                }
+            } /*namespace colfile*/
+        } /*namespace detail*/
+
+        /** @class column_view
+         *  @brief zero-copy view of a mapped column,  presented as quantities
+         *  with compile-time unit @p ScaledUnit.
+         *
+         *  If the column was stored in a different unit,  elements are multiplied
+         *  on access by a single conversion factor computed when the view was created.
+         *  Factor is held as double,  whatever the stored @p Repr.
+         *  Factor is NaN if stored unit has a different dimension.
+         *
+         *  For integer @p Repr,  converted values are rounded to nearest.
+         *  Integer and reciprocal-integer factors (e.g. ns -> us) are applied
+         *  in integer arithmetic,  so large values (e.g. epoch timestamps) stay exact.
+         **/
+        template <auto ScaledUnit, typename Repr = double>
+        class column_view {
+        public:
+            using quantity_type = quantity<ScaledUnit, Repr>;
+            using repr_type = Repr;
+
+        public:
+            column_view() = default;
+            column_view(const Repr * p, std::size_t n, double factor)
+                : p_{p}, n_{n}, factor_{factor}, rescale_{factor} {}
+
+            /** @defgroup column-view-access-methods column_view access methods **/
+            ///@{
+
+            /** number of elements **/
+            std::size_t size() const { return n_; }
+            bool empty() const { return n_ == 0; }
+            /** multiplier from stored values to @p ScaledUnit **/
+            double factor() const { return factor_; }
+            /** true if stored values are already in @p ScaledUnit **/
+            bool is_exact() const { return factor_ == 1.0; }
+            /** stored values,  in stored unit **/
+            std::span<const Repr> raw() const { return std::span<const Repr>(p_, n_); }
+
+            /** element @p i **/
+            quantity_type operator[](std::size_t i) const {
+                if constexpr (std::is_integral_v<Repr>) {
+                    return quantity_type(rescale_(p_[i]));
+                } else {
+                    return quantity_type(static_cast<Repr>(factor_ * p_[i]));
+                }
+            }
+
+            ///@}
+
+        private:
+            /** first stored value **/
+            const Repr * p_ = nullptr;
+            /** number of stored values **/
+            std::size_t n_ = 0;
+            /** conversion factor from stored unit **/
+            double factor_ = 1.0;
+            /** integer Repr only:  conversion in integer arithmetic when factor allows **/
+            detail::int_rescale<std::conditional_t<std::is_integral_v<Repr>, Repr, std::int64_t>> rescale_;
+        };
+
+        /** @class xcolumn_view
+         *  @brief zero-copy view of a mapped column,  presented as quantities
+         *  with the stored (runtime) unit.
+         **/
+        template <typename Repr = double>
+        class xcolumn_view {
+        public:
+            using quantity_type = xquantity<Repr, std::int64_t>;
+            using unit_type = natural_unit<std::int64_t>;
+            using repr_type = Repr;
+
+        public:
+            xcolumn_view() = default;
+            xcolumn_view(const Repr * p, std::size_t n, const unit_type & unit) : p_{p}, n_{n}, unit_{unit} {}
+
+            /** @defgroup xcolumn-view-access-methods xcolumn_view access methods **/
+            ///@{
+
+            /** number of elements **/
+            std::size_t size() const { return n_; }
+            bool empty() const { return n_ == 0; }
+            /** stored unit **/
+            const unit_type & unit() const { return unit_; }
+            /** stored values **/
+            std::span<const Repr> raw() const { return std::span<const Repr>(p_, n_); }
+
+            /** element @p i **/
+            quantity_type operator[](std::size_t i) const { return quantity_type(p_[i], unit_); }
+
+            ///@}
+
+        private:
+            /** first stored value **/
+            const Repr * p_ = nullptr;
+            /** number of stored values **/
+            std::size_t n_ = 0;
+            /** stored unit **/
+            unit_type unit_;
+        };
+
+        /** @class column_file_writer
+         *  @brief assemble and write a column file.
+         *
+         *  Column data is not copied;  it must remain valid until @ref write.
+         **/
+        class column_file_writer {
+        public:
+            using unit_type = natural_unit<std::int64_t>;
+
+        public:
+            /** writer for columns with @p n_row rows **/
+            explicit column_file_writer(std::size_t n_row) : n_row_{n_row} {}
+
+            /** @defgroup column-file-writer-general-methods column_file_writer general methods **/
+            ///@{
+
+            /** add column @p name with values @p v,  expressed in @p unit.
+             *  @return false if @p v.size() does not match row count,  or name too long
+             **/
+            template <typename Repr>
+            requires (detail::colfile::repr2code<Repr>() != detail::colfile::repr_code::invalid)
+            bool add_column(std::string_view name, const unit_type & unit, std::span<const Repr> v) {
+                if ((v.size() != n_row_) || (name.size() >= detail::colfile::c_name_bytes))
+                    return false;
+
+                col_v_.push_back(column_spec{name, unit,
+                                             detail::colfile::repr2code<Repr>(),
+                                             reinterpret_cast<const std::byte *>(v.data())});
+                return true;
+            }
+
+            /** add column @p name with quantities @p v **/
+            template <typename Quantity>
+            requires (quantity_concept<Quantity> && Quantity::always_constexpr_unit)
+            bool add_column(std::string_view name, std::span<const Quantity> v) {
+                using repr_type = typename Quantity::repr_type;
+
+                static_assert(sizeof(Quantity) == sizeof(repr_type));
+
+                return this->add_column(name,
+                                        Quantity::s_scaled_unit.natural_unit_.template to_repr<std::int64_t>(),
+                                        std::span<const repr_type>(reinterpret_cast<const repr_type *>(v.data()),
+                                                                   v.size()));
+            }
+
+            /** write file to @p path.  @return false on I/O error **/
+            bool write(const char * path) const {
+                namespace cf = detail::colfile;
+
+                std::FILE * fp = std::fopen(path, "wb");
+
+                if (!fp)
+                    return false;
+
+                std::size_t n_col = col_v_.size();
+                std::size_t offset = cf::align_up(cf::c_header_bytes + n_col * cf::c_entry_bytes);
+
+                std::vector<std::byte> head(offset, std::byte{0});
+
+                std::memcpy(&head[0], cf::c_magic, sizeof(cf::c_magic));
+                std::uint32_t byte_order = cf::c_byte_order;
+                std::memcpy(&head[8], &byte_order, 4);
+                std::uint32_t n_col32 = n_col;
+                std::memcpy(&head[12], &n_col32, 4);
+                std::uint64_t n_row64 = n_row_;
+                std::memcpy(&head[16], &n_row64, 8);
+
+                std::vector<std::uint64_t> offset_v(n_col);
+
+                for (std::size_t j = 0; j < n_col; ++j) {
+                    const column_spec & col = col_v_[j];
+                    std::byte * e = &head[cf::c_header_bytes + j * cf::c_entry_bytes];
+
+                    offset_v[j] = offset;
+
+                    std::memcpy(e, col.name_.data(), col.name_.size());
+                    e[cf::c_name_bytes] = static_cast<std::byte>(col.repr_);
+                    std::memcpy(e + cf::c_name_bytes + 8, &offset_v[j], 8);
+                    detail::wire::put_unit(e + cf::c_name_bytes + 16, col.unit_);
+
+                    offset = cf::align_up(offset + n_row_ * cf::repr_bytes(col.repr_));
+                }
+
+                bool ok = (std::fwrite(head.data(), 1, head.size(), fp) == head.size());
+
+                std::size_t pos = head.size();
+                const std::byte zero_v[cf::c_align] = {};
+
+                for (std::size_t j = 0; ok && (j < n_col); ++j) {
+                    const column_spec & col = col_v_[j];
+                    std::size_t z = n_row_ * cf::repr_bytes(col.repr_);
+
+                    ok = ((std::fwrite(zero_v, 1, offset_v[j] - pos, fp) == offset_v[j] - pos)
+                          && (std::fwrite(col.data_, 1, z, fp) == z));
+
+                    pos = offset_v[j] + z;
+                }
+
+                return (std::fclose(fp) == 0) && ok;
+            }
+
+            ///@}
+
+        private:
+            struct column_spec {
+                std::string_view name_;
+                unit_type unit_;
+                detail::colfile::repr_code repr_;
+                const std::byte * data_;
+            };
+
+        private:
+            /** number of rows in each column **/
+            std::size_t n_row_ = 0;
+            /** columns,  in file order **/
+            std::vector<column_spec> col_v_;
+        };
+
+        /** @class column_file
+         *  @brief read-only memory-mapped column file.
+         *
+         *  Opening validates header and directory only;
+         *  column data is paged in by the OS as views are accessed.
+         *  Views remain valid while the @c column_file is open.
+         **/
+        class column_file {
+        public:
+            using unit_type = natural_unit<std::int64_t>;
+
+        public:
+            column_file() = default;
+            column_file(const column_file &) = delete;
+            column_file & operator=(const column_file &) = delete;
+            ~column_file() { this->close(); }
+
+            /** @defgroup column-file-access-methods column_file access methods **/
+            ///@{
+
+            bool is_open() const { return base_ != nullptr; }
+            std::size_t n_col() const { return n_col_; }
+            std::size_t n_row() const { return n_row_; }
+
+            /** name of column @p j.  Empty if @p j out of range **/
+            std::string_view column_name(std::size_t j) const {
+                if (j >= n_col_)
+                    return std::string_view();
+
+                const char * s = reinterpret_cast<const char *>(this->entry(j));
+
+                return std::string_view(s, ::strnlen(s, detail::colfile::c_name_bytes));
+            }
+
+            /** stored unit for column @p j.  Dimensionless if @p j out of range **/
+            unit_type column_unit(std::size_t j) const {
+                unit_type nu;
+
+                if (j >= n_col_)
+                    return nu;
+
+                detail::wire::get_unit(std::span<const std::byte>(this->entry(j) + detail::colfile::c_name_bytes + 16,
+                                                                  detail::colfile::c_entry_bytes
+                                                                  - detail::colfile::c_name_bytes - 16),
+                                       &nu);
+                return nu;
+            }
+
+            /** index of column named @p name,  or @ref n_col if not present **/
+            std::size_t find_column(std::string_view name) const {
+                for (std::size_t j = 0; j < n_col_; ++j) {
+                    if (this->column_name(j) == name)
+                        return j;
+                }
+                return n_col_;
+            }
+
+            /** view column @p j as quantities in unit @p ScaledUnit.
+             *  Empty view if @p j out of range,  or stored repr is not @p Repr,
+             *  or (integer @p Repr) stored unit has a different dimension.
+             **/
+            template <auto ScaledUnit, typename Repr = double>
+            requires (ScaledUnit.is_natural())
+            column_view<ScaledUnit, Repr> column(std::size_t j) const {
+                const Repr * p = this->column_data<Repr>(j);
+
+                if (!p)
+                    return column_view<ScaledUnit, Repr>();
+
+                constexpr auto c_nu = ScaledUnit.natural_unit_.template to_repr<std::int64_t>();
+
+                unit_type nu = this->column_unit(j);
+
+                double factor = ((nu == c_nu)
+                                 ? 1.0
+                                 : xquantity<double, std::int64_t>(1.0, nu).rescale(c_nu).scale());
+
+                if constexpr (std::is_integral_v<Repr>) {
+                    /* no integer NaN */
+                    if (std::isnan(factor))
+                        return column_view<ScaledUnit, Repr>();
+                }
+
+                return column_view<ScaledUnit, Repr>(p, n_row_, factor);
+            }
+
+            /** view column named @p name as quantities in unit @p ScaledUnit **/
+            template <auto ScaledUnit, typename Repr = double>
+            requires (ScaledUnit.is_natural())
+            column_view<ScaledUnit, Repr> column(std::string_view name) const {
+                return this->column<ScaledUnit, Repr>(this->find_column(name));
+            }
+
+            /** view column @p j as quantities in stored unit.
+             *  Empty view if @p j out of range,  or stored repr is not @p Repr.
+             **/
+            template <typename Repr = double>
+            xcolumn_view<Repr> xcolumn(std::size_t j) const {
+                const Repr * p = this->column_data<Repr>(j);
+
+                if (!p)
+                    return xcolumn_view<Repr>();
+
+                return xcolumn_view<Repr>(p, n_row_, this->column_unit(j));
+            }
+
+            /** view column named @p name as quantities in stored unit **/
+            template <typename Repr = double>
+            xcolumn_view<Repr> xcolumn(std::string_view name) const {
+                return this->xcolumn<Repr>(this->find_column(name));
+            }
+
+            ///@}
+
+            /** @defgroup column-file-general-methods column_file general methods **/
+            ///@{
+
+            /** map file at @p path.  @return false if file cannot be mapped,  or is not a valid column file **/
+            bool open(const char * path) {
+                namespace cf = detail::colfile;
+
+                this->close();
+
+                int fd = ::open(path, O_RDONLY);
+
+                if (fd < 0)
+                    return false;
+
+                struct stat st;
+
+                if ((::fstat(fd, &st) != 0) || (static_cast<std::size_t>(st.st_size) < cf::c_header_bytes)) {
+                    ::close(fd);
+                    return false;
+                }
+
+                std::size_t z = st.st_size;
+                void * base = ::mmap(nullptr, z, PROT_READ, MAP_SHARED, fd, 0);
+
+                ::close(fd);
+
+                if (base == MAP_FAILED)
+                    return false;
+
+                base_ = static_cast<const std::byte *>(base);
+                z_ = z;
+
+                if (!this->validate()) {
+                    this->close();
+                    return false;
+                }
+
+                return true;
+            }
+
+            /** unmap file,  invalidating views **/
+            void close() {
+                if (base_)
+                    ::munmap(const_cast<std::byte *>(base_), z_);
+
+                base_ = nullptr;
+                z_ = 0;
+                n_col_ = 0;
+                n_row_ = 0;
+            }
+
+            ///@}
+
+        private:
+            const std::byte * entry(std::size_t j) const {
+                return base_ + detail::colfile::c_header_bytes + j * detail::colfile::c_entry_bytes;
+            }
+
+            detail::colfile::repr_code column_repr(std::size_t j) const {
+                return static_cast<detail::colfile::repr_code>(this->entry(j)[detail::colfile::c_name_bytes]);
+            }
+
+            std::uint64_t column_offset(std::size_t j) const {
+                std::uint64_t offset = 0;
+                std::memcpy(&offset, this->entry(j) + detail::colfile::c_name_bytes + 8, 8);
+                return offset;
+            }
+
+            template <typename Repr>
+            const Repr * column_data(std::size_t j) const {
+                if ((j >= n_col_) || (this->column_repr(j) != detail::colfile::repr2code<Repr>()))
+                    return nullptr;
+
+                return reinterpret_cast<const Repr *>(base_ + this->column_offset(j));
+            }
+
+            bool validate() {
+                namespace cf = detail::colfile;
+
+                std::uint32_t byte_order = 0;
+                std::uint32_t n_col = 0;
+                std::uint64_t n_row = 0;
+
+                std::memcpy(&byte_order, base_ + 8, 4);
+                std::memcpy(&n_col, base_ + 12, 4);
+                std::memcpy(&n_row, base_ + 16, 8);
+
+                if ((std::memcmp(base_, cf::c_magic, sizeof(cf::c_magic)) != 0)
+                    || (byte_order != cf::c_byte_order)
+                    || (cf::c_header_bytes + n_col * cf::c_entry_bytes > z_))
+                    return false;
+
+                n_col_ = n_col;
+                n_row_ = n_row;
+
+                for (std::size_t j = 0; j < n_col_; ++j) {
+                    std::size_t rz = cf::repr_bytes(this->column_repr(j));
+                    std::uint64_t offset = this->column_offset(j);
+
+                    /* n_row_ * rz may overflow for a corrupt header;  divide instead */
+                    if ((rz == 0)
+                        || (offset % cf::c_align != 0)
+                        || (offset > z_)
+                        || (n_row_ > (z_ - offset) / rz))
+                        return false;
+
+                    unit_type nu;
+
+                    if (detail::wire::get_unit(std::span<const std::byte>(this->entry(j) + cf::c_name_bytes + 16,
+                                                                          cf::c_entry_bytes - cf::c_name_bytes - 16),
+                                               &nu) == 0)
+                        return false;
+                }
+
+                return true;
+            }
+
+        private:
+            /** start of mapped file **/
+            const std::byte * base_ = nullptr;
+            /** size of mapped file **/
+            std::size_t z_ = 0;
+            /** number of columns **/
+            std::size_t n_col_ = 0;
+            /** number of rows in each column **/
+            std::size_t n_row_ = 0;
+        };
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end column_file.hpp **/
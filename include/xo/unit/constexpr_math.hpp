@@ -0,0 +1,261 @@
+/** @file constexpr_math.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            /** @defgroup constexpr-math constexpr math helpers **/
+            ///@{
+
+            /** largest integer @c r with @c r*r <= @p x.
+             *
+             *  Digit-by-digit method;  exact for the full range of @c unsigned __int128
+             **/
+            constexpr unsigned __int128
+            isqrt_u128(unsigned __int128 x)
+            {
+                unsigned __int128 r = 0;
+                unsigned __int128 bit = static_cast<unsigned __int128>(1) << 126;
+
+                while (bit > x)
+                    bit >>= 2;
+
+                while (bit != 0) {
+                    if (x >= r + bit) {
+                        x -= r + bit;
+                        r = (r >> 1) + bit;
+                    } else {
+                        r >>= 1;
+                    }
+                    bit >>= 2;
+                }
+
+                return r;
+            }
+
+            /** exact power of two 2^p,  for p in normal exponent range [-1022, 1023] **/
+            constexpr double
+            cx_pow2(int p)
+            {
+                return std::bit_cast<double>(static_cast<std::uint64_t>(p + 1023) << 52);
+            }
+
+            /** correctly-rounded square root of @p x,  usable in constant expressions.
+             *
+             *  Produces the same bits as IEEE-754 @c ::sqrt
+             *  (which is also required to be correctly rounded),
+             *  so a factor computed at compile time with @c cx_sqrt
+             *  is interchangeable with one computed at runtime with @c ::sqrt.
+             *
+             *  Until c++26,  @c ::sqrt is not constexpr.
+             **/
+            constexpr double
+            cx_sqrt(double x)
+            {
+                if (x != x)
+                    return x; /* NaN */
+                if (x < 0.0)
+                    return std::numeric_limits<double>::quiet_NaN();
+                if ((x == 0.0) || (x == std::numeric_limits<double>::infinity()))
+                    return x;
+
+                std::uint64_t bits = std::bit_cast<std::uint64_t>(x);
+                std::uint64_t exp_bits = (bits >> 52) & 0x7ff;
+                std::uint64_t frac_bits = bits & ((std::uint64_t(1) << 52) - 1);
+
+                /* x = m * 2^e,  with m integral in [2^52, 2^53) */
+                std::uint64_t m = 0;
+                int e = 0;
+
+                if (exp_bits == 0) {
+                    /* subnormal */
+                    m = frac_bits;
+                    e = -1074;
+
+                    while (m < (std::uint64_t(1) << 52)) {
+                        m <<= 1;
+                        --e;
+                    }
+                } else {
+                    m = frac_bits | (std::uint64_t(1) << 52);
+                    e = static_cast<int>(exp_bits) - 1075;
+                }
+
+                /* make exponent even;  now m in [2^52, 2^54) */
+                if (e % 2 != 0) {
+                    m <<= 1;
+                    --e;
+                }
+
+                /* sqrt(x) = sqrt(m * 2^52) * 2^((e-52)/2),
+                 * with sqrt(m * 2^52) in [2^52, 2^53)
+                 */
+                unsigned __int128 mm = static_cast<unsigned __int128>(m) << 52;
+                unsigned __int128 r = isqrt_u128(mm);
+                unsigned __int128 rem = mm - r * r;
+
+                /* round to nearest:
+                 *   sqrt(mm) >= r + 1/2  <=>  mm >= r^2 + r + 1/4  <=>  rem > r
+                 * (exact ties are impossible)
+                 */
+                if (rem > r)
+                    ++r;
+
+                return static_cast<double>(static_cast<std::uint64_t>(r)) * cx_pow2((e - 52) / 2);
+            }
+
+            /** @p x^p for integer @p p >= 0,  by repeated squaring **/
+            template <typename Float>
+            constexpr Float
+            cx_ipow(Float x, int p)
+            {
+                Float r = 1;
+
+                for (; p > 0; p >>= 1) {
+                    if (p & 1)
+                        r *= x;
+                    x *= x;
+                }
+
+                return r;
+            }
+
+            /** largest integer @c r with @c r^n <= @p x,  for @p n >= 1 **/
+            constexpr std::uint64_t
+            iroot_u64(std::uint64_t x, int n)
+            {
+                if ((n == 1) || (x < 2))
+                    return x;
+
+                /* true iff r^n <= x,  without overflow */
+                auto pow_le = [x, n](std::uint64_t r) {
+                    unsigned __int128 acc = 1;
+
+                    for (int i = 0; i < n; ++i) {
+                        acc *= r;
+                        if (acc > x)
+                            return false;
+                    }
+                    return true;
+                };
+
+                /* r^n <= x < 2^64  =>  r < 2^(64/n) + 1 */
+                std::uint64_t lo = 1;
+                std::uint64_t hi = (n >= 64) ? 2 : (std::uint64_t(1) << ((64 + n - 1) / n));
+
+                /* inv: lo^n <= x < hi^n */
+                while (hi - lo > 1) {
+                    std::uint64_t mid = lo + (hi - lo) / 2;
+
+                    if (pow_le(mid))
+                        lo = mid;
+                    else
+                        hi = mid;
+                }
+
+                return lo;
+            }
+
+            /** @p n'th root of @p x > 0,  usable in constant expressions.
+             *
+             *  Newton iteration in long double from an upper bound,
+             *  rounded once to double:  within 1ulp of the exact root.
+             **/
+            constexpr double
+            cx_root(double x, int n)
+            {
+                if (n == 1)
+                    return x;
+                if (n == 2)
+                    return cx_sqrt(x);
+                if (!(x > 0.0) || (x == std::numeric_limits<double>::infinity()))
+                    return (x == 0.0) ? 0.0 : std::numeric_limits<double>::quiet_NaN();
+
+                /* x = m * 2^e,  m in [1, 2);  start from 2^(ceil((e+1)/n)) >= x^(1/n) */
+                int e = static_cast<int>((std::bit_cast<std::uint64_t>(x) >> 52) & 0x7ff) - 1023;
+                int e1 = (e + 1 >= 0) ? (e + 1 + n - 1) / n : -((-(e + 1)) / n);
+
+                long double xl = x;
+                long double r = cx_pow2(e1);
+
+                /* Newton's method decreases monotonically toward the root from above */
+                for (int i = 0; i < 200; ++i) {
+                    long double r2 = ((n - 1) * r + xl / cx_ipow(r, n - 1)) / n;
+
+                    if (!(r2 < r))
+                        break;
+
+                    r = r2;
+                }
+
+                return static_cast<double>(r);
+            }
+
+            /** @class root_split_result
+             *  @brief positive integer power rewritten as exact part times @p n'th root;
+             *  see @ref root_split
+             **/
+            struct root_split_result {
+                /** exact factor;  fits since outer <= x^(k/n) < x **/
+                std::uint64_t outer_ = 1;
+                /** remaining radicand,  free of n'th powers of small primes **/
+                double inner_ = 1.0;
+            };
+
+            /** write @p x^(@p k / @p n) as @c outer * inner^(1/n) with @c outer integral,
+             *  for @p x >= 1 and 0 < @p k < @p n.
+             *
+             *  Perfect powers are extracted exactly:  trial division by
+             *  factors below @c c_bound,  then an exact root test on the cofactor.
+             *  Scalefactors in practice (1000, 3600, 86400, 1024, ..) factor completely.
+             **/
+            constexpr root_split_result
+            root_split(std::uint64_t x, int k, int n)
+            {
+                constexpr std::uint64_t c_bound = 4096;
+
+                root_split_result retval;
+
+                for (std::uint64_t d = 2; (d < c_bound) && (d * d <= x); ++d) {
+                    int e = 0;
+
+                    while (x % d == 0) {
+                        x /= d;
+                        ++e;
+                    }
+
+                    if (e > 0) {
+                        /* d^(e.k/n) = d^floor(e.k/n) * (d^((e.k) mod n))^(1/n) */
+                        retval.outer_ *= cx_ipow<std::uint64_t>(d, (e * k) / n);
+                        retval.inner_ *= cx_ipow<double>(static_cast<double>(d), (e * k) % n);
+                    }
+                }
+
+                if (x > 1) {
+                    std::uint64_t t = iroot_u64(x, n);
+
+                    if (cx_ipow<std::uint64_t>(t, n) == x) {
+                        /* (t^n)^(k/n) = t^k */
+                        retval.outer_ *= cx_ipow<std::uint64_t>(t, k);
+                    } else {
+                        retval.inner_ *= cx_ipow<double>(static_cast<double>(x), k);
+                    }
+                }
+
+                return retval;
+            }
+
+            ///@}
+        } /*namespace detail*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end constexpr_math.hpp **/
@@ -0,0 +1,610 @@
+/** @file csv_reader.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "quantity.hpp"
+#include "xquantity.hpp"
+#include "int_rescale.hpp"
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <string_view>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            namespace csv {
+                /** strip leading and trailing blanks from @p s **/
+                constexpr std::string_view trim(std::string_view s) {
+                    while (!s.empty() && ((s.front() == ' ') || (s.front() == '\t')))
+                        s.remove_prefix(1);
+                    while (!s.empty() && ((s.back() == ' ') || (s.back() == '\t') || (s.back() == '\r')))
+                        s.remove_suffix(1);
+                    return s;
+                }
+
+                /** line starting at @p p,  excluding terminating newline (and carriage return) **/
+                inline std::string_view line_at(const char * p, const char * end) {
+                    const char * eol = static_cast<const char *>(std::memchr(p, '\n', end - p));
+
+                    if (!eol)
+                        eol = end;
+
+                    std::string_view s(p, eol - p);
+
+                    if (!s.empty() && (s.back() == '\r'))
+                        s.remove_suffix(1);
+
+                    return s;
+                }
+
+                /** parse number in [lo, hi) into @p *p_x,  ignoring surrounding blanks.
+                 *  @return false if field is not entirely a number
+                 **/
+                template <typename Repr>
+                inline bool parse_field(const char * lo, const char * hi, Repr * p_x) {
+                    while ((lo < hi) && ((*lo == ' ') || (*lo == '\t')))
+                        ++lo;
+                    while ((lo < hi) && ((hi[-1] == ' ') || (hi[-1] == '\t')))
+                        --hi;
+
+                    /* from_chars rejects leading '+' */
+                    if ((lo < hi) && (*lo == '+'))
+                        ++lo;
+
+                    auto [p, ec] = std::from_chars(lo, hi, *p_x);
+
+                    return (ec == std::errc()) && (p == hi) && (lo < hi);
+                }
+            } /*namespace csv*/
+        } /*namespace detail*/
+
+        /** @class csv_reader
+         *  @brief parallel reader for CSV files with unit-annotated headers.
+         *
+         *  Header cells have the form @c name[unit],  for example @c latency[us]
+         *  or @c notional[ccy];  unit is a natural-unit abbreviation
+         *  (see @ref natural_unit_from_abbrev).  A cell without brackets
+         *  is a dimensionless column.
+         *
+         *  Use:
+         *  @code
+         *  csv_reader rdr;
+         *  rdr.open("trades.csv");
+         *
+         *  std::vector<quantity<u::millisecond>> latency_v;
+         *  std::vector<xquantity<double>> notional_v;
+         *
+         *  rdr.bind("latency", &latency_v);
+         *  rdr.bind("notional", &notional_v);
+         *
+         *  std::size_t n = rdr.read(8);
+         *  @endcode
+         *
+         *  Conversion factor from file unit to target unit is computed once per column,
+         *  at bind time.  @ref read splits the body into chunks at line boundaries,
+         *  counts rows per chunk,  sizes destinations,  then parses chunks concurrently
+         *  with @c std::from_chars,  each thread writing a disjoint row range.
+         *
+         *  For integer destinations,  integer fields are converted exactly
+         *  when the conversion factor or its reciprocal is a whole number
+         *  (e.g. us -> ns,  ns -> us;  see @ref detail::int_rescale).
+         *
+         *  Fields are separated by a single character;  quoted fields are not supported.
+         *  Blank lines are skipped.
+         **/
+        class csv_reader {
+        public:
+            using unit_type = natural_unit<std::int64_t>;
+
+        public:
+            csv_reader() = default;
+            csv_reader(const csv_reader &) = delete;
+            csv_reader & operator=(const csv_reader &) = delete;
+            ~csv_reader() { this->close(); }
+
+            /** @defgroup csv-reader-access-methods csv_reader access methods **/
+            ///@{
+
+            std::size_t n_col() const { return col_v_.size(); }
+            /** number of malformed or missing fields in bound columns,  from last @ref read **/
+            std::size_t n_error() const { return n_error_; }
+
+            /** name of column @p j **/
+            std::string_view column_name(std::size_t j) const { return col_v_[j].name_; }
+            /** unit of column @p j,  from header **/
+            const unit_type & column_unit(std::size_t j) const { return col_v_[j].unit_; }
+            /** true iff header unit of column @p j was recognized **/
+            bool column_unit_ok(std::size_t j) const { return col_v_[j].unit_ok_; }
+
+            /** index of column named @p name,  or @ref n_col if not present **/
+            std::size_t find_column(std::string_view name) const {
+                for (std::size_t j = 0, n = col_v_.size(); j < n; ++j) {
+                    if (col_v_[j].name_ == name)
+                        return j;
+                }
+                return col_v_.size();
+            }
+
+            ///@}
+
+            /** @defgroup csv-reader-general-methods csv_reader general methods **/
+            ///@{
+
+            /** read from in-memory text @p text,  separator @p sep.
+             *  @p text must outlive this reader.
+             *  @return false if @p text has no header line
+             **/
+            bool attach(std::string_view text, char sep = ',') {
+                this->close();
+
+                return this->parse_header(text, sep);
+            }
+
+            /** map file at @p path,  separator @p sep.
+             *  @return false if file cannot be mapped,  or has no header line
+             **/
+            bool open(const char * path, char sep = ',') {
+                this->close();
+
+                int fd = ::open(path, O_RDONLY);
+
+                if (fd < 0)
+                    return false;
+
+                struct stat st;
+
+                if ((::fstat(fd, &st) != 0) || (st.st_size == 0)) {
+                    ::close(fd);
+                    return false;
+                }
+
+                std::size_t z = st.st_size;
+                void * base = ::mmap(nullptr, z, PROT_READ, MAP_SHARED, fd, 0);
+
+                ::close(fd);
+
+                if (base == MAP_FAILED)
+                    return false;
+
+                map_base_ = base;
+                map_z_ = z;
+
+                /* sequential access;  encourage aggressive readahead */
+                ::madvise(base, z, MADV_SEQUENTIAL);
+
+                if (!this->parse_header(std::string_view(static_cast<const char *>(base), z), sep)) {
+                    this->close();
+                    return false;
+                }
+
+                return true;
+            }
+
+            /** release mapping (if any),  columns and bindings **/
+            void close() {
+                if (map_base_)
+                    ::munmap(map_base_, map_z_);
+
+                map_base_ = nullptr;
+                map_z_ = 0;
+                body_ = std::string_view();
+                col_v_.clear();
+                binding_v_.clear();
+                n_error_ = 0;
+            }
+
+            /** bind column named @p name to @p dest,  converting to unit of @p Quantity.
+             *  @return false if no such column,  header unit not recognized,
+             *          or dimension of header unit differs from @c Quantity
+             **/
+            template <typename Quantity>
+            requires (quantity_concept<Quantity> && Quantity::always_constexpr_unit)
+            bool bind(std::string_view name, std::vector<Quantity> * dest) {
+                using repr_type = typename Quantity::repr_type;
+
+                constexpr auto c_nu = Quantity::s_scaled_unit.natural_unit_.template to_repr<std::int64_t>();
+
+                binding b;
+
+                if (!this->make_binding(name, c_nu, &b))
+                    return false;
+
+                b.dest_ = dest;
+                b.resize_ = [](void * dest, std::size_t n) {
+                    static_cast<std::vector<Quantity> *>(dest)->resize(n);
+                };
+                b.store_ = [](const binding & b, std::size_t i, const char * lo, const char * hi) {
+                    repr_type x;
+
+                    if (!store_value(b, lo, hi, &x))
+                        return false;
+
+                    (*static_cast<std::vector<Quantity> *>(b.dest_))[i] = Quantity(x);
+                    return true;
+                };
+
+                binding_v_.push_back(b);
+                return true;
+            }
+
+            /** bind column named @p name to @p dest,  keeping header unit.
+             *  @return false if no such column,  or header unit not recognized
+             **/
+            template <typename Repr>
+            bool bind(std::string_view name, std::vector<xquantity<Repr>> * dest) {
+                std::size_t j = this->find_column(name);
+
+                if (j == col_v_.size())
+                    return false;
+
+                return this->bind(name, col_v_[j].unit_, dest);
+            }
+
+            /** bind column named @p name to @p dest,  converting to runtime unit @p unit.
+             *  @return false if no such column,  header unit not recognized,
+             *          or dimension of header unit differs from @p unit
+             **/
+            template <typename Repr>
+            bool bind(std::string_view name, const unit_type & unit, std::vector<xquantity<Repr>> * dest) {
+                binding b;
+
+                if (!this->make_binding(name, unit, &b))
+                    return false;
+
+                b.dest_ = dest;
+                b.resize_ = [](void * dest, std::size_t n) {
+                    static_cast<std::vector<xquantity<Repr>> *>(dest)->resize(n);
+                };
+                b.store_ = [](const binding & b, std::size_t i, const char * lo, const char * hi) {
+                    Repr x;
+
+                    if (!store_value(b, lo, hi, &x))
+                        return false;
+
+                    (*static_cast<std::vector<xquantity<Repr>> *>(b.dest_))[i] = xquantity<Repr>(x, b.unit_);
+                    return true;
+                };
+
+                binding_v_.push_back(b);
+                return true;
+            }
+
+            /** parse body into bound columns,  using up to @p n_thread threads.
+             *  Destinations are resized to the number of rows.
+             *  Malformed or missing fields are counted in @ref n_error,
+             *  and leave a default-constructed value.
+             *
+             *  @return number of rows
+             **/
+            std::size_t read(std::size_t n_thread = 1) {
+                n_error_ = 0;
+
+                /* column index -> first binding index (or -1);
+                 * further bindings for the same column chained through binding::next_
+                 */
+                std::vector<int> col2b_v(col_v_.size(), -1);
+
+                for (std::size_t k = binding_v_.size(); k > 0; --k) {
+                    binding & b = binding_v_[k - 1];
+
+                    b.next_ = col2b_v[b.col_];
+                    col2b_v[b.col_] = k - 1;
+                }
+
+                std::vector<const char *> split_v = this->split_chunks(std::max<std::size_t>(n_thread, 1));
+                std::size_t n_chunk = split_v.size() - 1;
+
+                /* pass 1: rows per chunk */
+                std::vector<std::size_t> row0_v(n_chunk + 1, 0);
+
+                this->for_each_chunk(n_chunk,
+                                     [&](std::size_t c) {
+                                         row0_v[c + 1] = count_rows(split_v[c], split_v[c + 1]);
+                                     });
+
+                for (std::size_t c = 0; c < n_chunk; ++c)
+                    row0_v[c + 1] += row0_v[c];
+
+                std::size_t n_row = row0_v[n_chunk];
+
+                for (const auto & b : binding_v_)
+                    b.resize_(b.dest_, n_row);
+
+                /* pass 2: parse;  each chunk writes rows [row0_v[c], row0_v[c+1]) */
+                std::vector<std::size_t> n_error_v(n_chunk, 0);
+
+                this->for_each_chunk(n_chunk,
+                                     [&](std::size_t c) {
+                                         n_error_v[c] = this->parse_chunk(split_v[c], split_v[c + 1],
+                                                                          row0_v[c], col2b_v);
+                                     });
+
+                for (std::size_t e : n_error_v)
+                    n_error_ += e;
+
+                return n_row;
+            }
+
+            ///@}
+
+        private:
+            /** @class column
+             *  @brief header description for one column
+             **/
+            struct column {
+                /** column name,  without unit **/
+                std::string_view name_;
+                /** unit from header **/
+                unit_type unit_;
+                /** false if header unit not recognized **/
+                bool unit_ok_ = false;
+            };
+
+            /** @class binding
+             *  @brief type-erased destination for one column
+             **/
+            struct binding {
+                /** column index **/
+                std::size_t col_ = 0;
+                /** next binding for the same column (or -1);  set by @ref read **/
+                int next_ = -1;
+                /** destination vector **/
+                void * dest_ = nullptr;
+                /** multiply parsed values by this factor;  1 when file unit == target unit **/
+                double factor_ = 1.0;
+                /** same factor,  for integer destinations **/
+                detail::int_rescale<std::int64_t> int_rescale_;
+                /** target unit (used by xquantity destinations) **/
+                unit_type unit_;
+                /** resize destination to @p n rows **/
+                void (*resize_)(void * dest, std::size_t n) = nullptr;
+                /** parse field [lo,hi) into row @p i.  false on malformed input **/
+                bool (*store_)(const binding & b, std::size_t i, const char * lo, const char * hi) = nullptr;
+            };
+
+        private:
+            /** parse field [lo,hi) and apply conversion factor of @p b **/
+            template <typename Repr>
+            static bool store_value(const binding & b, const char * lo, const char * hi, Repr * p_x) {
+                if (b.factor_ == 1.0)
+                    return detail::csv::parse_field(lo, hi, p_x);
+
+                if constexpr (std::is_integral_v<Repr>) {
+                    /* integer field: exact when factor (or 1/factor) is whole */
+                    std::int64_t k;
+
+                    if (detail::csv::parse_field(lo, hi, &k)) {
+                        *p_x = static_cast<Repr>(b.int_rescale_(k));
+                        return true;
+                    }
+                }
+
+                double x;
+
+                if (!detail::csv::parse_field(lo, hi, &x))
+                    return false;
+
+                if constexpr (std::is_integral_v<Repr>)
+                    *p_x = static_cast<Repr>(b.int_rescale_.from_double(x));
+                else
+                    *p_x = static_cast<Repr>(x * b.factor_);
+
+                return true;
+            }
+
+            bool parse_header(std::string_view text, char sep) {
+                std::string_view hdr = detail::csv::line_at(text.data(), text.data() + text.size());
+
+                if (hdr.empty())
+                    return false;
+
+                std::size_t eol = text.find('\n');
+
+                body_ = ((eol == std::string_view::npos) ? std::string_view() : text.substr(eol + 1));
+                sep_ = sep;
+
+                while (true) {
+                    std::size_t p = hdr.find(sep);
+                    std::string_view cell = detail::csv::trim(hdr.substr(0, p));
+
+                    column col;
+                    std::size_t lb = cell.find('[');
+
+                    if ((lb != std::string_view::npos) && (cell.back() == ']')) {
+                        col.name_ = detail::csv::trim(cell.substr(0, lb));
+                        col.unit_ok_ = natural_unit_from_abbrev(detail::csv::trim(cell.substr(lb + 1, cell.size() - lb - 2)),
+                                                                &col.unit_);
+                    } else {
+                        col.name_ = cell;
+                        col.unit_ok_ = true;
+                    }
+
+                    col_v_.push_back(col);
+
+                    if (p == std::string_view::npos)
+                        break;
+
+                    hdr.remove_prefix(p + 1);
+                }
+
+                return true;
+            }
+
+            /** prepare binding of column @p name to target unit @p unit **/
+            bool make_binding(std::string_view name, const unit_type & unit, binding * p_b) const {
+                std::size_t j = this->find_column(name);
+
+                if ((j == col_v_.size()) || !col_v_[j].unit_ok_)
+                    return false;
+
+                const unit_type & nu = col_v_[j].unit_;
+
+                double factor = ((nu == unit)
+                                 ? 1.0
+                                 : xquantity<double, std::int64_t>(1, nu).rescale(unit).scale());
+
+                /* rescale produces NaN on dimension mismatch */
+                if (std::isnan(factor))
+                    return false;
+
+                p_b->col_ = j;
+                p_b->factor_ = factor;
+                p_b->int_rescale_ = detail::int_rescale<std::int64_t>(factor);
+                p_b->unit_ = unit;
+
+                return true;
+            }
+
+            /** split body into (at most) @p n chunks,  each ending on a line boundary.
+             *  @return chunk boundaries,  size = 1 + number of chunks
+             **/
+            std::vector<const char *> split_chunks(std::size_t n) const {
+                const char * lo = body_.data();
+                const char * end = body_.data() + body_.size();
+
+                std::vector<const char *> split_v;
+                split_v.push_back(lo);
+
+                for (std::size_t c = 1; c < n; ++c) {
+                    const char * p = std::max(split_v.back(), lo + (body_.size() * c) / n);
+
+                    if (p == end)
+                        break;
+
+                    const char * eol = static_cast<const char *>(std::memchr(p, '\n', end - p));
+
+                    if (!eol)
+                        break;
+
+                    split_v.push_back(eol + 1);
+                }
+
+                split_v.push_back(end);
+
+                return split_v;
+            }
+
+            /** count non-blank lines in [lo, end) **/
+            static std::size_t count_rows(const char * lo, const char * end) {
+                std::size_t n = 0;
+
+                for (const char * p = lo; p < end; ) {
+                    std::string_view line = detail::csv::line_at(p, end);
+                    const char * eol = line.data() + line.size();
+
+                    p = static_cast<const char *>(std::memchr(eol, '\n', end - eol));
+                    p = (p ? p + 1 : end);
+
+                    if (!detail::csv::trim(line).empty())
+                        ++n;
+                }
+
+                return n;
+            }
+
+            /** parse lines in [lo, end) into rows starting at @p row0.
+             *  @return number of errors
+             **/
+            std::size_t parse_chunk(const char * lo, const char * end,
+                                    std::size_t row0,
+                                    const std::vector<int> & col2b_v) const {
+                std::size_t n_error = 0;
+                std::size_t i = row0;
+
+                for (const char * p = lo; p < end; ) {
+                    std::string_view line = detail::csv::line_at(p, end);
+                    const char * eol = line.data() + line.size();
+
+                    p = static_cast<const char *>(std::memchr(eol, '\n', end - eol));
+                    p = (p ? p + 1 : end);
+
+                    if (detail::csv::trim(line).empty())
+                        continue;
+
+                    const char * f = line.data();
+                    std::size_t j = 0;
+
+                    for (; j < col2b_v.size(); ++j) {
+                        const char * g = static_cast<const char *>(std::memchr(f, sep_, eol - f));
+
+                        if (!g)
+                            g = eol;
+
+                        for (int k = col2b_v[j]; k >= 0; k = binding_v_[k].next_) {
+                            const binding & b = binding_v_[k];
+
+                            if (!b.store_(b, i, f, g))
+                                ++n_error;
+                        }
+
+                        if (g == eol) {
+                            ++j;
+                            break;
+                        }
+
+                        f = g + 1;
+                    }
+
+                    /* short line: remaining bound columns are missing */
+                    for (; j < col2b_v.size(); ++j) {
+                        for (int k = col2b_v[j]; k >= 0; k = binding_v_[k].next_)
+                            ++n_error;
+                    }
+
+                    ++i;
+                }
+
+                return n_error;
+            }
+
+            /** run @p fn(c) for c in [0, n),  one thread per chunk **/
+            template <typename Fn>
+            static void for_each_chunk(std::size_t n, Fn && fn) {
+                if (n <= 1) {
+                    for (std::size_t c = 0; c < n; ++c)
+                        fn(c);
+                    return;
+                }
+
+                std::vector<std::thread> thread_v;
+                thread_v.reserve(n - 1);
+
+                for (std::size_t c = 1; c < n; ++c)
+                    thread_v.emplace_back(fn, c);
+
+                fn(0);
+
+                for (auto & t : thread_v)
+                    t.join();
+            }
+
+        private:
+            /** mapped file,  if opened with @ref open **/
+            void * map_base_ = nullptr;
+            std::size_t map_z_ = 0;
+            /** text following header line **/
+            std::string_view body_;
+            /** field separator **/
+            char sep_ = ',';
+            /** columns,  in header order **/
+            std::vector<column> col_v_;
+            /** bound columns **/
+            std::vector<binding> binding_v_;
+            /** error count from last @ref read **/
+            std::size_t n_error_ = 0;
+        };
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end csv_reader.hpp **/
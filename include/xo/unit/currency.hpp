@@ -0,0 +1,70 @@
+/** @file currency.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace xo {
+    namespace qty {
+        /** @enum currency_code
+         *  @brief identifies an actual currency.
+         *
+         *  All currency amounts share @c dimension::currency.
+         *  When the currency is known at compile time,  @ref ccy_quantity
+         *  carries it in the type,  so amounts in different currencies don't mix.
+         *  Otherwise (e.g. a column of @c xquantity read at runtime)
+         *  a currency code travels alongside the amount.
+         *  Conversion between currencies goes through an @ref fx_matrix.
+         **/
+        enum class currency_code : std::uint8_t {
+            /** US dollar **/
+            usd,
+            /** euro **/
+            eur,
+            /** british pound **/
+            gbp,
+            /** japanese yen **/
+            jpy,
+            /** swiss franc **/
+            chf,
+            /** canadian dollar **/
+            cad,
+            /** australian dollar **/
+            aud,
+            /** hong kong dollar **/
+            hkd,
+
+            /** not a currency.  comes last, counts entries **/
+            n_ccy
+        };
+
+        using ccy = currency_code;
+
+        /** @brief ISO 4217 code for a currency enum **/
+        inline constexpr const char *
+        ccy2str(currency_code x)
+        {
+            switch(x) {
+            case currency_code::usd: return "USD";
+            case currency_code::eur: return "EUR";
+            case currency_code::gbp: return "GBP";
+            case currency_code::jpy: return "JPY";
+            case currency_code::chf: return "CHF";
+            case currency_code::cad: return "CAD";
+            case currency_code::aud: return "AUD";
+            case currency_code::hkd: return "HKD";
+            default: break;
+            }
+            return "?ccy";
+        }
+
+        /** @brief number of built-in currencies, convenient for array sizing **/
+        inline constexpr std::size_t n_ccy = static_cast<std::size_t>(currency_code::n_ccy);
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end currency.hpp **/
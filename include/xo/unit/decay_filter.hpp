@@ -0,0 +1,192 @@
+/** @file decay_filter.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "running_stats.hpp"
+#include <numbers>
+
+namespace xo {
+    namespace qty {
+        /** @class decay_filter
+         *  @brief exponential smoothing over irregularly-spaced samples,
+         *  with decay specified by a half-life.
+         *
+         *  After a sample @c x at time @c t,  with previous average @c m at time @c t0:
+         *  @code
+         *  w = 2^(-(t - t0) / halflife)
+         *  m = w*m + (1-w)*x
+         *  @endcode
+         *
+         *  Timestamps are quantities with compile-time unit @p TimeQuantity.
+         *  Half-life is converted to that unit once,  at construction;
+         *  after that each update is unit-free arithmetic on @c repr_type.
+         *  Timestamp differences and 1/halflife are held in double,
+         *  so integer timestamps (e.g. @c std::int64_t nanoseconds) work as well.
+         *  Decay factor is cached,  so regularly-spaced samples skip the @c exp2 call.
+         *
+         *  @p Quantity may be a @ref quantity or an @ref xquantity.
+         **/
+        template <typename Quantity, typename TimeQuantity>
+        requires (quantity_concept<Quantity>
+                  && quantity_concept<TimeQuantity>
+                  && TimeQuantity::always_constexpr_unit
+                  && (TimeQuantity::s_scaled_unit.n_bpu() == 1)
+                  && (TimeQuantity::s_scaled_unit.lookup_dim(dim::time).power() == power_ratio_type(1)))
+        class decay_filter {
+        public:
+            /** @defgroup decay-filter-type-traits decay_filter type traits **/
+            ///@{
+            /** @brief type for a single sample **/
+            using quantity_type = Quantity;
+            /** @brief type for a sample timestamp **/
+            using time_type = TimeQuantity;
+            /** @brief representation for sample scale **/
+            using repr_type = typename Quantity::repr_type;
+            /** @brief representation for timestamp scale **/
+            using time_repr_type = typename TimeQuantity::repr_type;
+            ///@}
+
+        public:
+            /** @defgroup decay-filter-ctors decay_filter constructors **/
+            ///@{
+            /** filter with half-life @p halflife.  May use any time unit. **/
+            template <typename HalfLifeQuantity>
+            requires (quantity_concept<HalfLifeQuantity> && HalfLifeQuantity::always_constexpr_unit)
+            explicit decay_filter(const HalfLifeQuantity & halflife)
+                : halflife_{rescale_rounded<TimeQuantity::s_scaled_unit, time_repr_type>(halflife)},
+                  inv_halflife_{1.0 / halflife.template with_repr<double>()
+                                .template rescale_ext<TimeQuantity::s_scaled_unit>().scale()}
+                {}
+
+            /** filter with e-folding time @p tau:  weight on a sample decays by 1/e over @p tau **/
+            template <typename TauQuantity>
+            requires (quantity_concept<TauQuantity> && TauQuantity::always_constexpr_unit)
+            static decay_filter from_decay_window(const TauQuantity & tau) {
+                return decay_filter(tau.template with_repr<double>()
+                                    * std::numbers::ln2_v<double>);
+            }
+            ///@}
+
+            /** @defgroup decay-filter-access-methods decay_filter access methods **/
+            ///@{
+
+            /** half-life,  in timestamp units;  rounded to nearest for integer timestamps **/
+            const TimeQuantity & halflife() const { return halflife_; }
+            /** number of samples **/
+            std::uint64_t count() const { return n_; }
+            /** timestamp of most recent sample **/
+            TimeQuantity last_time() const { return TimeQuantity(t_); }
+            /** current smoothed value.  NaN if empty **/
+            Quantity value() const {
+                return unit_ * ((n_ > 0) ? m_ : std::numeric_limits<repr_type>::quiet_NaN());
+            }
+
+            /** weight that a sample at time @p t would place on accumulated history
+             *  @pre @p t >= @ref last_time
+             **/
+            repr_type weight_at(const TimeQuantity & t) const {
+                return ::exp2(-static_cast<double>(t.scale() - t_) * inv_halflife_);
+            }
+
+            ///@}
+
+            /** @defgroup decay-filter-general-methods decay_filter general methods **/
+            ///@{
+
+            /** include sample @p x at time @p t.  First sample initializes filter.
+             *  @pre @p t >= @ref last_time
+             **/
+            void add(const TimeQuantity & t, const Quantity & x) {
+                if (n_ == 0) {
+                    unit_ = x.unit_qty();
+                    m_ = x.scale();
+                } else {
+                    double dt = static_cast<double>(t.scale() - t_);
+
+                    if (dt != dt_) {
+                        dt_ = dt;
+                        w_ = ::exp2(-dt * inv_halflife_);
+                    }
+
+                    m_ = w_ * m_ + (repr_type(1) - w_) * detail::sample_scale(unit_, x);
+                }
+
+                t_ = t.scale();
+                ++n_;
+            }
+
+            /** include samples (@p t_v[i], @p x_v[i]) in order.
+             *  @pre @p t_v.size() == @p x_v.size()
+             *  @pre @p t_v non-decreasing
+             **/
+            void add(std::span<const TimeQuantity> t_v, std::span<const Quantity> x_v) {
+                std::size_t n = t_v.size();
+
+                if (n == 0)
+                    return;
+
+                std::size_t i = 0;
+
+                if (n_ == 0)
+                    this->add(t_v[i++], x_v[0]);
+
+                std::size_t i0 = i;
+
+                /* hoist members into locals for the loop body */
+                repr_type m = m_;
+                time_repr_type t0 = t_;
+                double dt0 = dt_;
+                repr_type w = w_;
+
+                for (; i < n; ++i) {
+                    time_repr_type t = t_v[i].scale();
+                    double dt = static_cast<double>(t - t0);
+
+                    if (dt != dt0) {
+                        dt0 = dt;
+                        w = ::exp2(-dt * inv_halflife_);
+                    }
+
+                    m = w * m + (repr_type(1) - w) * detail::sample_scale(unit_, x_v[i]);
+                    t0 = t;
+                }
+
+                m_ = m;
+                t_ = t0;
+                dt_ = dt0;
+                w_ = w;
+                n_ += (n - i0);
+            }
+
+            ///@}
+
+        private:
+            /** @defgroup decay-filter-instance-vars decay_filter instance variables **/
+            ///@{
+
+            /** half-life **/
+            TimeQuantity halflife_;
+            /** 1/halflife,  in timestamp units.  double even for integer timestamps **/
+            double inv_halflife_;
+            /** unit quantity;  @ref m_ is a multiple of this **/
+            Quantity unit_ = Quantity().unit_qty();
+            /** number of samples **/
+            std::uint64_t n_ = 0;
+            /** current smoothed value **/
+            repr_type m_ = 0;
+            /** timestamp of last sample **/
+            time_repr_type t_ = 0;
+            /** spacing between last two samples;  NaN until known **/
+            double dt_ = std::numeric_limits<double>::quiet_NaN();
+            /** decay factor for spacing @ref dt_ **/
+            repr_type w_ = 1;
+
+            ///@}
+        }; /*decay_filter*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end decay_filter.hpp **/
@@ -25,9 +25,10 @@ namespace xo {
             /** a currency amount. native unit depends on actual currency.
              *  For USD: one US dollar.
              *
-             *  NOTE: multicurrency work not supported by *xo-unit*.
-             *  - (1usd + 1eur) is well-defined.
-             *  - (1sec + 1m) is not.
+             *  Amounts in different actual currencies share this dimension;
+             *  the actual currency is carried by @ref ccy_quantity,
+             *  so (1usd + 1eur) does not compile.
+             *  See @ref currency_code and @ref fx_matrix for multi-currency support.
              **/
             currency,
             /** A screen price.
@@ -35,6 +36,12 @@ namespace xo {
              *  expect useful to bucket separately from currenty amounts.
              **/
             price,
+            /** amount of information (data size).  native unit = 1 byte **/
+            information,
+            /** count of network packets.  native unit = 1 packet **/
+            packet,
+            /** count of application messages.  native unit = 1 message **/
+            message,
 
             /** not a dimension.  comes last, counts entries **/
             n_dim
@@ -52,13 +59,16 @@ namespace xo {
             case dimension::time:     return "time";
             case dimension::currency: return "currency";
             case dimension::price:    return "price";
+            case dimension::information: return "information";
+            case dimension::packet:   return "packet";
+            case dimension::message:  return "message";
             default: break;
             }
             return "?dim";
         }
 
         /** @brief number of built-in dimensions, convenient for array sizing **/
-        static constexpr std::size_t n_dim = static_cast<std::size_t>(dimension::n_dim);
+        inline constexpr std::size_t n_dim = static_cast<std::size_t>(dimension::n_dim);
     } /*namespace qty*/
 } /*namespace xo*/
 
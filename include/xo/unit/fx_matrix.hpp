@@ -0,0 +1,335 @@
+/** @file fx_matrix.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "ccy_quantity.hpp"
+#include "xquantity.hpp"
+#include <array>
+#include <atomic>
+#include <span>
+#include <limits>
+#include <cmath>
+#include <type_traits>
+
+namespace xo {
+    namespace qty {
+        /** @class fx_matrix
+         *  @brief runtime table of exchange rates between currencies.
+         *
+         *  A single writer (e.g. a market-data feed thread) publishes quotes;
+         *  any number of reader threads look up rates concurrently.
+         *
+         *  - Each cell of the rate matrix is a separate atomic,
+         *    so readers are wait-free and never observe a torn rate.
+         *  - A reader converting a column loads exactly one rate,
+         *    so the conversion itself is a single multiply per element.
+         *  - A reader that needs several mutually-consistent rates
+         *    uses @ref read_consistent;  @ref version is a sequence lock,
+         *    odd while a publish is in progress.
+         *
+         *  Rates are derived from per-currency quotes against a common base:
+         *  @code
+         *  rate(from, to) = quote(from) / quote(to)
+         *  @endcode
+         *  so that @c rate(from,to) converts an amount in currency @p from
+         *  to the same amount expressed in currency @p to.
+         *
+         *  Currencies with no published quote have NaN rates
+         *  (except the trivial @c rate(c,c) = 1).
+         **/
+        template <typename Repr = double>
+        class fx_matrix {
+        public:
+            /** @defgroup fx-matrix-type-traits fx_matrix type traits **/
+            ///@{
+            /** @brief representation for an exchange rate **/
+            using repr_type = Repr;
+            ///@}
+
+        public:
+            /** @defgroup fx-matrix-ctors fx_matrix constructors **/
+            ///@{
+            /** create matrix with no known quotes **/
+            fx_matrix() {
+                for (std::size_t i = 0; i < n_ccy; ++i) {
+                    quote_v_[i] = std::numeric_limits<Repr>::quiet_NaN();
+
+                    for (std::size_t j = 0; j < n_ccy; ++j) {
+                        rate_v_[cell_ix(i, j)].store((i == j)
+                                                     ? Repr(1)
+                                                     : std::numeric_limits<Repr>::quiet_NaN(),
+                                                     std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            fx_matrix(const fx_matrix &) = delete;
+            fx_matrix & operator=(const fx_matrix &) = delete;
+            ///@}
+
+            /** @defgroup fx-matrix-access-methods fx_matrix access methods **/
+            ///@{
+
+            /** multiplier converting an amount in currency @p from to currency @p to.
+             *  Wait-free.
+             **/
+            Repr rate(currency_code from, currency_code to) const {
+                return rate_v_[cell_ix(from, to)].load(std::memory_order_acquire);
+            }
+
+            /** sequence number;  advances by 2 per publish.  Wait-free.
+             *
+             *  Odd while a publish is in progress.
+             *  Rates read between two equal,  even,  values of @c version
+             *  are mutually consistent;  see @ref read_consistent.
+             **/
+            std::uint64_t version() const { return version_.load(std::memory_order_acquire); }
+
+            /** invoke @p fn on this matrix,  retrying until it ran without
+             *  overlapping a publish;  return its result.
+             *  @p fn should only read rates,  and must not block.
+             *
+             *  Lock-free, but not wait-free:  may retry while the writer is active.
+             **/
+            template <typename Fn>
+            auto read_consistent(Fn && fn) const {
+                for (;;) {
+                    std::uint64_t v0 = this->version();
+
+                    if (v0 & 1)
+                        continue;
+
+                    /* rate() loads with acquire,  so the second version load
+                     * cannot be satisfied before them
+                     */
+                    auto retval = fn(*this);
+
+                    if (this->version() == v0)
+                        return retval;
+                }
+            }
+
+            /** convert amount @p x from currency @p From to currency @p To **/
+            template <currency_code To, currency_code From, typename Quantity>
+            ccy_quantity<To, Quantity> convert(const ccy_quantity<From, Quantity> & x) const;
+
+            ///@}
+
+            /** @defgroup fx-matrix-writer-methods fx_matrix writer methods **/
+            ///@{
+
+            /** publish quote for currency @p c:
+             *  value of one unit of @p c,  expressed in the (arbitrary, but fixed) base currency.
+             *
+             *  Writer-side only;  at most one thread may publish at a time.
+             **/
+            void publish(currency_code c, Repr base_per_unit) {
+                std::size_t ic = static_cast<std::size_t>(c);
+
+                this->begin_publish();
+
+                quote_v_[ic] = base_per_unit;
+
+                for (std::size_t j = 0; j < n_ccy; ++j) {
+                    if (j == ic)
+                        continue;
+
+                    rate_v_[cell_ix(ic, j)].store(quote_v_[ic] / quote_v_[j], std::memory_order_release);
+                    rate_v_[cell_ix(j, ic)].store(quote_v_[j] / quote_v_[ic], std::memory_order_release);
+                }
+
+                this->end_publish();
+            }
+
+            /** publish quotes for all currencies in one step;
+             *  @p base_per_unit_v is indexed by @ref currency_code
+             **/
+            void publish_all(std::span<const Repr, n_ccy> base_per_unit_v) {
+                for (std::size_t i = 0; i < n_ccy; ++i)
+                    quote_v_[i] = base_per_unit_v[i];
+
+                this->begin_publish();
+
+                for (std::size_t i = 0; i < n_ccy; ++i) {
+                    for (std::size_t j = 0; j < n_ccy; ++j) {
+                        if (i != j)
+                            rate_v_[cell_ix(i, j)].store(quote_v_[i] / quote_v_[j], std::memory_order_release);
+                    }
+                }
+
+                this->end_publish();
+            }
+
+            ///@}
+
+        private:
+            /** mark publish in progress:  version becomes odd.
+             *  Rate stores that follow are release stores,  so a reader that observes
+             *  any of them also observes the odd version
+             **/
+            void begin_publish() {
+                version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            }
+
+            /** mark publish complete:  version becomes even again **/
+            void end_publish() {
+                version_.store(version_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+            }
+
+            static constexpr std::size_t cell_ix(std::size_t from, std::size_t to) {
+                return from * n_ccy + to;
+            }
+            static constexpr std::size_t cell_ix(currency_code from, currency_code to) {
+                return cell_ix(static_cast<std::size_t>(from), static_cast<std::size_t>(to));
+            }
+
+        private:
+            /** @defgroup fx-matrix-instance-vars fx_matrix instance variables **/
+            ///@{
+
+            /** writer-side copy of latest quotes, indexed by @ref currency_code **/
+            std::array<Repr, n_ccy> quote_v_;
+            /** rate_v_[from * n_ccy + to] converts @c from -> @c to **/
+            std::array<std::atomic<Repr>, n_ccy * n_ccy> rate_v_;
+            /** sequence lock:  odd while a publish is in progress **/
+            std::atomic<std::uint64_t> version_ = 0;
+
+            ///@}
+        }; /*fx_matrix*/
+
+        namespace detail {
+            /** multiplier for a unit with currency exponent @p power,
+             *  given exchange rate @p rate.  Usually @p power is 1.
+             **/
+            template <typename Repr>
+            inline Repr
+            fx_factor(Repr rate, const power_ratio_type & power)
+            {
+                if (power == power_ratio_type(1))
+                    return rate;
+                if (power.is_zero())
+                    return Repr(1);
+
+                return ::pow(rate, power.template convert_to<Repr>());
+            }
+        }
+
+        template <typename Repr>
+        template <currency_code To, currency_code From, typename Quantity>
+        ccy_quantity<To, Quantity>
+        fx_matrix<Repr>::convert(const ccy_quantity<From, Quantity> & x) const
+        {
+            using q_repr_type = typename Quantity::repr_type;
+
+            q_repr_type k = detail::fx_factor(static_cast<q_repr_type>(this->rate(From, To)),
+                                              detail::ccy_power_v<Quantity>);
+
+            return ccy_quantity<To, Quantity>(Quantity(k * x.scale()));
+        }
+
+        /** @defgroup fx-convert fx conversion functions **/
+        ///@{
+
+        /** convert a column of currency amounts @p src from currency @p from
+         *  to currency @p to, writing results to @p dest.
+         *
+         *  Loads one rate, then a single multiply per element.
+         *
+         *  @pre @p dest.size() >= @p src.size()
+         **/
+        template <typename Repr>
+        inline void
+        fx_convert(const fx_matrix<Repr> & fx,
+                   currency_code from,
+                   currency_code to,
+                   std::span<const std::type_identity_t<Repr>> src,
+                   std::span<std::type_identity_t<Repr>> dest)
+        {
+            Repr k = fx.rate(from, to);
+
+            for (std::size_t i = 0, n = src.size(); i < n; ++i)
+                dest[i] = k * src[i];
+        }
+
+        /** convert a column of compile-time-unit quantities @p src from currency @p from
+         *  to currency @p to, writing results to @p dest.
+         *  Exponent of @c dim::currency is established at compile time.
+         *
+         *  @pre @p dest.size() >= @p src.size()
+         **/
+        template <typename Quantity, typename Repr>
+        requires (quantity_concept<Quantity>
+                  && Quantity::always_constexpr_unit)
+        inline void
+        fx_convert(const fx_matrix<Repr> & fx,
+                   currency_code from,
+                   currency_code to,
+                   std::span<const Quantity> src,
+                   std::span<Quantity> dest)
+        {
+            using q_repr_type = typename Quantity::repr_type;
+
+            constexpr auto power = Quantity::s_scaled_unit.lookup_dim(dim::currency).power();
+
+            q_repr_type k = detail::fx_factor(static_cast<q_repr_type>(fx.rate(from, to)), power);
+
+            for (std::size_t i = 0, n = src.size(); i < n; ++i)
+                dest[i] = Quantity(k * src[i].scale());
+        }
+
+        /** convert a column of amounts @p src from currency @p From
+         *  to currency @p To, writing results to @p dest.
+         *  Both currencies,  and the exponent of @c dim::currency,
+         *  are established at compile time.
+         *
+         *  @pre @p dest.size() >= @p src.size()
+         **/
+        template <currency_code From, currency_code To, typename Quantity, typename Repr>
+        inline void
+        fx_convert(const fx_matrix<Repr> & fx,
+                   std::span<const ccy_quantity<From, Quantity>> src,
+                   std::span<ccy_quantity<To, Quantity>> dest)
+        {
+            using q_repr_type = typename Quantity::repr_type;
+
+            q_repr_type k = detail::fx_factor(static_cast<q_repr_type>(fx.rate(From, To)),
+                                              detail::ccy_power_v<Quantity>);
+
+            for (std::size_t i = 0, n = src.size(); i < n; ++i)
+                dest[i] = ccy_quantity<To, Quantity>(Quantity(k * src[i].scale()));
+        }
+
+        /** convert a column of xquantities @p src from currency @p from
+         *  to currency @p to, writing results to @p dest.
+         *
+         *  @pre all members of @p src share the same unit.
+         *  @pre @p dest.size() >= @p src.size()
+         **/
+        template <typename Repr, typename Int>
+        inline void
+        fx_convert(const fx_matrix<Repr> & fx,
+                   currency_code from,
+                   currency_code to,
+                   std::span<const xquantity<Repr, Int>> src,
+                   std::span<xquantity<Repr, Int>> dest)
+        {
+            if (src.empty())
+                return;
+
+            const natural_unit<Int> & unit = src[0].unit();
+
+            Repr k = detail::fx_factor(fx.rate(from, to),
+                                       unit.lookup_dim(dim::currency).power());
+
+            for (std::size_t i = 0, n = src.size(); i < n; ++i)
+                dest[i] = src[i].scale_by(k);
+        }
+
+        ///@}
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end fx_matrix.hpp **/
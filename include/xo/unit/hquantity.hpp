@@ -0,0 +1,299 @@
+/** @file hquantity.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "rescale_column.hpp"
+#include <string_view>
+#include <compare>
+#include <limits>
+#include <cmath>
+
+namespace xo {
+    namespace qty {
+        /** @class hunit
+         *  @brief unit with dimension @p Dimension fixed at compile time,
+         *  and scale chosen at runtime.
+         *
+         *  Represented by a single double:  the number of native units
+         *  (see @c detail::native_nu) per @c hunit.
+         *  An invalid unit (dimension mismatch at runtime) holds NaN.
+         *
+         *  @p Dimension is a natural unit in native units,
+         *  in dimension order;  use the @ref hquantity alias to get it from any unit.
+         **/
+        template <auto Dimension>
+        class hunit {
+        public:
+            using unit_type = natural_unit<std::int64_t>;
+
+            /** native unit for this dimension,  e.g. @c m.s^-1 **/
+            static constexpr auto s_native_unit = Dimension;
+
+        public:
+            /** @defgroup hunit-ctors hunit constructors **/
+            ///@{
+
+            /** native unit **/
+            constexpr hunit() = default;
+
+            /** unit @p ScaledUnit;  dimension checked at compile time **/
+            template <auto ScaledUnit>
+            requires (detail::same_dimension_v<ScaledUnit, Dimension>)
+            static constexpr hunit from() {
+                return hunit(detail::rescale_factor<ScaledUnit, Dimension, double>());
+            }
+
+            /** unit equal to @p f native units **/
+            static constexpr hunit from_native_factor(double f) {
+                return hunit(f);
+            }
+
+            /** unit @p nu chosen at runtime.  Invalid if dimension differs **/
+            static hunit from_natural_unit(const unit_type & nu) {
+                constexpr auto c_native = Dimension.natural_unit_.template to_repr<std::int64_t>();
+
+                /* rescale produces NaN on dimension mismatch */
+                return hunit(xquantity<double, std::int64_t>(1, nu).rescale(c_native).scale());
+            }
+
+            /** unit with abbreviation @p abbrev,  e.g. @c "km.hr^-1".
+             *  Invalid if abbreviation can't be parsed,  or dimension differs
+             **/
+            static hunit from_abbrev(std::string_view abbrev) {
+                unit_type nu;
+
+                if (!natural_unit_from_abbrev(abbrev, &nu))
+                    return hunit(std::numeric_limits<double>::quiet_NaN());
+
+                return from_natural_unit(nu);
+            }
+
+            ///@}
+
+            /** @defgroup hunit-access-methods hunit access methods **/
+            ///@{
+
+            /** false after runtime dimension mismatch **/
+            bool is_valid() const { return !std::isnan(native_factor_); }
+            /** number of native units per this unit **/
+            constexpr double native_factor() const { return native_factor_; }
+
+            ///@}
+
+        private:
+            explicit constexpr hunit(double f) : native_factor_{f} {}
+
+        private:
+            /** native units per this unit **/
+            double native_factor_ = 1.0;
+        };
+
+        /** @class basic_hquantity
+         *  @brief quantity with compile-time dimension and runtime scale.
+         *
+         *  Between @c quantity (dimension and unit fixed at compile time)
+         *  and @c xquantity (neither fixed):  for APIs where units come from
+         *  configuration,  but dimension errors should still fail to compile.
+         *
+         *  State is a @p Repr scale and a double unit factor (16 bytes for double).
+         *  - @c * and @c / multiply scales and unit factors:  no rescale.
+         *  - @c + and @c - take the left operand's unit;  one multiply to align
+         *    the right operand when units differ.
+         *  - comparison compares native values.
+         *  - conversion to a compile-time unit is one multiply.
+         *
+         *  Prefer alias @ref hquantity.
+         **/
+        template <auto Dimension, typename Repr = double>
+        class basic_hquantity {
+        public:
+            /** @defgroup hquantity-type-traits hquantity type traits **/
+            ///@{
+            using repr_type = Repr;
+            using hunit_type = hunit<Dimension>;
+            ///@}
+
+            static constexpr auto s_native_unit = Dimension;
+
+        public:
+            /** @defgroup hquantity-ctors hquantity constructors **/
+            ///@{
+
+            constexpr basic_hquantity() = default;
+            /** amount @p scale of unit @p unit **/
+            constexpr basic_hquantity(Repr scale, const hunit_type & unit) : scale_{scale}, unit_{unit} {}
+
+            /** from quantity @p x,  keeping its unit;  dimension checked at compile time **/
+            template <typename Quantity>
+            requires (quantity_concept<Quantity> && Quantity::always_constexpr_unit
+                      && detail::same_dimension_v<Quantity::s_scaled_unit, Dimension>)
+            constexpr basic_hquantity(const Quantity & x)
+                : scale_{static_cast<Repr>(x.scale())},
+                  unit_{hunit_type::template from<Quantity::s_scaled_unit>()} {}
+
+            ///@}
+
+            /** @defgroup hquantity-access-methods hquantity access methods **/
+            ///@{
+
+            constexpr Repr scale() const { return scale_; }
+            constexpr const hunit_type & unit() const { return unit_; }
+            /** value as multiple of native unit **/
+            constexpr Repr native_scale() const { return static_cast<Repr>(unit_.native_factor() * scale_); }
+
+            ///@}
+
+            /** @defgroup hquantity-conversion hquantity unit conversion **/
+            ///@{
+
+            /** same value expressed in @p unit2.  One multiply **/
+            constexpr basic_hquantity rescale(const hunit_type & unit2) const {
+                if (unit2.native_factor() == unit_.native_factor())
+                    return basic_hquantity(scale_, unit2);
+
+                return basic_hquantity(static_cast<Repr>((unit_.native_factor() / unit2.native_factor()) * scale_),
+                                       unit2);
+            }
+
+            /** same value as compile-time-unit quantity.  One multiply **/
+            template <auto ScaledUnit2>
+            requires (detail::same_dimension_v<ScaledUnit2, Dimension>)
+            constexpr quantity<ScaledUnit2, Repr> to_quantity() const {
+                constexpr double k = detail::rescale_factor<Dimension, ScaledUnit2, double>();
+
+                return quantity<ScaledUnit2, Repr>(static_cast<Repr>(k * unit_.native_factor() * scale_));
+            }
+
+            ///@}
+
+            constexpr basic_hquantity operator-() const { return basic_hquantity(-scale_, unit_); }
+
+        private:
+            Repr scale_ = 0;
+            hunit_type unit_;
+        };
+
+        /** hybrid quantity with dimension of @p ScaledUnit
+         *  (any unit of that dimension gives the same type)
+         *
+         *  @code
+         *  using speed = hquantity<u::meter / u::second>;
+         *
+         *  speed v(40.0, speed::hunit_type::from_abbrev(cfg_unit));   // e.g. "km.hr^-1"
+         *  speed w = qty::kilometers(1.0) / qty::seconds(1.0);
+         *  auto z = v + w;                  // in v's unit
+         *  auto q = z.to_quantity<u::meter / u::second>();
+         *
+         *  // speed bad = qty::seconds(1.0);   // compile error
+         *  @endcode
+         **/
+        template <auto ScaledUnit, typename Repr = double>
+        using hquantity = basic_hquantity<detail::su_promote<std::int64_t>(detail::native_nu(ScaledUnit.natural_unit_.template to_repr<std::int64_t>())),
+                                          Repr>;
+
+        /** @defgroup hquantity-operators hquantity operators **/
+        ///@{
+
+        template <auto D, typename R1, typename R2>
+        constexpr auto
+        operator+ (const basic_hquantity<D, R1> & x, const basic_hquantity<D, R2> & y)
+        {
+            using repr_type = std::common_type_t<R1, R2>;
+
+            return basic_hquantity<D, repr_type>(x.scale() + y.rescale(x.unit()).scale(), x.unit());
+        }
+
+        template <auto D, typename R1, typename R2>
+        constexpr auto
+        operator- (const basic_hquantity<D, R1> & x, const basic_hquantity<D, R2> & y)
+        {
+            using repr_type = std::common_type_t<R1, R2>;
+
+            return basic_hquantity<D, repr_type>(x.scale() - y.rescale(x.unit()).scale(), x.unit());
+        }
+
+        /** product;  unit is product of operand units,  so no rescale **/
+        template <auto D1, typename R1, auto D2, typename R2>
+        constexpr auto
+        operator* (const basic_hquantity<D1, R1> & x, const basic_hquantity<D2, R2> & y)
+        {
+            using repr_type = std::common_type_t<R1, R2>;
+            using result_type = hquantity<D1 * D2, repr_type>;
+            using hunit_type = typename result_type::hunit_type;
+
+            return result_type(x.scale() * y.scale(),
+                               hunit_type::from_native_factor(x.unit().native_factor()
+                                                              * y.unit().native_factor()));
+        }
+
+        /** quotient;  unit is quotient of operand units,  so no rescale **/
+        template <auto D1, typename R1, auto D2, typename R2>
+        constexpr auto
+        operator/ (const basic_hquantity<D1, R1> & x, const basic_hquantity<D2, R2> & y)
+        {
+            using repr_type = std::common_type_t<R1, R2>;
+            using result_type = hquantity<D1 / D2, repr_type>;
+            using hunit_type = typename result_type::hunit_type;
+
+            return result_type(x.scale() / y.scale(),
+                               hunit_type::from_native_factor(x.unit().native_factor()
+                                                              / y.unit().native_factor()));
+        }
+
+        template <auto D, typename R, typename Dimensionless>
+        requires std::is_arithmetic_v<Dimensionless>
+        constexpr auto
+        operator* (const basic_hquantity<D, R> & x, Dimensionless y)
+        {
+            using repr_type = std::common_type_t<R, Dimensionless>;
+
+            return basic_hquantity<D, repr_type>(x.scale() * y, x.unit());
+        }
+
+        template <auto D, typename R, typename Dimensionless>
+        requires std::is_arithmetic_v<Dimensionless>
+        constexpr auto
+        operator* (Dimensionless x, const basic_hquantity<D, R> & y)
+        {
+            return y * x;
+        }
+
+        template <auto D, typename R, typename Dimensionless>
+        requires std::is_arithmetic_v<Dimensionless>
+        constexpr auto
+        operator/ (const basic_hquantity<D, R> & x, Dimensionless y)
+        {
+            using repr_type = std::common_type_t<R, Dimensionless>;
+
+            return basic_hquantity<D, repr_type>(x.scale() / y, x.unit());
+        }
+
+        /** compare values;  no rescale when units agree **/
+        template <auto D, typename R1, typename R2>
+        constexpr bool
+        operator== (const basic_hquantity<D, R1> & x, const basic_hquantity<D, R2> & y)
+        {
+            if (x.unit().native_factor() == y.unit().native_factor())
+                return x.scale() == y.scale();
+
+            return x.native_scale() == y.native_scale();
+        }
+
+        template <auto D, typename R1, typename R2>
+        constexpr auto
+        operator<=> (const basic_hquantity<D, R1> & x, const basic_hquantity<D, R2> & y)
+        {
+            if (x.unit().native_factor() == y.unit().native_factor())
+                return x.scale() <=> y.scale();
+
+            return x.native_scale() <=> y.native_scale();
+        }
+
+        ///@}
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end hquantity.hpp **/
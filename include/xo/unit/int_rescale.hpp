@@ -0,0 +1,81 @@
+/** @file int_rescale.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <type_traits>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            /** @class int_rescale
+             *  @brief apply a runtime conversion factor to integer values,
+             *  rounding to nearest.
+             *
+             *  Whole-number factors (e.g. us -> ns) and their reciprocals (e.g. ns -> us)
+             *  are applied in integer arithmetic,  so values beyond 2^53
+             *  (e.g. epoch timestamps in ns) stay exact.
+             *  Any other factor goes through double.
+             **/
+            template <typename Int>
+            requires std::is_integral_v<Int>
+            class int_rescale {
+            public:
+                int_rescale() : int_rescale(1.0) {}
+                explicit int_rescale(double factor) : factor_{factor} {
+                    constexpr double c_max = static_cast<double>(std::numeric_limits<Int>::max());
+
+                    if (factor >= 1.0) {
+                        double m = ::round(factor);
+
+                        if ((m == factor) && (m < c_max))
+                            mult_ = static_cast<Int>(m);
+                    } else if (factor > 0.0) {
+                        double d = ::round(1.0 / factor);
+
+                        if ((::fabs(d * factor - 1.0) < 1e-12) && (d < c_max))
+                            div_ = static_cast<Int>(d);
+                    }
+                }
+
+                /** conversion factor **/
+                double factor() const { return factor_; }
+                /** true if conversion is exact in integer arithmetic **/
+                bool is_integral() const { return (mult_ != 0) || (div_ != 0); }
+
+                /** @p x times factor,  rounded to nearest (half away from zero) **/
+                Int operator()(Int x) const {
+                    if (mult_ != 0)
+                        return x * mult_;
+
+                    if (div_ != 0) {
+                        Int h = div_ / 2;
+
+                        return ((x >= 0) ? (x + h) : (x - h)) / div_;
+                    }
+
+                    return static_cast<Int>(::llround(factor_ * static_cast<double>(x)));
+                }
+
+                /** @p x times factor,  for a non-integer input @p x **/
+                Int from_double(double x) const {
+                    return static_cast<Int>(::llround(factor_ * x));
+                }
+
+            private:
+                /** conversion factor **/
+                double factor_ = 1.0;
+                /** factor,  when it's a whole number;  else 0 **/
+                Int mult_ = 0;
+                /** 1/factor,  when it's a whole number;  else 0 **/
+                Int div_ = 0;
+            };
+        } /*namespace detail*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end int_rescale.hpp **/
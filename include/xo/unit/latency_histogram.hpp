@@ -0,0 +1,352 @@
+/** @file latency_histogram.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "rescale_column.hpp"
+#include <atomic>
+#include <array>
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <cstdint>
+#include <cmath>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            namespace hdr {
+                /** log-linear bucketing of non-negative 64-bit integers.
+                 *
+                 *  Values below 2^SubBits get one bucket each (exact).
+                 *  Above that,  each power-of-two range [2^k, 2^(k+1)) is split into
+                 *  2^(SubBits-1) equal-width buckets,  so bucket width / value < 2^(1-SubBits).
+                 **/
+                template <unsigned SubBits>
+                struct layout {
+                    static_assert((SubBits >= 2) && (SubBits <= 16));
+
+                    static constexpr std::uint64_t c_sub = std::uint64_t(1) << SubBits;
+                    static constexpr std::uint64_t c_half = c_sub >> 1;
+                    static constexpr std::size_t n_bucket = c_sub + (64 - SubBits) * c_half;
+
+                    /** bucket index for value @p v **/
+                    static constexpr std::size_t index(std::uint64_t v) {
+                        if (v < c_sub)
+                            return v;
+
+                        unsigned shift = std::bit_width(v) - SubBits;
+
+                        return c_sub + (shift - 1) * c_half + ((v >> shift) - c_half);
+                    }
+
+                    /** smallest value in bucket @p i **/
+                    static constexpr std::uint64_t lo(std::size_t i) {
+                        if (i < c_sub)
+                            return i;
+
+                        std::size_t j = i - c_sub;
+                        unsigned shift = j / c_half + 1;
+
+                        return (c_half + j % c_half) << shift;
+                    }
+
+                    /** largest value in bucket @p i **/
+                    static constexpr std::uint64_t hi(std::size_t i) {
+                        if (i < c_sub)
+                            return i;
+
+                        unsigned shift = (i - c_sub) / c_half + 1;
+
+                        return lo(i) + ((std::uint64_t(1) << shift) - 1);
+                    }
+                };
+            } /*namespace hdr*/
+        } /*namespace detail*/
+
+        template <auto TimeUnit = u::nanosecond, unsigned SubBits = 8, std::size_t NShard = 8>
+        requires (NShard > 0)
+        class concurrent_latency_histogram;
+
+        /** @class latency_histogram
+         *  @brief high-dynamic-range histogram of time intervals.
+         *
+         *  Values are held as non-negative integer multiples of @p TimeUnit
+         *  (ticks),  in log-linear buckets with relative width below 2^(1-SubBits)
+         *  (0.8% for the default SubBits=8).  Fixed footprint;  no allocation.
+         *
+         *  @ref record accepts a quantity in any time unit;
+         *  conversion to @p TimeUnit uses a compile-time factor,
+         *  and a non-time quantity fails to compile.
+         *
+         *  Single-writer;  use @ref concurrent_latency_histogram
+         *  to record from several threads.
+         *
+         *  @code
+         *  latency_histogram<> h;   // nanosecond ticks
+         *
+         *  h.record(qty::microseconds(12.5));
+         *  h.record(qty::nanoseconds(800));
+         *
+         *  auto p99 = h.percentile(99.0);                      // quantity<u::nanosecond>
+         *  auto p50 = h.percentile<u::microsecond>(50.0);      // quantity<u::microsecond>
+         *  @endcode
+         **/
+        template <auto TimeUnit = u::nanosecond, unsigned SubBits = 8>
+        requires ((TimeUnit.n_bpu() == 1)
+                  && (TimeUnit.natural_unit_[0].native_dim() == dim::time)
+                  && (TimeUnit.natural_unit_[0].power() == power_ratio_type(1)))
+        class latency_histogram {
+        public:
+            using layout_type = detail::hdr::layout<SubBits>;
+            using tick_type = std::uint64_t;
+            using value_type = quantity<TimeUnit, double>;
+
+            static constexpr std::size_t n_bucket = layout_type::n_bucket;
+
+        public:
+            latency_histogram() { this->reset(); }
+
+            /** @defgroup latency-histogram-access-methods latency_histogram access methods **/
+            ///@{
+
+            /** number of recorded values **/
+            std::uint64_t n_sample() const { return n_sample_; }
+            /** count in bucket @p i **/
+            std::uint64_t bucket_count(std::size_t i) const { return count_v_[i]; }
+
+            /** smallest recorded value (exact) **/
+            template <auto Unit2 = TimeUnit, typename Repr = double>
+            quantity<Unit2, Repr> min() const {
+                return ticks_as<Unit2, Repr>((n_sample_ > 0) ? min_ : 0);
+            }
+
+            /** largest recorded value (exact) **/
+            template <auto Unit2 = TimeUnit, typename Repr = double>
+            quantity<Unit2, Repr> max() const {
+                return ticks_as<Unit2, Repr>(max_);
+            }
+
+            /** mean of recorded values (exact,  up to tick resolution) **/
+            template <auto Unit2 = TimeUnit, typename Repr = double>
+            quantity<Unit2, Repr> mean() const {
+                if (n_sample_ == 0)
+                    return quantity<Unit2, Repr>(0);
+
+                return quantity<Unit2, Repr>(static_cast<Repr>(rescale_factor<Unit2>()
+                                                               * (static_cast<double>(sum_)
+                                                                  / static_cast<double>(n_sample_))));
+            }
+
+            /** value at percentile @p pct (in [0, 100]).
+             *  Reports highest value equivalent to the selected bucket
+             *  (clamped to @ref max),  so never understates a latency.
+             **/
+            template <auto Unit2 = TimeUnit, typename Repr = double>
+            quantity<Unit2, Repr> percentile(double pct) const {
+                if (n_sample_ == 0)
+                    return quantity<Unit2, Repr>(0);
+
+                pct = std::min(100.0, std::max(0.0, pct));
+
+                /* rank of selected sample,  1-based */
+                std::uint64_t rank = static_cast<std::uint64_t>(std::ceil(pct / 100.0 * n_sample_));
+                rank = std::max<std::uint64_t>(rank, 1);
+
+                std::uint64_t cum = 0;
+
+                for (std::size_t i = 0; i < n_bucket; ++i) {
+                    cum += count_v_[i];
+
+                    if (cum >= rank)
+                        return ticks_as<Unit2, Repr>(std::min(layout_type::hi(i), max_));
+                }
+
+                return ticks_as<Unit2, Repr>(max_);
+            }
+
+            ///@}
+
+            /** @defgroup latency-histogram-general-methods latency_histogram general methods **/
+            ///@{
+
+            /** record interval @p dt (any time unit).  Negative intervals count as zero **/
+            template <typename Quantity>
+            requires (quantity_concept<Quantity> && Quantity::always_constexpr_unit)
+            void record(const Quantity & dt, std::uint64_t n = 1) {
+                this->record_ticks(to_ticks(dt), n);
+            }
+
+            /** record @p n occurrences of @p ticks (multiples of @p TimeUnit) **/
+            void record_ticks(tick_type ticks, std::uint64_t n = 1) {
+                count_v_[layout_type::index(ticks)] += n;
+                n_sample_ += n;
+                sum_ += ticks * n;
+                min_ = std::min(min_, ticks);
+                max_ = std::max(max_, ticks);
+            }
+
+            /** add counts from @p x into this histogram **/
+            void merge(const latency_histogram & x) {
+                for (std::size_t i = 0; i < n_bucket; ++i)
+                    count_v_[i] += x.count_v_[i];
+
+                n_sample_ += x.n_sample_;
+                sum_ += x.sum_;
+                min_ = std::min(min_, x.min_);
+                max_ = std::max(max_, x.max_);
+            }
+
+            void reset() {
+                count_v_.fill(0);
+                n_sample_ = 0;
+                sum_ = 0;
+                min_ = std::numeric_limits<tick_type>::max();
+                max_ = 0;
+            }
+
+            ///@}
+
+            /** convert @p dt to ticks,  using compile-time factor **/
+            template <typename Quantity>
+            static tick_type to_ticks(const Quantity & dt) {
+                auto x = detail::scale_in<TimeUnit, double>(dt);
+
+                return (x > 0.0) ? static_cast<tick_type>(x + 0.5) : 0;
+            }
+
+        private:
+            template <auto Unit2>
+            static constexpr double rescale_factor() {
+                return detail::rescale_factor<TimeUnit, Unit2, double>();
+            }
+
+            template <auto Unit2, typename Repr>
+            static quantity<Unit2, Repr> ticks_as(tick_type ticks) {
+                return quantity<Unit2, Repr>(static_cast<Repr>(rescale_factor<Unit2>()
+                                                               * static_cast<double>(ticks)));
+            }
+
+            template <auto T, unsigned S, std::size_t N>
+            requires (N > 0)
+            friend class concurrent_latency_histogram;
+
+        private:
+            /** count_v_[i]: number of recorded values in bucket i **/
+            std::array<std::uint64_t, n_bucket> count_v_;
+            /** number of recorded values **/
+            std::uint64_t n_sample_;
+            /** sum of recorded values,  in ticks **/
+            std::uint64_t sum_;
+            /** smallest recorded value,  in ticks **/
+            tick_type min_;
+            /** largest recorded value,  in ticks **/
+            tick_type max_;
+        };
+
+        /** @class concurrent_latency_histogram
+         *  @brief latency histogram recordable from many threads.
+         *
+         *  Holds @p NShard per-thread shards;  a thread is assigned a shard on first use
+         *  (round-robin).  @ref record is one relaxed @c fetch_add on a bucket
+         *  in the caller's shard,  plus one for the running sum:
+         *  no locks,  no retry loops.  With at most @p NShard recording threads,
+         *  each shard has a single writer and never sees contention.
+         *
+         *  @ref snapshot merges shards into a @ref latency_histogram for queries.
+         **/
+        template <auto TimeUnit, unsigned SubBits, std::size_t NShard>
+        requires (NShard > 0)
+        class concurrent_latency_histogram {
+        public:
+            using histogram_type = latency_histogram<TimeUnit, SubBits>;
+            using layout_type = typename histogram_type::layout_type;
+            using tick_type = typename histogram_type::tick_type;
+
+            static constexpr std::size_t n_bucket = histogram_type::n_bucket;
+            static constexpr std::size_t n_shard = NShard;
+
+        public:
+            concurrent_latency_histogram() = default;
+            concurrent_latency_histogram(const concurrent_latency_histogram &) = delete;
+            concurrent_latency_histogram & operator=(const concurrent_latency_histogram &) = delete;
+
+            /** @defgroup concurrent-latency-histogram-methods concurrent_latency_histogram methods **/
+            ///@{
+
+            /** record interval @p dt (any time unit) into calling thread's shard **/
+            template <typename Quantity>
+            requires (quantity_concept<Quantity> && Quantity::always_constexpr_unit)
+            void record(const Quantity & dt) {
+                this->record_ticks(histogram_type::to_ticks(dt));
+            }
+
+            /** record interval of @p ticks (multiples of @p TimeUnit) **/
+            void record_ticks(tick_type ticks) {
+                shard & s = shard_v_[this_shard()];
+
+                s.count_v_[layout_type::index(ticks)].fetch_add(1, std::memory_order_relaxed);
+                s.sum_.fetch_add(ticks, std::memory_order_relaxed);
+            }
+
+            /** merge all shards into a single histogram.
+             *  Concurrent records may or may not be included.
+             *  Min/max are reported to bucket resolution.
+             **/
+            histogram_type snapshot() const {
+                histogram_type retval;
+
+                for (const auto & s : shard_v_) {
+                    for (std::size_t i = 0; i < n_bucket; ++i)
+                        retval.count_v_[i] += s.count_v_[i].load(std::memory_order_relaxed);
+
+                    retval.sum_ += s.sum_.load(std::memory_order_relaxed);
+                }
+
+                for (std::size_t i = 0; i < n_bucket; ++i) {
+                    std::uint64_t n = retval.count_v_[i];
+
+                    if (n > 0) {
+                        if (retval.n_sample_ == 0)
+                            retval.min_ = layout_type::lo(i);
+                        retval.max_ = layout_type::hi(i);
+                        retval.n_sample_ += n;
+                    }
+                }
+
+                return retval;
+            }
+
+            /** reset all shards.  Records concurrent with reset may be lost **/
+            void reset() {
+                for (auto & s : shard_v_) {
+                    for (auto & c : s.count_v_)
+                        c.store(0, std::memory_order_relaxed);
+                    s.sum_.store(0, std::memory_order_relaxed);
+                }
+            }
+
+            ///@}
+
+        private:
+            struct alignas(64) shard {
+                std::array<std::atomic<std::uint64_t>, n_bucket> count_v_ = {};
+                std::atomic<std::uint64_t> sum_{0};
+            };
+
+            static std::size_t this_shard() {
+                static std::atomic<std::size_t> s_next{0};
+                thread_local std::size_t t_shard = s_next.fetch_add(1, std::memory_order_relaxed) % NShard;
+
+                return t_shard;
+            }
+
+        private:
+            std::array<shard, NShard> shard_v_;
+        };
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end latency_histogram.hpp **/
@@ -35,12 +35,15 @@ namespace xo {
             native_unit2_abbrev_type abbrev_str_;
         };
 
-        static constexpr native_unit native_unit2_v[n_dim] = {
+        inline constexpr native_unit native_unit2_v[n_dim] = {
             native_unit(dimension::mass,     native_unit2_abbrev_type::from_chars("g")),
             native_unit(dimension::distance, native_unit2_abbrev_type::from_chars("m")),
             native_unit(dimension::time,     native_unit2_abbrev_type::from_chars("s")),
             native_unit(dimension::currency, native_unit2_abbrev_type::from_chars("ccy")),
             native_unit(dimension::price,    native_unit2_abbrev_type::from_chars("px")),
+            native_unit(dimension::information, native_unit2_abbrev_type::from_chars("B")),
+            native_unit(dimension::packet,   native_unit2_abbrev_type::from_chars("pkt")),
+            native_unit(dimension::message,  native_unit2_abbrev_type::from_chars("msg")),
         };
 
     } /*namespace qty*/
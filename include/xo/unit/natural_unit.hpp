@@ -6,8 +6,13 @@
 #pragma once
 
 #include "bpu.hpp"
+#include "constexpr_math.hpp"
+#include <string_view>
+#include <charconv>
+#include <type_traits>
 #include <cmath>
 #include <cassert>
+#include <cstdint>
 
 namespace xo {
     namespace qty {
@@ -17,6 +22,21 @@ namespace xo {
         class natural_unit;
 
         namespace detail {
+            /** FNV-1a offset basis (64-bit) **/
+            inline constexpr std::uint64_t c_fnv1a_basis = 0xcbf29ce484222325ull;
+
+            /** fold 64-bit word @p x into FNV-1a hash @p h,  one byte at a time
+             *  (least significant first),  so result is independent of host byte order
+             **/
+            constexpr std::uint64_t
+            fnv1a_step(std::uint64_t h, std::uint64_t x) {
+                for (int i = 0; i < 8; ++i) {
+                    h = (h ^ (x & 0xff)) * 0x100000001b3ull;
+                    x >>= 8;
+                }
+                return h;
+            }
+
             template <typename Int, typename... Ts>
             constexpr void
             push_bpu_array(natural_unit<Int> * p_target, Ts... args);
@@ -132,6 +152,35 @@ namespace xo {
                 return retval;
             }
 
+            /** 64-bit fingerprint of this unit.
+             *
+             *  FNV-1a over (dimension, scalefactor, power) of each bpu,  in dimension order:
+             *  - equal units have equal fingerprints,  regardless of bpu order or @c Int;
+             *  - stable across builds and platforms,  so may be persisted or sent on the wire;
+             *  - constexpr,  so may be used as a switch label.
+             *
+             *  Distinct units may (very rarely) share a fingerprint:
+             *  confirm with @c operator== where it matters.
+             **/
+            constexpr std::uint64_t fingerprint() const {
+                std::uint64_t h = detail::c_fnv1a_basis;
+
+                for (std::size_t d = 0; d < n_dim; ++d) {
+                    bpu<Int> b = this->lookup_dim(static_cast<dimension>(d));
+
+                    if (b.power() == power_ratio_type(0))
+                        continue;
+
+                    h = detail::fnv1a_step(h, d);
+                    h = detail::fnv1a_step(h, static_cast<std::int64_t>(b.scalefactor().num()));
+                    h = detail::fnv1a_step(h, static_cast<std::int64_t>(b.scalefactor().den()));
+                    h = detail::fnv1a_step(h, static_cast<std::int64_t>(b.power().num()));
+                    h = detail::fnv1a_step(h, static_cast<std::int64_t>(b.power().den()));
+                }
+
+                return h;
+            }
+
             /** remove bpu at position @p p **/
             constexpr void remove_bpu(size_t p) {
                 for (std::size_t i = p; i+1 < n_bpu_; ++i)
@@ -240,6 +289,131 @@ namespace xo {
 
         ///@}
 
+        namespace detail {
+            /** parse signed decimal integer @p s.
+             *  Uses @c std::from_chars,  except in constant evaluation
+             *  (from_chars isn't constexpr until c++23).
+             *
+             *  @return false if malformed or outside int64 range
+             **/
+            constexpr bool
+            parse_int64(std::string_view s, std::int64_t * p_x)
+            {
+                /* from_chars accepts '-' but not '+' */
+                if (!s.empty() && (s.front() == '+')) {
+                    s.remove_prefix(1);
+
+                    if (!s.empty() && (s.front() == '-'))
+                        return false;
+                }
+
+                if (!std::is_constant_evaluated()) {
+                    const char * end = s.data() + s.size();
+                    auto [ptr, ec] = std::from_chars(s.data(), end, *p_x);
+
+                    return (ec == std::errc()) && (ptr == end);
+                }
+
+                bool neg = (!s.empty() && (s.front() == '-'));
+
+                if (neg)
+                    s.remove_prefix(1);
+
+                if (s.empty())
+                    return false;
+
+                /* accumulate negated,  so that int64 min is representable */
+                std::int64_t x = 0;
+
+                for (char c : s) {
+                    if ((c < '0') || (c > '9')
+                        || __builtin_mul_overflow(x, 10, &x)
+                        || __builtin_sub_overflow(x, c - '0', &x))
+                        return false;
+                }
+
+                if (!neg && __builtin_sub_overflow(0, x, &x))
+                    return false;
+
+                *p_x = x;
+                return true;
+            }
+
+            /** parse exponent suffix: @c "2", @c "-1", @c "(-1/2)", @c "-1/2" **/
+            constexpr bool
+            parse_power(std::string_view s, power_ratio_type * p_power)
+            {
+                if ((s.size() >= 2) && (s.front() == '(') && (s.back() == ')'))
+                    s = s.substr(1, s.size() - 2);
+
+                std::int64_t num = 0;
+                std::int64_t den = 1;
+
+                std::size_t slash = s.find('/');
+
+                if (slash == std::string_view::npos) {
+                    if (!parse_int64(s, &num))
+                        return false;
+                } else {
+                    if (!parse_int64(s.substr(0, slash), &num)
+                        || !parse_int64(s.substr(slash + 1), &den)
+                        || (den == 0))
+                        return false;
+                }
+
+                *p_power = power_ratio_type(num, den);
+                return true;
+            }
+        } /*namespace detail*/
+
+        /** @defgroup natural-unit-parse-functions natural-unit parsing **/
+        ///@{
+
+        /** recover natural unit from its abbreviation @p abbrev (see @ref natural_unit::abbrev),
+         *  e.g. @c "kg.m.s^-2" or @c "yr250^(-1/2)".
+         *  Empty string gives the dimensionless unit.
+         *
+         *  @return true and set @p *p_nu on success;
+         *          false for unknown basis unit,  malformed exponent,  or repeated dimension
+         **/
+        template <typename Int>
+        constexpr bool
+        natural_unit_from_abbrev(std::string_view abbrev, natural_unit<Int> * p_nu)
+        {
+            natural_unit<Int> nu;
+
+            while (!abbrev.empty()) {
+                std::size_t dot = abbrev.find('.');
+                std::string_view part = abbrev.substr(0, dot);
+
+                abbrev = ((dot == std::string_view::npos)
+                          ? std::string_view()
+                          : abbrev.substr(dot + 1));
+
+                std::size_t caret = part.find('^');
+                power_ratio_type power(1);
+
+                if ((caret != std::string_view::npos)
+                    && !detail::parse_power(part.substr(caret + 1), &power))
+                    return false;
+
+                basis_unit bu;
+
+                if (!bu_from_abbrev(part.substr(0, caret), &bu))
+                    return false;
+
+                if (nu.lookup_dim(bu.native_dim()).power() != power_ratio_type(0))
+                    return false;
+
+                nu.push_back(bpu<Int>(bu, power));
+            }
+
+            *p_nu = nu;
+            return true;
+        }
+
+        ///@}
+
         namespace detail {
             /**
              *  Given bpu ~ (b.u)^p:
@@ -262,7 +436,10 @@ namespace xo {
              *
              *  we'll compute:
              *  - (b/b')^p0 exactly (as a ratio)
-             *  - (b/b')^q inexactly (as a double)
+             *  - (b/b')^q = c.r^(1/n),  with q = k/n:
+             *    perfect n'th powers in (b/b')^k are extracted into c exactly (see @ref root_split);
+             *    c joins (b/b')^p0,  and [r^(1/n)]^2 is kept as a double.
+             *    All at compile time;  r=1 whenever (b/b')^q is rational.
              **/
 
             template <typename Int,
@@ -273,9 +450,9 @@ namespace xo {
                     : outer_scale_factor_{outer_scale_factor},
                       outer_scale_sq_{outer_scale_sq} {}
 
-                /* (b/b')^p0 */
+                /* (b/b')^p0.c */
                 OuterScale outer_scale_factor_;
-                /* (b/b')^q -- until c++26 only allow q=0 or q=1/2 */
+                /* [r^(1/n)]^2 */
                 double  outer_scale_sq_;
             };
 
@@ -292,9 +469,9 @@ namespace xo {
 
                 /* (b'.u)^p */
                 bpu<Int> bpu_rescaled_;
-                /* (b/b')^p0 */
+                /* (b/b')^p0.c */
                 OuterScale outer_scale_factor_;
-                /* [(b/b')^q]^2 -- until c++26 only allow q=0 or q=1/2 */
+                /* [r^(1/n)]^2 */
                 double  outer_scale_sq_;
             };
 
@@ -314,24 +491,34 @@ namespace xo {
                 /* inv: p_frac in (-1, 1) */
                 auto p_frac = orig.power().frac();
 
-                /* asof c++26: replace mult_sq with ::pow(mult, p_frac) */
-                double mult_sq = std::numeric_limits<double>::quiet_NaN();
-
-                /* pre-c++26 workaround */
-                {
-                    if (p_frac.den() == 1) {
-                        mult_sq = 1.0;
-                    } else if(p_frac.num() == 1 && p_frac.den() == 2) {
-                        mult_sq = mult.template convert_to<double>();
-                    } else if(p_frac.num() == -1 && p_frac.den() == 2) {
-                        mult_sq = 1.0 / mult.template convert_to<double>();
-                    } else {
-                        // remaining possibilities not supported until c++26
+                ratio::ratio<Int> mult_p = mult.power(orig.power().floor());
+                double mult_sq = 1.0;
+
+                if (p_frac.num() != 0) {
+                    /* mult^(k/n) = (a/b)^(k/n);  with k<0 use (b/a)^(-k/n) */
+                    bool neg = (p_frac.num() < 0);
+                    int k = static_cast<int>(neg ? -p_frac.num() : p_frac.num());
+                    int n = static_cast<int>(p_frac.den());
+
+                    root_split_result a = root_split(static_cast<std::uint64_t>(neg ? mult.den() : mult.num()), k, n);
+                    root_split_result b = root_split(static_cast<std::uint64_t>(neg ? mult.num() : mult.den()), k, n);
+
+                    /* exact part */
+                    mult_p = mult_p * ratio::ratio<Int>(static_cast<Int>(a.outer_), static_cast<Int>(b.outer_));
+
+                    /* remaining irrational part r^(1/n);  keep its square */
+                    double r = a.inner_ / b.inner_;
+
+                    if (r != 1.0) {
+                        if (n == 2)
+                            mult_sq = r;
+                        else if (n % 2 == 0)
+                            mult_sq = cx_root(r, n / 2);
+                        else
+                            mult_sq = cx_ipow(cx_root(r, n), 2);
                     }
                 }
 
-                ratio::ratio<Int> mult_p = mult.power(orig.power().floor());
-
                 return bpu2_rescale_result<Int, OuterScale>(bpu<Int>(orig.native_dim(),
                                                                      new_scalefactor,
                                                                      orig.power()),
@@ -348,6 +535,15 @@ namespace xo {
             {
                 assert(rhs_bpu_orig.native_dim() == p_target_bpu->native_dim());
 
+                if (rhs_bpu_orig.scalefactor() == p_target_bpu->scalefactor()) {
+                    /* common case (e.g. m.m, s^-1.s):  no rescale,  so skip ratio arithmetic */
+                    *p_target_bpu = bpu<Int>(p_target_bpu->native_dim(),
+                                             p_target_bpu->scalefactor(),
+                                             p_target_bpu->power() + rhs_bpu_orig.power());
+
+                    return outer_scalefactor_result<Int, OuterScale>(OuterScale(1), 1.0);
+                }
+
                 bpu2_rescale_result<Int, OuterScale> rhs_bpu_rr
                     = bpu2_rescale<Int, OuterScale>(rhs_bpu_orig,
                                                     p_target_bpu->scalefactor().template convert_to<OuterScale>());
@@ -369,6 +565,15 @@ namespace xo {
             {
                 assert(rhs_bpu_orig.native_dim() == p_target_bpu->native_dim());
 
+                if (rhs_bpu_orig.scalefactor() == p_target_bpu->scalefactor()) {
+                    /* common case (e.g. m/m, s^-1/s):  no rescale,  so skip ratio arithmetic */
+                    *p_target_bpu = bpu<Int>(p_target_bpu->native_dim(),
+                                             p_target_bpu->scalefactor(),
+                                             p_target_bpu->power() - rhs_bpu_orig.power());
+
+                    return outer_scalefactor_result<Int, OuterScale>(OuterScale(1), 1.0);
+                }
+
                 bpu2_rescale_result<Int, OuterScale> rhs_bpu_rr
                     = bpu2_rescale<Int, OuterScale>(rhs_bpu_orig,
                                                     p_target_bpu->scalefactor());
@@ -462,66 +667,95 @@ namespace xo {
          *  (see the 'u' namespace in 'scaled_unit.hpp')
          **/
         namespace nu {
-            constexpr auto dimensionless = natural_unit<std::int64_t>();
+            inline constexpr auto dimensionless = natural_unit<std::int64_t>();
 
             // ----- mass -----
 
-            constexpr auto picogram = natural_unit<std::int64_t>::from_bu(detail::bu::picogram);
-            constexpr auto nanogram = natural_unit<std::int64_t>::from_bu(detail::bu::nanogram);
-            constexpr auto microgram = natural_unit<std::int64_t>::from_bu(detail::bu::microgram);
-            constexpr auto milligram = natural_unit<std::int64_t>::from_bu(detail::bu::milligram);
-            constexpr auto gram = natural_unit<std::int64_t>::from_bu(detail::bu::gram);
-            constexpr auto kilogram = natural_unit<std::int64_t>::from_bu(detail::bu::kilogram);
-            constexpr auto tonne = natural_unit<std::int64_t>::from_bu(detail::bu::tonne);
-            constexpr auto kilotonne = natural_unit<std::int64_t>::from_bu(detail::bu::kilotonne);
-            constexpr auto megatonne = natural_unit<std::int64_t>::from_bu(detail::bu::megatonne);
-            constexpr auto gigatonne = natural_unit<std::int64_t>::from_bu(detail::bu::gigatonne);
+            inline constexpr auto picogram = natural_unit<std::int64_t>::from_bu(detail::bu::picogram);
+            inline constexpr auto nanogram = natural_unit<std::int64_t>::from_bu(detail::bu::nanogram);
+            inline constexpr auto microgram = natural_unit<std::int64_t>::from_bu(detail::bu::microgram);
+            inline constexpr auto milligram = natural_unit<std::int64_t>::from_bu(detail::bu::milligram);
+            inline constexpr auto gram = natural_unit<std::int64_t>::from_bu(detail::bu::gram);
+            inline constexpr auto kilogram = natural_unit<std::int64_t>::from_bu(detail::bu::kilogram);
+            inline constexpr auto tonne = natural_unit<std::int64_t>::from_bu(detail::bu::tonne);
+            inline constexpr auto kilotonne = natural_unit<std::int64_t>::from_bu(detail::bu::kilotonne);
+            inline constexpr auto megatonne = natural_unit<std::int64_t>::from_bu(detail::bu::megatonne);
+            inline constexpr auto gigatonne = natural_unit<std::int64_t>::from_bu(detail::bu::gigatonne);
 
             // ----- distance -----
 
-            constexpr auto picometer = natural_unit<std::int64_t>::from_bu(detail::bu::picometer);
-            constexpr auto nanometer = natural_unit<std::int64_t>::from_bu(detail::bu::nanometer);
-            constexpr auto micrometer = natural_unit<std::int64_t>::from_bu(detail::bu::micrometer);
-            constexpr auto millimeter = natural_unit<std::int64_t>::from_bu(detail::bu::millimeter);
-            constexpr auto meter = natural_unit<std::int64_t>::from_bu(detail::bu::meter);
-            constexpr auto kilometer = natural_unit<std::int64_t>::from_bu(detail::bu::kilometer);
-            constexpr auto megameter = natural_unit<std::int64_t>::from_bu(detail::bu::megameter);
-            constexpr auto gigameter = natural_unit<std::int64_t>::from_bu(detail::bu::gigameter);
-            constexpr auto lightsecond = natural_unit<std::int64_t>::from_bu(detail::bu::lightsecond);
-            constexpr auto astronomicalunit = natural_unit<std::int64_t>::from_bu(detail::bu::astronomicalunit);
-
-            constexpr auto inch = natural_unit<std::int64_t>::from_bu(detail::bu::inch);
-            constexpr auto foot = natural_unit<std::int64_t>::from_bu(detail::bu::foot);
-            constexpr auto yard = natural_unit<std::int64_t>::from_bu(detail::bu::yard);
-            constexpr auto mile = natural_unit<std::int64_t>::from_bu(detail::bu::mile);
+            inline constexpr auto picometer = natural_unit<std::int64_t>::from_bu(detail::bu::picometer);
+            inline constexpr auto nanometer = natural_unit<std::int64_t>::from_bu(detail::bu::nanometer);
+            inline constexpr auto micrometer = natural_unit<std::int64_t>::from_bu(detail::bu::micrometer);
+            inline constexpr auto millimeter = natural_unit<std::int64_t>::from_bu(detail::bu::millimeter);
+            inline constexpr auto meter = natural_unit<std::int64_t>::from_bu(detail::bu::meter);
+            inline constexpr auto kilometer = natural_unit<std::int64_t>::from_bu(detail::bu::kilometer);
+            inline constexpr auto megameter = natural_unit<std::int64_t>::from_bu(detail::bu::megameter);
+            inline constexpr auto gigameter = natural_unit<std::int64_t>::from_bu(detail::bu::gigameter);
+            inline constexpr auto lightsecond = natural_unit<std::int64_t>::from_bu(detail::bu::lightsecond);
+            inline constexpr auto astronomicalunit = natural_unit<std::int64_t>::from_bu(detail::bu::astronomicalunit);
+
+            inline constexpr auto inch = natural_unit<std::int64_t>::from_bu(detail::bu::inch);
+            inline constexpr auto foot = natural_unit<std::int64_t>::from_bu(detail::bu::foot);
+            inline constexpr auto yard = natural_unit<std::int64_t>::from_bu(detail::bu::yard);
+            inline constexpr auto mile = natural_unit<std::int64_t>::from_bu(detail::bu::mile);
 
             // ----- time -----
 
-            constexpr auto picosecond = natural_unit<std::int64_t>::from_bu(detail::bu::picosecond);
-            constexpr auto nanosecond = natural_unit<std::int64_t>::from_bu(detail::bu::nanosecond);
-            constexpr auto microsecond = natural_unit<std::int64_t>::from_bu(detail::bu::microsecond);
-            constexpr auto millisecond = natural_unit<std::int64_t>::from_bu(detail::bu::millisecond);
-            constexpr auto second = natural_unit<std::int64_t>::from_bu(detail::bu::second);
-            constexpr auto minute = natural_unit<std::int64_t>::from_bu(detail::bu::minute);
-            constexpr auto hour = natural_unit<std::int64_t>::from_bu(detail::bu::hour);
-            constexpr auto day = natural_unit<std::int64_t>::from_bu(detail::bu::day);
-            constexpr auto week = natural_unit<std::int64_t>::from_bu(detail::bu::week);
-            constexpr auto month = natural_unit<std::int64_t>::from_bu(detail::bu::month);
-            constexpr auto year = natural_unit<std::int64_t>::from_bu(detail::bu::year);
-            constexpr auto year250 = natural_unit<std::int64_t>::from_bu(detail::bu::year250);
-            constexpr auto year360 = natural_unit<std::int64_t>::from_bu(detail::bu::year360);
-            constexpr auto year365 = natural_unit<std::int64_t>::from_bu(detail::bu::year365);
-
-            constexpr auto currency = natural_unit<std::int64_t>::from_bu(detail::bu::currency);
-
-            constexpr auto price = natural_unit<std::int64_t>::from_bu(detail::bu::price);
-
-            constexpr auto volatility_30d = natural_unit<std::int64_t>::from_bu(detail::bu::month, power_ratio_type(-1,2));
-            constexpr auto volatility_250d = natural_unit<std::int64_t>::from_bu(detail::bu::year250, power_ratio_type(-1,2));
-            constexpr auto volatility_360d = natural_unit<std::int64_t>::from_bu(detail::bu::year360, power_ratio_type(-1,2));
-            constexpr auto volatility_365d = natural_unit<std::int64_t>::from_bu(detail::bu::year365, power_ratio_type(-1,2));
+            inline constexpr auto picosecond = natural_unit<std::int64_t>::from_bu(detail::bu::picosecond);
+            inline constexpr auto nanosecond = natural_unit<std::int64_t>::from_bu(detail::bu::nanosecond);
+            inline constexpr auto microsecond = natural_unit<std::int64_t>::from_bu(detail::bu::microsecond);
+            inline constexpr auto millisecond = natural_unit<std::int64_t>::from_bu(detail::bu::millisecond);
+            inline constexpr auto second = natural_unit<std::int64_t>::from_bu(detail::bu::second);
+            inline constexpr auto minute = natural_unit<std::int64_t>::from_bu(detail::bu::minute);
+            inline constexpr auto hour = natural_unit<std::int64_t>::from_bu(detail::bu::hour);
+            inline constexpr auto day = natural_unit<std::int64_t>::from_bu(detail::bu::day);
+            inline constexpr auto week = natural_unit<std::int64_t>::from_bu(detail::bu::week);
+            inline constexpr auto month = natural_unit<std::int64_t>::from_bu(detail::bu::month);
+            inline constexpr auto year = natural_unit<std::int64_t>::from_bu(detail::bu::year);
+            inline constexpr auto year250 = natural_unit<std::int64_t>::from_bu(detail::bu::year250);
+            inline constexpr auto year360 = natural_unit<std::int64_t>::from_bu(detail::bu::year360);
+            inline constexpr auto year365 = natural_unit<std::int64_t>::from_bu(detail::bu::year365);
+
+            inline constexpr auto currency = natural_unit<std::int64_t>::from_bu(detail::bu::currency);
+
+            inline constexpr auto price = natural_unit<std::int64_t>::from_bu(detail::bu::price);
+
+            inline constexpr auto bit = natural_unit<std::int64_t>::from_bu(detail::bu::bit);
+            inline constexpr auto byte = natural_unit<std::int64_t>::from_bu(detail::bu::byte);
+            inline constexpr auto kilobyte = natural_unit<std::int64_t>::from_bu(detail::bu::kilobyte);
+            inline constexpr auto megabyte = natural_unit<std::int64_t>::from_bu(detail::bu::megabyte);
+            inline constexpr auto gigabyte = natural_unit<std::int64_t>::from_bu(detail::bu::gigabyte);
+            inline constexpr auto terabyte = natural_unit<std::int64_t>::from_bu(detail::bu::terabyte);
+            inline constexpr auto kibibyte = natural_unit<std::int64_t>::from_bu(detail::bu::kibibyte);
+            inline constexpr auto mebibyte = natural_unit<std::int64_t>::from_bu(detail::bu::mebibyte);
+            inline constexpr auto gibibyte = natural_unit<std::int64_t>::from_bu(detail::bu::gibibyte);
+            inline constexpr auto tebibyte = natural_unit<std::int64_t>::from_bu(detail::bu::tebibyte);
+
+            inline constexpr auto packet = natural_unit<std::int64_t>::from_bu(detail::bu::packet);
+            inline constexpr auto message = natural_unit<std::int64_t>::from_bu(detail::bu::message);
+
+            inline constexpr auto volatility_30d = natural_unit<std::int64_t>::from_bu(detail::bu::month, power_ratio_type(-1,2));
+            inline constexpr auto volatility_250d = natural_unit<std::int64_t>::from_bu(detail::bu::year250, power_ratio_type(-1,2));
+            inline constexpr auto volatility_360d = natural_unit<std::int64_t>::from_bu(detail::bu::year360, power_ratio_type(-1,2));
+            inline constexpr auto volatility_365d = natural_unit<std::int64_t>::from_bu(detail::bu::year365, power_ratio_type(-1,2));
+
+            inline constexpr auto variance_30d = natural_unit<std::int64_t>::from_bu(detail::bu::month, power_ratio_type(-1));
+            inline constexpr auto variance_250d = natural_unit<std::int64_t>::from_bu(detail::bu::year250, power_ratio_type(-1));
+            inline constexpr auto variance_360d = natural_unit<std::int64_t>::from_bu(detail::bu::year360, power_ratio_type(-1));
+            inline constexpr auto variance_365d = natural_unit<std::int64_t>::from_bu(detail::bu::year365, power_ratio_type(-1));
         } /*namespace nu*/
     } /*namespace qty*/
 } /*namespace xo*/
 
+namespace std {
+    /** hash natural units by @c natural_unit::fingerprint **/
+    template <typename Int>
+    struct hash<xo::qty::natural_unit<Int>> {
+        std::size_t operator()(const xo::qty::natural_unit<Int> & x) const noexcept {
+            return static_cast<std::size_t>(x.fingerprint());
+        }
+    };
+} /*namespace std*/
+
 /** end natural_unit.hpp **/
@@ -9,6 +9,8 @@
 #include "natural_unit.hpp"
 #include "scaled_unit.hpp"
 #include "scaled_unit_concept.hpp"
+#include "constexpr_math.hpp"
+#include "unit_instrument_hook.hpp"
 
 namespace xo {
     namespace qty {
@@ -134,18 +136,24 @@ namespace xo {
             constexpr
             auto rescale() const {
                 /* conversion factor from .unit -> unit2*/
-                auto rr = detail::su_ratio<ratio_int_type,
-                                           ratio_int2x_type>(s_scaled_unit.natural_unit_,
-                                                             NaturalUnit2);
+                constexpr auto rr = detail::su_ratio_v<ratio_int_type,
+                                                       ratio_int2x_type,
+                                                       s_scaled_unit.natural_unit_,
+                                                       NaturalUnit2>;
 
                 if (rr.natural_unit_.is_dimensionless()) {
-                    repr_type r_scale = (((rr.outer_scale_sq_ == 1.0)
-                                          ? 1.0
-                                          : ::sqrt(rr.outer_scale_sq_))
+                    /* fractional-power factor,  evaluated at compile time */
+                    constexpr double c_root = ((rr.outer_scale_sq_ == 1.0)
+                                               ? 1.0
+                                               : detail::cx_sqrt(rr.outer_scale_sq_));
+
+                    repr_type r_scale = (c_root
                                          * rr.outer_scale_factor_.template convert_to<repr_type>()
                                          * this->scale_);
                     return quantity<NaturalUnit2, Repr>(r_scale);
                 } else {
+                        XO_UNIT_RECORD_HERE(instrument::op::dim_mismatch, std::numeric_limits<double>::quiet_NaN());
+
                         return quantity<NaturalUnit2, Repr>(std::numeric_limits<repr_type>::quiet_NaN());
                 }
             }
@@ -157,27 +165,32 @@ namespace xo {
             constexpr
             auto rescale_ext() const {
                 /* conversion factor from .unit -> unit2*/
-                auto rr = detail::su_ratio<ratio_int_type,
-                                           ratio_int2x_type>(s_scaled_unit.natural_unit_,
-                                                             ScaledUnit2.natural_unit_);
+                constexpr auto rr = detail::su_ratio_v<ratio_int_type,
+                                                       ratio_int2x_type,
+                                                       s_scaled_unit.natural_unit_,
+                                                       ScaledUnit2.natural_unit_>;
 
                 if (rr.natural_unit_.is_dimensionless()) {
-                    /* NOTE: test for unit .outer_scale_sq values to get constexpr result with c++23
-                     *       and integer dimension powers.
+                    /* NOTE: conversion factor,  including fractional-power terms,
+                     *       is a compile-time constant.
                      *
                      * NOTE: we don't intend to support mixed-unit quantities.
                      *       If we change intention, will need to take into account
                      *       (s_scaled_unit.outer_scale_factor_, s_scaled_unit.outer_scale_sq_)
                      */
-                    repr_type r_scale = ((((rr.outer_scale_sq_ == 1.0)
-                                           && (ScaledUnit2.outer_scale_sq_ == 1.0))
-                                          ? 1.0
-                                          : ::sqrt(rr.outer_scale_sq_ / ScaledUnit2.outer_scale_sq_))
-                                       * rr.outer_scale_factor_.template convert_to<repr_type>()
+                    constexpr double c_root = (((rr.outer_scale_sq_ == 1.0)
+                                                && (ScaledUnit2.outer_scale_sq_ == 1.0))
+                                               ? 1.0
+                                               : detail::cx_sqrt(rr.outer_scale_sq_ / ScaledUnit2.outer_scale_sq_));
+
+                    repr_type r_scale = (c_root
+                                         * rr.outer_scale_factor_.template convert_to<repr_type>()
                                          * this->scale_
                                          / ScaledUnit2.outer_scale_factor_.template convert_to<repr_type>());
                     return quantity<ScaledUnit2, Repr>(r_scale);
                 } else {
+                    XO_UNIT_RECORD_HERE(instrument::op::dim_mismatch, std::numeric_limits<double>::quiet_NaN());
+
                     return quantity<ScaledUnit2, Repr>(std::numeric_limits<repr_type>::quiet_NaN());
                 }
             }
@@ -292,11 +305,10 @@ namespace xo {
             /** @defgroup quantity-assignment quantity assignment operators **/
             ///@{
 
-            /** assignment from quantity with identical units **/
-            quantity & operator=(const quantity & x) {
-                this->scale_ = x.scale_;
-                return *this;
-            }
+            /** assignment from quantity with identical units.
+             *  Defaulted,  so that quantity is trivially copyable
+             **/
+            quantity & operator=(const quantity & x) = default;
 
             /** assignment from quantity with compatible units **/
             template <typename Q2>
@@ -389,12 +401,16 @@ namespace xo {
                     using r_int2x_type = std::common_type_t<typename Q1::ratio_int2x_type,
                                                             typename Q2::ratio_int2x_type>;
 
-                    constexpr auto rr = detail::su_product<r_int_type, r_int2x_type>(x.unit().natural_unit_,
-                                                                                     y.unit().natural_unit_);
+                    constexpr auto rr = detail::su_product_v<r_int_type, r_int2x_type,
+                                                             Q1::s_scaled_unit.natural_unit_,
+                                                             Q2::s_scaled_unit.natural_unit_>;
 
-                    r_repr_type r_scale = (((rr.outer_scale_sq_ == 1.0)
-                                            ? 1.0
-                                            : ::sqrt(rr.outer_scale_sq_))
+                    /* fractional-power factor,  evaluated at compile time */
+                    constexpr double c_root = ((rr.outer_scale_sq_ == 1.0)
+                                               ? 1.0
+                                               : detail::cx_sqrt(rr.outer_scale_sq_));
+
+                    r_repr_type r_scale = (c_root
                                            * rr.outer_scale_factor_.template convert_to<r_repr_type>()
                                            * static_cast<r_repr_type>(x.scale())
                                            * static_cast<r_repr_type>(y.scale()));
@@ -416,12 +432,16 @@ namespace xo {
                     using r_int2x_type = std::common_type_t<typename Q1::ratio_int2x_type,
                                                             typename Q2::ratio_int2x_type>;
 
-                    constexpr auto rr = detail::su_ratio<r_int_type, r_int2x_type>(x.unit().natural_unit_,
-                                                                                   y.unit().natural_unit_);
+                    constexpr auto rr = detail::su_ratio_v<r_int_type, r_int2x_type,
+                                                           Q1::s_scaled_unit.natural_unit_,
+                                                           Q2::s_scaled_unit.natural_unit_>;
+
+                    /* fractional-power factor,  evaluated at compile time */
+                    constexpr double c_root = ((rr.outer_scale_sq_ == 1.0)
+                                               ? 1.0
+                                               : detail::cx_sqrt(rr.outer_scale_sq_));
 
-                    r_repr_type r_scale = (((rr.outer_scale_sq_ == 1.0)
-                                            ? 1.0
-                                            : ::sqrt(rr.outer_scale_sq_))
+                    r_repr_type r_scale = (c_root
                                            * rr.outer_scale_factor_.template convert_to<r_repr_type>()
                                            * static_cast<r_repr_type>(x.scale())
                                            / static_cast<r_repr_type>(y.scale()));
@@ -443,18 +463,25 @@ namespace xo {
                     using r_int2x_type = std::common_type_t<typename Q1::ratio_int2x_type,
                                                             typename Q2::ratio_int2x_type>;
                     /* conversion to get y in same units as x: multiply by y/x */
-                    auto rr = detail::su_ratio<r_int_type, r_int2x_type>(y.unit().natural_unit_,
-                                                                         x.unit().natural_unit_);
+                    constexpr auto rr = detail::su_ratio_v<r_int_type, r_int2x_type,
+                                                           Q2::s_scaled_unit.natural_unit_,
+                                                           Q1::s_scaled_unit.natural_unit_>;
 
                     if (rr.natural_unit_.is_dimensionless()) {
+                        constexpr double c_root = ((rr.outer_scale_sq_ == 1.0)
+                                                   ? 1.0
+                                                   : detail::cx_sqrt(rr.outer_scale_sq_));
+
                         r_repr_type r_scale = (static_cast<r_repr_type>(x.scale())
-                                               + (::sqrt(rr.outer_scale_sq_)
+                                               + (c_root
                                                   * rr.outer_scale_factor_.template convert_to<r_repr_type>()
                                                   * static_cast<r_repr_type>(y.scale())));
 
                         return quantity<x.s_scaled_unit, r_repr_type>(r_scale);
                     } else {
                         /* units don't match! */
+                        XO_UNIT_RECORD_HERE(instrument::op::dim_mismatch, std::numeric_limits<double>::quiet_NaN());
+
                         return quantity<x.s_scaled_unit, r_repr_type>(std::numeric_limits<r_repr_type>::quiet_NaN());
                     }
                 }
@@ -472,18 +499,26 @@ namespace xo {
                     using r_int2x_type = std::common_type_t<typename Q1::ratio_int2x_type,
                                                             typename Q2::ratio_int2x_type>;
                     /* conversion to get y in same units as x: multiply by y/x */
-                    auto rr = detail::su_ratio<r_int_type, r_int2x_type>(y.unit(), x.unit());
+                    constexpr auto rr = detail::su_ratio_v<r_int_type, r_int2x_type,
+                                                           Q2::s_scaled_unit.natural_unit_,
+                                                           Q1::s_scaled_unit.natural_unit_>;
 
                     if (rr.natural_unit_.is_dimensionless()) {
+                        constexpr double c_root = ((rr.outer_scale_sq_ == 1.0)
+                                                   ? 1.0
+                                                   : detail::cx_sqrt(rr.outer_scale_sq_));
+
                         r_repr_type r_scale = (static_cast<r_repr_type>(x.scale())
-                                               - (::sqrt(rr.outer_scale_sq_)
+                                               - (c_root
                                                   * rr.outer_scale_factor_.template convert_to<r_repr_type>()
                                                   * static_cast<r_repr_type>(y.scale())));
 
-                        return quantity<x.s_unit, r_repr_type>(r_scale);
+                        return quantity<Q1::s_scaled_unit, r_repr_type>(r_scale);
                     } else {
                         /* units don't match! */
-                        return quantity<x.s_unit, r_repr_type>(std::numeric_limits<r_repr_type>::quiet_NaN());
+                        XO_UNIT_RECORD_HERE(instrument::op::dim_mismatch, std::numeric_limits<double>::quiet_NaN());
+
+                        return quantity<Q1::s_scaled_unit, r_repr_type>(std::numeric_limits<r_repr_type>::quiet_NaN());
                     }
                 }
             };
@@ -517,10 +552,31 @@ namespace xo {
             return x.template with_repr<Repr2>();
         }
 
+        /** @p x in unit @p Unit with representation @p Repr2.
+         *
+         *  Rescales in double,  then rounds to nearest (half away from zero)
+         *  if @p Repr2 is integral.  By contrast @c with_repr<Repr2>() followed by
+         *  @c rescale_ext<Unit>() truncates @p x before rescaling,
+         *  e.g. 1.5us -> 1us -> 1000ns.
+         **/
+        template <auto Unit, typename Repr2, typename Q1>
+        requires (quantity_concept<Q1>
+                  && Q1::always_constexpr_unit)
+        constexpr quantity<Unit, Repr2>
+        rescale_rounded(const Q1 & x)
+        {
+            double r = x.template with_repr<double>().template rescale_ext<Unit>().scale();
+
+            if constexpr (std::is_integral_v<Repr2>)
+                return quantity<Unit, Repr2>(static_cast<Repr2>((r < 0.0) ? r - 0.5 : r + 0.5));
+            else
+                return quantity<Unit, Repr2>(static_cast<Repr2>(r));
+        }
+
         /** @addtogroup quantity-operators **/
         ///@{
 
-        /** note: won't have constexpr result w/ fractional dimension until c++26 (when @c sqrt(), @c pow() are constexpr)
+        /** note: constexpr,  including fractional dimension (conversion factor computed at compile time)
          **/
         template <typename Q1, typename Q2>
         requires (quantity_concept<Q1>
@@ -553,7 +609,7 @@ namespace xo {
 
         /** divide quantity @p x by quantity @p y.
          *
-         *  note: won't have constexpr result w/ fractional dimension until c++26 (when @c sqrt(), @c pow() are constexpr)
+         *  note: constexpr,  including fractional dimension (conversion factor computed at compile time)
          **/
         template <typename Q1, typename Q2>
         requires (quantity_concept<Q1>
@@ -587,7 +643,7 @@ namespace xo {
         /** add quantity @p y to quantity @p x.  Result will have the same units as @p x.
          *  Representation will be the widest of {@c x::repr_type, @c y::repr_type}.
          *
-         *  note: won't have constexpr result w/ fractional dimension until c++26 (when @c sqrt(), @c pow() are constexpr)
+         *  note: constexpr,  including fractional dimension (conversion factor computed at compile time)
          *
          *  @pre @p x and @p y expected to have consistent dimensions
          **/
@@ -639,7 +695,7 @@ namespace xo {
         /** subtract quantity @p y from quantity @p x.  Result will have the same units as @p x.
          *  Representation will be the widest of {@c x::repr_type, @c y::repr_type}
          *
-         *  note: won't have constexpr result w/ fractional dimension until c++26 (when @c sqrt(), @c pow() are constexpr)
+         *  note: constexpr,  including fractional dimension (conversion factor computed at compile time)
          *
          *  @pre @p x and @p y expected to have consistent dimensions
          **/
@@ -738,25 +794,25 @@ namespace xo {
             // ----- mass constants ----
 
             /** a quantity representing 1 picogram of mass, with compile-time unit representation **/
-            static constexpr auto picogram = picograms(1);
+            inline constexpr auto picogram = picograms(1);
             /** a quantity representing 1 nanogram of mass, with compile-time unit representation **/
-            static constexpr auto nanogram = nanograms(1);
+            inline constexpr auto nanogram = nanograms(1);
             /** a quantity representing 1 microgram of mass, with compile-time unit representation **/
-            static constexpr auto microgram = micrograms(1);
+            inline constexpr auto microgram = micrograms(1);
             /** a quantity representing 1 milligram of mass, with compile-time unit representation **/
-            static constexpr auto milligram = milligrams(1);
+            inline constexpr auto milligram = milligrams(1);
             /** a quantity representing 1 gram of mass, with compile-time unit representation **/
-            static constexpr auto gram = grams(1);
+            inline constexpr auto gram = grams(1);
             /** a quantity representing 1 kilogram of mass, with compile-time unit representation **/
-            static constexpr auto kilogram = kilograms(1);
+            inline constexpr auto kilogram = kilograms(1);
             /** a quantity representing 1 metric tonne of mass, with compile-time unit representation **/
-            static constexpr auto tonne = tonnes(1);
+            inline constexpr auto tonne = tonnes(1);
             /** a quantity representing 1 metric kilotonne of mass, with compile-time unit representation **/
-            static constexpr auto kilotonne = kilotonnes(1);
+            inline constexpr auto kilotonne = kilotonnes(1);
             /** a quantity representing 1 metric megatonne of mass, with compile-time unit representation **/
-            static constexpr auto megatonne = megatonnes(1);
+            inline constexpr auto megatonne = megatonnes(1);
             /** a quantity representing 1 metric gigatonne of mass, with compile-time unit representation **/
-            static constexpr auto gigatonne = gigatonnes(1);
+            inline constexpr auto gigatonne = gigatonnes(1);
         } /*namespace qty*/
 
         namespace qty {
@@ -826,42 +882,42 @@ namespace xo {
             // ----- distance constants -----
 
             /** a quantity representing 1 picometer of distance, with compile-time unit representation **/
-            static constexpr auto picometer = picometers(1);
+            inline constexpr auto picometer = picometers(1);
             /** a quantity representing 1 nanometer of distance, with compile-time unit representation **/
-            static constexpr auto nanometer = nanometers(1);
+            inline constexpr auto nanometer = nanometers(1);
             /** a quantity representing 1 micrometer of distance, with compile-time unit representation **/
-            static constexpr auto micrometer = micrometers(1);
+            inline constexpr auto micrometer = micrometers(1);
             /** a quantity representing 1 millimeter of distance, with compile-time unit representation **/
-            static constexpr auto millimeter = millimeters(1);
+            inline constexpr auto millimeter = millimeters(1);
             /** a quantity representing 1 meter of distance, with compile-time unit representation **/
-            static constexpr auto meter = meters(1);
+            inline constexpr auto meter = meters(1);
             /** a quantity representing 1 kilometer of distance, with compile-time unit representation **/
-            static constexpr auto kilometer = kilometers(1);
+            inline constexpr auto kilometer = kilometers(1);
             /** a quantity representing 1 megameter of distance, with compile-time unit representation **/
-            static constexpr auto megameter = megameters(1);
+            inline constexpr auto megameter = megameters(1);
             /** a quantity representing 1 gigameter of distance, with compile-time unit representation **/
-            static constexpr auto gigameter = gigameters(1);
+            inline constexpr auto gigameter = gigameters(1);
 
             /** a quantity representing exactly 1 lightsecond of distance,
              *  with compile-time unit representation
              **/
-            static constexpr auto lightsecond = lightseconds(1);
+            inline constexpr auto lightsecond = lightseconds(1);
             /** a quantity representing exactly 1 astronomical unit of distance,
              *  with compile-time unit representation
              **/
-            static constexpr auto astronomicalunit = astronomicalunits(1);
+            inline constexpr auto astronomicalunit = astronomicalunits(1);
 
             /** a quantity representing 1 inch of distance, with compile-time unit operations **/
-            static constexpr auto inch = inches(1);
+            inline constexpr auto inch = inches(1);
 
             /** a quantity representing 1 foot of distance, with compile-time unit operations **/
-            static constexpr auto foot = feet(1);
+            inline constexpr auto foot = feet(1);
 
             /** a quantity representing 1 yard of distance, with compile-time unit operations **/
-            static constexpr auto yard = yards(1);
+            inline constexpr auto yard = yards(1);
 
             /** a quantity representing 1 mile of distance, with compile-time unit operations **/
-            static constexpr auto mile = miles(1);
+            inline constexpr auto mile = miles(1);
         } /*namespace qty*/
 
         namespace qty {
@@ -936,46 +992,46 @@ namespace xo {
             // ----- time constants ----
 
             /** a quantity representing 1 picosecond of time, with compile-time unit representation **/
-            static constexpr auto picosecond = picoseconds(1);
+            inline constexpr auto picosecond = picoseconds(1);
 
             /** a quantity representing 1 nanosecond of time, with compile-time unit representation **/
-            static constexpr auto nanosecond = nanoseconds(1);
+            inline constexpr auto nanosecond = nanoseconds(1);
 
             /** a quantity representing 1 microsecond of time, with compile-time unit representation **/
-            static constexpr auto microsecond = microseconds(1);
+            inline constexpr auto microsecond = microseconds(1);
 
             /** a quantity representing 1 millisecond of time, with compile-time unit representation **/
-            static constexpr auto millisecond = milliseconds(1);
+            inline constexpr auto millisecond = milliseconds(1);
 
             /** a quantity representing 1 second of time, with compile-time unit representation **/
-            static constexpr auto second = seconds(1);
+            inline constexpr auto second = seconds(1);
 
             /** a quantity representing 1 minute of time, with compile-time unit representation **/
-            static constexpr auto minute = minutes(1);
+            inline constexpr auto minute = minutes(1);
 
             /** a quantity representing 1 hour of time, with compile-time unit representation **/
-            static constexpr auto hour = hours(1);
+            inline constexpr auto hour = hours(1);
 
             /** a quantity representing 1 day of time (exactly 24 hours), with compile-time unit representation **/
-            static constexpr auto day = days(1);
+            inline constexpr auto day = days(1);
 
             /** a quantity representing 1 week of time (7 24-hour days), with compile-time unit representation **/
-            static constexpr auto week = weeks(1);
+            inline constexpr auto week = weeks(1);
 
             /** a quantity representing 1 month of time (30 24-hour days), with compile-time unit representation **/
-            static constexpr auto month = months(1);
+            inline constexpr auto month = months(1);
 
             /** a quantity representing 1 year of time (365.25 24-hour days), with compile-time unit representation **/
-            static constexpr auto year = years(1);
+            inline constexpr auto year = years(1);
 
             /** a quantity representing 1 250-day year of time, with compile-time unit representation **/
-            static constexpr auto year250 = year250s(1);
+            inline constexpr auto year250 = year250s(1);
 
             /** a quantity representing 1 360-day year of time, with compile-time unit representation **/
-            static constexpr auto year360 = year360s(1);
+            inline constexpr auto year360 = year360s(1);
 
             /** a quantity representing 1 365-day year of time, with compile-time unit representation **/
-            static constexpr auto year365 = year365s(1);
+            inline constexpr auto year365 = year365s(1);
 
         } /*namespace qty*/
 
@@ -987,6 +1043,62 @@ namespace xo {
             inline constexpr auto currency(Repr x) { return quantity<u::currency, Repr>(x); }
         }
 
+        namespace qty {
+            // ----- information -----
+
+            /** create quantity representing @p x bits of information, with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto bits(Repr x) { return quantity<u::bit, Repr>(x); }
+
+            /** create quantity representing @p x bytes of information, with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto bytes(Repr x) { return quantity<u::byte, Repr>(x); }
+
+            /** create quantity representing @p x kilobytes (10^3 bytes), with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto kilobytes(Repr x) { return quantity<u::kilobyte, Repr>(x); }
+
+            /** create quantity representing @p x megabytes (10^6 bytes), with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto megabytes(Repr x) { return quantity<u::megabyte, Repr>(x); }
+
+            /** create quantity representing @p x gigabytes (10^9 bytes), with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto gigabytes(Repr x) { return quantity<u::gigabyte, Repr>(x); }
+
+            /** create quantity representing @p x terabytes (10^12 bytes), with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto terabytes(Repr x) { return quantity<u::terabyte, Repr>(x); }
+
+            /** create quantity representing @p x kibibytes (2^10 bytes), with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto kibibytes(Repr x) { return quantity<u::kibibyte, Repr>(x); }
+
+            /** create quantity representing @p x mebibytes (2^20 bytes), with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto mebibytes(Repr x) { return quantity<u::mebibyte, Repr>(x); }
+
+            /** create quantity representing @p x gibibytes (2^30 bytes), with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto gibibytes(Repr x) { return quantity<u::gibibyte, Repr>(x); }
+
+            /** create quantity representing @p x tebibytes (2^40 bytes), with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto tebibytes(Repr x) { return quantity<u::tebibyte, Repr>(x); }
+        }
+
+        namespace qty {
+            // ----- packet, message -----
+
+            /** create quantity representing @p x network packets, with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto packets(Repr x) { return quantity<u::packet, Repr>(x); }
+
+            /** create quantity representing @p x application messages, with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto messages(Repr x) { return quantity<u::message, Repr>(x); }
+        }
+
         namespace qty {
             // ----- volatility -----
 
@@ -1011,6 +1123,26 @@ namespace xo {
             inline constexpr auto volatility_365d(Repr x) { return quantity<u::volatility_365d, Repr>(x); }
         } /*namespace qty*/
 
+        namespace qty {
+            // ----- variance -----
+
+            /** create quantity representing @p x units of 30-day variance, with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto variance_30d(Repr x) { return quantity<u::variance_30d, Repr>(x); }
+
+            /** create quantity representing @p x units of 250-day variance, with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto variance_250d(Repr x) { return quantity<u::variance_250d, Repr>(x); }
+
+            /** create quantity representing @p x units of 360-day variance, with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto variance_360d(Repr x) { return quantity<u::variance_360d, Repr>(x); }
+
+            /** create quantity representing @p x units of 365-day variance, with compile-time unit representation **/
+            template <typename Repr>
+            inline constexpr auto variance_365d(Repr x) { return quantity<u::variance_365d, Repr>(x); }
+        } /*namespace qty*/
+
         /* reminder: see [quantity_ops.hpp] for operator* etc */
     } /*namespace qty*/
 } /*namespace xo*/
@@ -0,0 +1,369 @@
+/** @file quantity_expr.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "rescale_column.hpp"
+#include <span>
+#include <vector>
+#include <algorithm>
+#include <type_traits>
+
+namespace xo {
+    namespace qty {
+        /** @defgroup quantity-expr quantity expression templates
+         *
+         *  Lazy arithmetic on quantities with compile-time units.
+         *
+         *  Pairwise evaluation of an expression like @c d/(t1*t2)+a
+         *  materializes an intermediate quantity at each step,
+         *  each with its own unit-conversion multiply.
+         *  An expression-template node instead carries,  at compile time,
+         *  its result unit and one combined conversion factor;
+         *  at runtime it combines raw scales only.
+         *  Evaluation applies the combined factor once
+         *  (along with any conversion to a requested result unit).
+         *
+         *  Each mixed-unit @c + or @c - still costs one multiply
+         *  (to bring the right operand onto the left operand's scale);
+         *  @c * and @c / cost none.
+         *
+         *  @code
+         *  auto e = lazy(d) / (lazy(t1) * lazy(t2)) + lazy(a);
+         *
+         *  auto q = e.eval();                          // result in unit of lazy(d)/(t1*t2)
+         *  auto q2 = e.eval_as<u::meter / (u::second * u::second)>();
+         *
+         *  // columns: one fused loop,  one multiply per element for unit work
+         *  eval_column(lazy_column(d_v) / (lazy_column(t_v) * lazy_column(t_v)),
+         *              std::span(out_v));
+         *  @endcode
+         *
+         *  Results agree with pairwise evaluation up to floating-point rounding.
+         *  Adding quantities with different dimensions fails to compile.
+         **/
+        ///@{
+
+        /** true for expression-template nodes **/
+        template <typename E>
+        concept quantity_expr_concept = requires { typename E::quantity_expr_tag; };
+
+        /** valid operand for an expression-template operator **/
+        template <typename T>
+        concept quantity_expr_operand = (quantity_expr_concept<T>
+                                         || (quantity_concept<T> && T::always_constexpr_unit)
+                                         || std::is_arithmetic_v<T>);
+
+        namespace detail {
+            namespace qexpr {
+                /** combined multiplier from su_product / su_ratio result @p rr **/
+                template <typename ScaledUnit>
+                constexpr double outer_factor(const ScaledUnit & rr) {
+                    return (((rr.outer_scale_sq_ == 1.0)
+                             ? 1.0
+                             : cx_sqrt(rr.outer_scale_sq_))
+                            * rr.outer_scale_factor_.template convert_to<double>());
+                }
+
+                struct op_multiply {};
+                struct op_divide {};
+                struct op_add {};
+                struct op_subtract {};
+            } /*namespace qexpr*/
+        } /*namespace detail*/
+
+        /** @class quantity_expr_leaf
+         *  @brief expression-template leaf holding a single quantity (by value)
+         **/
+        template <typename Quantity>
+        class quantity_expr_leaf {
+        public:
+            using quantity_expr_tag = void;
+            using repr_type = typename Quantity::repr_type;
+            using ratio_int_type = typename Quantity::ratio_int_type;
+
+            /** unit of @ref raw **/
+            static constexpr auto s_scaled_unit = Quantity::s_scaled_unit;
+            /** value = s_factor * raw,  in s_scaled_unit **/
+            static constexpr double s_factor = 1.0;
+
+        public:
+            constexpr explicit quantity_expr_leaf(const Quantity & x) : x_{x} {}
+
+            /** 0: broadcast to any length **/
+            constexpr std::size_t size() const { return 0; }
+            constexpr repr_type raw(std::size_t) const { return x_.scale(); }
+
+        private:
+            Quantity x_;
+        };
+
+        /** @class quantity_expr_column
+         *  @brief expression-template leaf referring to a column of quantities
+         **/
+        template <typename Quantity>
+        class quantity_expr_column {
+        public:
+            using quantity_expr_tag = void;
+            using repr_type = typename Quantity::repr_type;
+            using ratio_int_type = typename Quantity::ratio_int_type;
+
+            static constexpr auto s_scaled_unit = Quantity::s_scaled_unit;
+            static constexpr double s_factor = 1.0;
+
+        public:
+            constexpr explicit quantity_expr_column(std::span<const Quantity> v) : v_{v} {}
+
+            constexpr std::size_t size() const { return v_.size(); }
+            constexpr repr_type raw(std::size_t i) const { return v_[i].scale(); }
+
+        private:
+            std::span<const Quantity> v_;
+        };
+
+        /** @class quantity_expr_scalar
+         *  @brief expression-template leaf holding a dimensionless number
+         **/
+        template <typename Repr>
+        class quantity_expr_scalar {
+        public:
+            using quantity_expr_tag = void;
+            using repr_type = Repr;
+            using ratio_int_type = std::int64_t;
+
+            static constexpr auto s_scaled_unit = u::dimensionless;
+            static constexpr double s_factor = 1.0;
+
+        public:
+            constexpr explicit quantity_expr_scalar(Repr x) : x_{x} {}
+
+            constexpr std::size_t size() const { return 0; }
+            constexpr repr_type raw(std::size_t) const { return x_; }
+
+        private:
+            Repr x_;
+        };
+
+        /** @class quantity_expr_node
+         *  @brief expression-template node applying binary @p Op to @p Lhs, @p Rhs.
+         *
+         *  Result unit and factor follow @c quantity multiply/divide/add/subtract:
+         *  product and quotient units come from @c su_product / @c su_ratio;
+         *  sum and difference take the left operand's unit.
+         **/
+        template <typename Op, typename Lhs, typename Rhs>
+        class quantity_expr_node {
+        public:
+            using quantity_expr_tag = void;
+            using repr_type = std::common_type_t<typename Lhs::repr_type,
+                                                 typename Rhs::repr_type>;
+            using ratio_int_type = std::common_type_t<typename Lhs::ratio_int_type,
+                                                      typename Rhs::ratio_int_type>;
+            using ratio_int2x_type = detail::width2x_t<ratio_int_type>;
+
+        private:
+            static constexpr auto s_lhs_nu = Lhs::s_scaled_unit.natural_unit_.template to_repr<ratio_int_type>();
+            static constexpr auto s_rhs_nu = Rhs::s_scaled_unit.natural_unit_.template to_repr<ratio_int_type>();
+
+            static constexpr auto compute_rr() {
+                if constexpr (std::is_same_v<Op, detail::qexpr::op_multiply>)
+                    return detail::su_product<ratio_int_type, ratio_int2x_type>(s_lhs_nu, s_rhs_nu);
+                else if constexpr (std::is_same_v<Op, detail::qexpr::op_divide>)
+                    return detail::su_ratio<ratio_int_type, ratio_int2x_type>(s_lhs_nu, s_rhs_nu);
+                else /* rhs -> lhs conversion */
+                    return detail::su_ratio<ratio_int_type, ratio_int2x_type>(s_rhs_nu, s_lhs_nu);
+            }
+
+            static constexpr auto s_rr = compute_rr();
+
+            static constexpr bool c_is_additive = (std::is_same_v<Op, detail::qexpr::op_add>
+                                                   || std::is_same_v<Op, detail::qexpr::op_subtract>);
+
+            static_assert(!c_is_additive || s_rr.natural_unit_.is_dimensionless(),
+                          "quantity_expr: expected operands with the same dimension");
+
+            static constexpr auto compute_unit() {
+                if constexpr (c_is_additive)
+                    return Lhs::s_scaled_unit;
+                else
+                    return detail::su_promote<ratio_int_type>(s_rr.natural_unit_);
+            }
+
+            static constexpr double compute_factor() {
+                if constexpr (std::is_same_v<Op, detail::qexpr::op_multiply>)
+                    return Lhs::s_factor * Rhs::s_factor * detail::qexpr::outer_factor(s_rr);
+                else if constexpr (std::is_same_v<Op, detail::qexpr::op_divide>)
+                    return Lhs::s_factor / Rhs::s_factor * detail::qexpr::outer_factor(s_rr);
+                else
+                    return Lhs::s_factor;
+            }
+
+            /** additive ops: multiplier taking rhs raw scale onto lhs raw scale **/
+            static constexpr double s_rhs_factor = (c_is_additive
+                                                    ? (Rhs::s_factor * detail::qexpr::outer_factor(s_rr)
+                                                       / Lhs::s_factor)
+                                                    : 1.0);
+
+        public:
+            /** unit of result **/
+            static constexpr auto s_scaled_unit = compute_unit();
+            /** value = s_factor * raw,  in s_scaled_unit **/
+            static constexpr double s_factor = compute_factor();
+
+            using value_type = quantity<s_scaled_unit, repr_type>;
+
+        public:
+            constexpr quantity_expr_node(const Lhs & lhs, const Rhs & rhs) : lhs_{lhs}, rhs_{rhs} {}
+
+            /** @defgroup quantity-expr-node-methods quantity_expr_node methods **/
+            ///@{
+
+            /** number of rows for column expressions;  0 if all leaves are scalars **/
+            constexpr std::size_t size() const { return std::max(lhs_.size(), rhs_.size()); }
+
+            /** result at row @p i,  before applying @ref s_factor **/
+            constexpr repr_type raw(std::size_t i) const {
+                repr_type x = lhs_.raw(i);
+                repr_type y = rhs_.raw(i);
+
+                if constexpr (std::is_same_v<Op, detail::qexpr::op_multiply>) {
+                    return x * y;
+                } else if constexpr (std::is_same_v<Op, detail::qexpr::op_divide>) {
+                    return x / y;
+                } else {
+                    if constexpr (s_rhs_factor != 1.0)
+                        y = static_cast<repr_type>(s_rhs_factor) * y;
+
+                    if constexpr (std::is_same_v<Op, detail::qexpr::op_add>)
+                        return x + y;
+                    else
+                        return x - y;
+                }
+            }
+
+            /** evaluate (row @p i for column expressions) **/
+            constexpr value_type eval(std::size_t i = 0) const {
+                return this->eval_as<s_scaled_unit>(i);
+            }
+
+            /** evaluate,  expressing result in @p ScaledUnit2.
+             *  Unit conversion is folded into the single final multiply
+             **/
+            template <auto ScaledUnit2>
+            constexpr quantity<ScaledUnit2, repr_type> eval_as(std::size_t i = 0) const {
+                constexpr double k = s_factor * detail::rescale_factor<s_scaled_unit, ScaledUnit2, double>();
+
+                if constexpr (k == 1.0)
+                    return quantity<ScaledUnit2, repr_type>(this->raw(i));
+                else
+                    return quantity<ScaledUnit2, repr_type>(static_cast<repr_type>(k) * this->raw(i));
+            }
+
+            ///@}
+
+        private:
+            Lhs lhs_;
+            Rhs rhs_;
+        };
+
+        namespace detail {
+            namespace qexpr {
+                template <typename T>
+                constexpr auto as_expr(const T & x) {
+                    if constexpr (quantity_expr_concept<T>)
+                        return x;
+                    else if constexpr (std::is_arithmetic_v<T>)
+                        return quantity_expr_scalar<T>(x);
+                    else
+                        return quantity_expr_leaf<T>(x);
+                }
+
+                template <typename Op, typename L, typename R>
+                constexpr auto make_node(const L & x, const R & y) {
+                    using lhs_type = decltype(as_expr(x));
+                    using rhs_type = decltype(as_expr(y));
+
+                    return quantity_expr_node<Op, lhs_type, rhs_type>(as_expr(x), as_expr(y));
+                }
+            } /*namespace qexpr*/
+        } /*namespace detail*/
+
+        /** expression-template leaf for quantity @p x **/
+        template <typename Quantity>
+        requires (quantity_concept<Quantity> && Quantity::always_constexpr_unit)
+        constexpr auto
+        lazy(const Quantity & x) {
+            return quantity_expr_leaf<Quantity>(x);
+        }
+
+        /** expression-template leaf for column @p v **/
+        template <typename Quantity>
+        requires (quantity_concept<Quantity> && Quantity::always_constexpr_unit)
+        constexpr auto
+        lazy_column(std::span<const Quantity> v) {
+            return quantity_expr_column<Quantity>(v);
+        }
+
+        template <typename Quantity>
+        requires (quantity_concept<Quantity> && Quantity::always_constexpr_unit)
+        constexpr auto
+        lazy_column(const std::vector<Quantity> & v) {
+            return quantity_expr_column<Quantity>(std::span<const Quantity>(v));
+        }
+
+        /** evaluate column expression @p e into @p dest,  in the unit of @p dest.
+         *  One pass;  all unit conversion folded into one multiply per element.
+         *
+         *  @return number of rows written: min(@p e.size(), @p dest.size())
+         **/
+        template <typename Expr, auto ScaledUnit2, typename Repr2>
+        requires quantity_expr_concept<Expr>
+        std::size_t
+        eval_column(const Expr & e, std::span<quantity<ScaledUnit2, Repr2>> dest) {
+            std::size_t n = std::min(e.size(), dest.size());
+
+            for (std::size_t i = 0; i < n; ++i)
+                dest[i] = e.template eval_as<ScaledUnit2>(i).template with_repr<Repr2>();
+
+            return n;
+        }
+
+        template <typename L, typename R>
+        requires (quantity_expr_operand<L> && quantity_expr_operand<R>
+                  && (quantity_expr_concept<L> || quantity_expr_concept<R>))
+        constexpr auto
+        operator* (const L & x, const R & y) {
+            return detail::qexpr::make_node<detail::qexpr::op_multiply>(x, y);
+        }
+
+        template <typename L, typename R>
+        requires (quantity_expr_operand<L> && quantity_expr_operand<R>
+                  && (quantity_expr_concept<L> || quantity_expr_concept<R>))
+        constexpr auto
+        operator/ (const L & x, const R & y) {
+            return detail::qexpr::make_node<detail::qexpr::op_divide>(x, y);
+        }
+
+        template <typename L, typename R>
+        requires (quantity_expr_operand<L> && quantity_expr_operand<R>
+                  && (quantity_expr_concept<L> || quantity_expr_concept<R>))
+        constexpr auto
+        operator+ (const L & x, const R & y) {
+            return detail::qexpr::make_node<detail::qexpr::op_add>(x, y);
+        }
+
+        template <typename L, typename R>
+        requires (quantity_expr_operand<L> && quantity_expr_operand<R>
+                  && (quantity_expr_concept<L> || quantity_expr_concept<R>))
+        constexpr auto
+        operator- (const L & x, const R & y) {
+            return detail::qexpr::make_node<detail::qexpr::op_subtract>(x, y);
+        }
+
+        ///@}
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end quantity_expr.hpp **/
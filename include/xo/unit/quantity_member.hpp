@@ -0,0 +1,36 @@
+/** @file quantity_member.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "quantity.hpp"
+#include <type_traits>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            template <typename T>
+            struct member_traits;
+
+            template <typename Class, typename Member>
+            struct member_traits<Member Class::*> {
+                using class_type = Class;
+                using member_type = Member;
+            };
+
+            /** type of member designated by member pointer @p Member **/
+            template <auto Member>
+            using member_type_t = typename member_traits<decltype(Member)>::member_type;
+
+            /** true iff @p Member designates a quantity member of @p Target **/
+            template <typename Target, auto Member>
+            concept quantity_member = (std::is_same_v<typename member_traits<decltype(Member)>::class_type, Target>
+                                       && quantity_concept<member_type_t<Member>>
+                                       && member_type_t<Member>::always_constexpr_unit);
+        } /*namespace detail*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end quantity_member.hpp **/
@@ -9,7 +9,8 @@
 
 namespace xo {
     namespace qty {
-        /** note: won't have constexpr result until c++26 (when @c sqrt(), @c pow() are constexpr)
+        /** note: constexpr for quantities with compile-time units,
+         *  including fractional dimension
          **/
         template <typename Quantity, typename Quantity2>
         requires quantity_concept<Quantity> && quantity_concept<Quantity2>
@@ -19,7 +20,8 @@ namespace xo {
             return (Quantity::compare(x, y) == 0);
         }
 
-        /** note: won't have constexpr result until c++26 (when @c sqrt(), @c pow() are constexpr)
+        /** note: constexpr for quantities with compile-time units,
+         *  including fractional dimension
          **/
         template <typename Quantity, typename Quantity2>
         requires quantity_concept<Quantity> && quantity_concept<Quantity2>
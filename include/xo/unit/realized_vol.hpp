@@ -0,0 +1,628 @@
+/** @file realized_vol.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "quantity.hpp"
+#include <array>
+#include <span>
+#include <bit>
+#include <limits>
+#include <numbers>
+#include <type_traits>
+#include <cmath>
+#include <cstdint>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            /** true iff @p VolUnit is a volatility unit,  e.g. @c u::volatility_250d:
+             *  single basis unit,  with dimension time^(-1/2)
+             **/
+            template <auto VolUnit>
+            constexpr bool is_volatility_unit()
+            {
+                return ((VolUnit.n_bpu() == 1)
+                        && (VolUnit.lookup_dim(dim::time).power() == power_ratio_type(-1, 2)));
+            }
+
+            /** realized variance rate,  given sum @p sum_sq of squared log-returns
+             *  observed over elapsed time @p elapsed (a multiple of @c TimeQuantity units).
+             *
+             *  Log-returns are dimensionless,  so @c sum_sq/elapsed has dimension 1/time;
+             *  rescaling to @c VolUnit^2 (e.g. @c u::variance_250d) is done by unit algebra,
+             *  with a compile-time conversion factor.
+             **/
+            template <auto VolUnit, typename TimeQuantity, typename Repr>
+            inline auto
+            variance_rate(Repr sum_sq, typename TimeQuantity::repr_type elapsed)
+            {
+                constexpr auto var_unit = VolUnit * VolUnit;
+
+                if (!(elapsed > 0))
+                    return quantity<var_unit, Repr>(std::numeric_limits<Repr>::quiet_NaN());
+
+                auto rate = sum_sq / TimeQuantity(elapsed);
+
+                return rate.template rescale_ext<var_unit>();
+            }
+
+            /** bar width or sampling interval @p x in units of @p TimeQuantity,
+             *  rounded to nearest.  A positive @p x that rounds to zero
+             *  becomes one tick,  so the estimator's clock always advances.
+             **/
+            template <typename TimeQuantity, typename Quantity>
+            inline TimeQuantity
+            positive_interval(const Quantity & x)
+            {
+                using time_repr_type = typename TimeQuantity::repr_type;
+
+                TimeQuantity retval
+                    = rescale_rounded<TimeQuantity::s_scaled_unit, time_repr_type>(x);
+
+                if constexpr (std::is_integral_v<time_repr_type>) {
+                    if ((x.scale() > 0) && (retval.scale() == 0))
+                        return TimeQuantity(time_repr_type(1));
+                }
+
+                return retval;
+            }
+
+            /** natural log of @p x,  for positive normal @p x (e.g. a ratio of prices).
+             *
+             *  Branch-free and call-free,  so a loop over it auto-vectorizes;
+             *  a loop calling @c ::log does not.
+             *  fdlibm algorithm:  x = 2^k.(1+f),  with 1+f in [sqrt(1/2), sqrt(2)),
+             *  log(1+f) from a minimax polynomial in s = f/(2+f).
+             *  Within 1ulp of @c ::log.
+             *
+             *  Result is meaningless for zero, negative, subnormal, infinite or NaN @p x;
+             *  see @ref is_log_normal.
+             **/
+            inline double
+            log_normal(double x)
+            {
+                constexpr double c_ln2_hi = 6.93147180369123816490e-01;
+                constexpr double c_ln2_lo = 1.90821492927058770002e-10;
+                constexpr double c_lg1 = 6.666666666666735130e-01;
+                constexpr double c_lg2 = 3.999999999940941908e-01;
+                constexpr double c_lg3 = 2.857142874366239149e-01;
+                constexpr double c_lg4 = 2.222219843214978396e-01;
+                constexpr double c_lg5 = 1.818357216161805012e-01;
+                constexpr double c_lg6 = 1.531383769920937332e-01;
+                constexpr double c_lg7 = 1.479819860511658591e-01;
+
+                /* 0x3fe6a09e: high word of sqrt(1/2) */
+                constexpr std::uint64_t c_shift = std::uint64_t(0x3ff00000 - 0x3fe6a09e) << 32;
+                constexpr std::uint64_t c_mant_mask = (std::uint64_t(1) << 52) - 1;
+
+                std::uint64_t ix = std::bit_cast<std::uint64_t>(x) + c_shift;
+                /* biased exponent k + 1023 */
+                std::uint64_t kb = ix >> 52;
+                /* 1+f,  in [sqrt(1/2), sqrt(2)) */
+                double m = std::bit_cast<double>((ix & c_mant_mask) + (std::uint64_t(0x3fe6a09e) << 32));
+                /* (double)k,  without an int64 -> double conversion (not vectorizable before avx512) */
+                double k = std::bit_cast<double>(0x4330000000000000ull | kb) - (0x1p52 + 1023.0);
+
+                double f = m - 1.0;
+                double hfsq = 0.5 * f * f;
+                double s = f / (2.0 + f);
+                double z = s * s;
+                double w = z * z;
+                double t1 = w * (c_lg2 + w * (c_lg4 + w * c_lg6));
+                double t2 = z * (c_lg1 + w * (c_lg3 + w * (c_lg5 + w * c_lg7)));
+
+                return s * (hfsq + (t1 + t2)) + k * c_ln2_lo - hfsq + f + k * c_ln2_hi;
+            }
+
+            /** true iff @ref log_normal(@p x) is valid **/
+            inline bool
+            is_log_normal(double x)
+            {
+                return ((x >= std::numeric_limits<double>::min())
+                        && (x <= std::numeric_limits<double>::max()));
+            }
+
+            /** sum of squared log-returns log(p[i]/p[i-1]) over prices @p p_v,
+             *  with p[-1] = @p prev.  @p log_fn computes the log.
+             *
+             *  Squared returns are computed a block at a time,  in a loop with no
+             *  cross-iteration dependency;  they're then summed into four independent
+             *  partial sums (fixed order,  so no -ffast-math needed)
+             **/
+            template <typename Repr, typename PriceQuantity, typename LogFn>
+            inline Repr
+            sum_sq_log_return(Repr prev, std::span<const PriceQuantity> p_v, LogFn && log_fn)
+            {
+                constexpr std::size_t c_block = 64;
+
+                std::size_t n = p_v.size();
+
+                if (n == 0)
+                    return 0;
+
+                std::array<Repr, 4> acc = { 0, 0, 0, 0 };
+                std::array<Repr, c_block> r2_v;
+
+                Repr r0 = log_fn(p_v[0].scale() / prev);
+                acc[0] += r0 * r0;
+
+                std::size_t i = 1;
+
+                for (; i + c_block <= n; i += c_block) {
+                    for (std::size_t k = 0; k < c_block; ++k) {
+                        Repr r = log_fn(p_v[i + k].scale() / p_v[i + k - 1].scale());
+                        r2_v[k] = r * r;
+                    }
+
+                    for (std::size_t k = 0; k < c_block; k += 4) {
+                        for (std::size_t j = 0; j < 4; ++j)
+                            acc[j] += r2_v[k + j];
+                    }
+                }
+
+                for (; i < n; ++i) {
+                    Repr r = log_fn(p_v[i].scale() / p_v[i - 1].scale());
+                    acc[0] += r * r;
+                }
+
+                return (acc[0] + acc[1]) + (acc[2] + acc[3]);
+            }
+
+            /** number of returns p[i]/p[i-1] (p[-1] = @p prev) outside the domain of @ref log_normal **/
+            template <typename PriceQuantity>
+            inline std::size_t
+            count_log_abnormal(double prev, std::span<const PriceQuantity> p_v)
+            {
+                std::size_t n = p_v.size();
+
+                if (n == 0)
+                    return 0;
+
+                std::size_t n_bad = !is_log_normal(p_v[0].scale() / prev);
+
+                for (std::size_t i = 1; i < n; ++i)
+                    n_bad += !is_log_normal(p_v[i].scale() / p_v[i - 1].scale());
+
+                return n_bad;
+            }
+        } /*namespace detail*/
+
+        /** @class close_to_close_vol
+         *  @brief realized volatility from squared log-returns between consecutive prices.
+         *
+         *  @tparam VolUnit  volatility unit for results,  e.g. @c u::volatility_250d
+         *  @tparam TimeQuantity  quantity type for timestamps,  e.g. @c quantity<u::second>
+         *  @tparam PriceQuantity  quantity type for prices
+         *
+         *  Two update paths,  with the same result up to summation order and 1ulp per log:
+         *  - per-tick: @c add(t,p),  using @c ::log
+         *  - batched: @c add(t_v,p_v).  For double prices,  uses branch-free
+         *    @ref detail::log_normal in a loop the compiler vectorizes
+         *    (2 lanes with sse2, 4 with avx2).
+         *    Falls back to @c ::log if any price ratio is outside the normal range.
+         **/
+        template <auto VolUnit,
+                  typename TimeQuantity,
+                  typename PriceQuantity = quantity<u::price>>
+        requires (detail::is_volatility_unit<VolUnit>()
+                  && quantity_concept<TimeQuantity>
+                  && quantity_concept<PriceQuantity>
+                  && TimeQuantity::always_constexpr_unit)
+        class close_to_close_vol {
+        public:
+            /** @defgroup close-to-close-vol-type-traits close_to_close_vol type traits **/
+            ///@{
+            using repr_type = typename PriceQuantity::repr_type;
+            using time_repr_type = typename TimeQuantity::repr_type;
+            /** @brief type for realized variance,  e.g. @c quantity<u::variance_250d> **/
+            using variance_type = quantity<VolUnit * VolUnit, repr_type>;
+            /** @brief type for realized volatility,  e.g. @c quantity<u::volatility_250d> **/
+            using volatility_type = quantity<VolUnit, repr_type>;
+            ///@}
+
+        public:
+            /** @defgroup close-to-close-vol-access-methods close_to_close_vol access methods **/
+            ///@{
+
+            /** number of prices seen **/
+            std::uint64_t count() const { return n_; }
+            /** time elapsed from first to last price **/
+            TimeQuantity elapsed() const { return TimeQuantity(t_ - t0_); }
+            /** sum of squared log returns **/
+            repr_type sum_sq() const { return sum_sq_; }
+            /** realized variance rate.  NaN until elapsed time is positive **/
+            variance_type variance() const {
+                return detail::variance_rate<VolUnit, TimeQuantity>(sum_sq_, t_ - t0_);
+            }
+            /** realized volatility:  square root of @ref variance **/
+            volatility_type volatility() const {
+                return volatility_type(::sqrt(this->variance().scale()));
+            }
+
+            ///@}
+
+            /** @defgroup close-to-close-vol-general-methods close_to_close_vol general methods **/
+            ///@{
+
+            /** include price @p p observed at time @p t.
+             *  @pre @p t not earlier than previous timestamp
+             **/
+            void add(const TimeQuantity & t, const PriceQuantity & p) {
+                if (n_ == 0) {
+                    t0_ = t.scale();
+                } else {
+                    repr_type r = ::log(p.scale() / p_);
+                    sum_sq_ += r * r;
+                }
+
+                t_ = t.scale();
+                p_ = p.scale();
+                ++n_;
+            }
+
+            /** include prices (@p t_v[i], @p p_v[i]) in order.
+             *  @pre @p t_v.size() == @p p_v.size()
+             **/
+            void add(std::span<const TimeQuantity> t_v, std::span<const PriceQuantity> p_v) {
+                std::size_t n = p_v.size();
+
+                if (n == 0)
+                    return;
+
+                std::size_t i0 = 0;
+
+                if (n_ == 0)
+                    this->add(t_v[i0++], p_v[0]);
+
+                /* r[i] = log(p[i] / p[i-1]);  p[i0-1] is p_ */
+                std::span<const PriceQuantity> rest_v = p_v.subspan(i0);
+
+                if constexpr (std::is_same_v<repr_type, double>) {
+                    if (detail::count_log_abnormal(p_, rest_v) == 0) {
+                        sum_sq_ += detail::sum_sq_log_return(p_, rest_v,
+                                                             [](double x) { return detail::log_normal(x); });
+                    } else {
+                        sum_sq_ += detail::sum_sq_log_return(p_, rest_v,
+                                                             [](double x) { return ::log(x); });
+                    }
+                } else {
+                    sum_sq_ += detail::sum_sq_log_return(p_, rest_v,
+                                                         [](repr_type x) { return ::log(x); });
+                }
+
+                t_ = t_v[n - 1].scale();
+                p_ = p_v[n - 1].scale();
+                n_ += (n - i0);
+            }
+
+            ///@}
+
+        private:
+            /** @defgroup close-to-close-vol-instance-vars close_to_close_vol instance variables **/
+            ///@{
+
+            /** number of prices seen **/
+            std::uint64_t n_ = 0;
+            /** timestamp of first price **/
+            time_repr_type t0_ = 0;
+            /** timestamp of last price **/
+            time_repr_type t_ = 0;
+            /** last price **/
+            repr_type p_ = 0;
+            /** sum of squared log returns **/
+            repr_type sum_sq_ = 0;
+
+            ///@}
+        }; /*close_to_close_vol*/
+
+        /** @class parkinson_vol
+         *  @brief realized volatility from high/low ranges over fixed-width bars
+         *  (Parkinson estimator).
+         *
+         *  Per-bar variance is @c (log(H/L))^2 / (4 log 2);
+         *  rate divides total by total bar time.
+         *
+         *  Bars can be supplied directly (@ref add_bar),  or assembled from a tick stream
+         *  (@ref add).  For a tick stream, bars are aligned to first tick timestamp,
+         *  and only completed bars contribute to results.
+         *  Bars with no ticks (e.g. across a trading halt) are skipped:
+         *  they contribute neither range nor time.
+         **/
+        template <auto VolUnit,
+                  typename TimeQuantity,
+                  typename PriceQuantity = quantity<u::price>>
+        requires (detail::is_volatility_unit<VolUnit>()
+                  && quantity_concept<TimeQuantity>
+                  && quantity_concept<PriceQuantity>
+                  && TimeQuantity::always_constexpr_unit)
+        class parkinson_vol {
+        public:
+            /** @defgroup parkinson-vol-type-traits parkinson_vol type traits **/
+            ///@{
+            using repr_type = typename PriceQuantity::repr_type;
+            using time_repr_type = typename TimeQuantity::repr_type;
+            using variance_type = quantity<VolUnit * VolUnit, repr_type>;
+            using volatility_type = quantity<VolUnit, repr_type>;
+            ///@}
+
+        public:
+            /** @defgroup parkinson-vol-ctors parkinson_vol constructors **/
+            ///@{
+            /** estimator with bars of width @p bar_width.  May use any time unit;
+             *  rounded to nearest timestamp tick,  but at least one tick.
+             *  A bar width that isn't positive disables the estimator:
+             *  @ref add ignores ticks.
+             **/
+            template <typename BarQuantity>
+            requires (quantity_concept<BarQuantity> && BarQuantity::always_constexpr_unit)
+            explicit parkinson_vol(const BarQuantity & bar_width)
+                : bar_width_{detail::positive_interval<TimeQuantity>(bar_width)}
+                {}
+            ///@}
+
+            /** @defgroup parkinson-vol-access-methods parkinson_vol access methods **/
+            ///@{
+
+            /** bar width **/
+            const TimeQuantity & bar_width() const { return bar_width_; }
+            /** number of completed bars **/
+            std::uint64_t n_bar() const { return n_bar_; }
+            /** realized variance rate over completed bars.  NaN if none **/
+            variance_type variance() const {
+                return detail::variance_rate<VolUnit, TimeQuantity>
+                    (sum_sq_ / (4 * std::numbers::ln2_v<repr_type>),
+                     static_cast<time_repr_type>(n_bar_) * bar_width_.scale());
+            }
+            /** realized volatility:  square root of @ref variance **/
+            volatility_type volatility() const {
+                return volatility_type(::sqrt(this->variance().scale()));
+            }
+
+            ///@}
+
+            /** @defgroup parkinson-vol-general-methods parkinson_vol general methods **/
+            ///@{
+
+            /** include one completed bar,  with price range [@p lo, @p hi] **/
+            void add_bar(const PriceQuantity & hi, const PriceQuantity & lo) {
+                this->add_bar_scale(hi.scale(), lo.scale());
+            }
+
+            /** include price @p p observed at time @p t.
+             *  @pre @p t not earlier than previous timestamp
+             **/
+            void add(const TimeQuantity & t, const PriceQuantity & p) {
+                time_repr_type w = bar_width_.scale();
+
+                if (!(w > 0))
+                    return;
+
+                time_repr_type ts = t.scale();
+                repr_type ps = p.scale();
+
+                if (!in_bar_) {
+                    bar_end_ = ts + w;
+                    in_bar_ = true;
+                    hi_ = ps;
+                    lo_ = ps;
+                    return;
+                }
+
+                if (ts >= bar_end_) {
+                    this->add_bar_scale(hi_, lo_);
+
+                    /* skip empty bars in between.
+                     * Counting them as zero-range bars would bias the estimate down
+                     */
+                    time_repr_type n_skip = 0;
+
+                    if constexpr (std::is_integral_v<time_repr_type>)
+                        n_skip = (ts - bar_end_) / w;
+                    else
+                        n_skip = std::floor((ts - bar_end_) / w);
+
+                    bar_end_ += (n_skip + 1) * w;
+                    hi_ = ps;
+                    lo_ = ps;
+                } else {
+                    hi_ = std::max(hi_, ps);
+                    lo_ = std::min(lo_, ps);
+                }
+            }
+
+            /** include prices (@p t_v[i], @p p_v[i]) in order **/
+            void add(std::span<const TimeQuantity> t_v, std::span<const PriceQuantity> p_v) {
+                for (std::size_t i = 0, n = p_v.size(); i < n; ++i)
+                    this->add(t_v[i], p_v[i]);
+            }
+
+            ///@}
+
+        private:
+            void add_bar_scale(repr_type hi, repr_type lo) {
+                repr_type r = ::log(hi / lo);
+
+                sum_sq_ += r * r;
+                ++n_bar_;
+            }
+
+        private:
+            /** @defgroup parkinson-vol-instance-vars parkinson_vol instance variables **/
+            ///@{
+
+            /** bar width **/
+            TimeQuantity bar_width_;
+            /** number of completed bars **/
+            std::uint64_t n_bar_ = 0;
+            /** sum of squared log ranges over completed bars **/
+            repr_type sum_sq_ = 0;
+            /** true once first tick seen **/
+            bool in_bar_ = false;
+            /** end time (exclusive) of current bar **/
+            time_repr_type bar_end_ = 0;
+            /** high price in current bar **/
+            repr_type hi_ = 0;
+            /** low price in current bar **/
+            repr_type lo_ = 0;
+
+            ///@}
+        }; /*parkinson_vol*/
+
+        /** @class subsampled_vol
+         *  @brief realized volatility from prices sampled on a regular time grid,
+         *  averaged over @p NGrid staggered grids.
+         *
+         *  Sparse sampling reduces the bias from microstructure noise
+         *  in tick-by-tick close-to-close estimates;  averaging over offset grids
+         *  recovers some of the discarded information.
+         *  Price at each grid point is the last price observed at or before it.
+         **/
+        template <auto VolUnit,
+                  typename TimeQuantity,
+                  typename PriceQuantity = quantity<u::price>,
+                  std::size_t NGrid = 1>
+        requires (detail::is_volatility_unit<VolUnit>()
+                  && quantity_concept<TimeQuantity>
+                  && quantity_concept<PriceQuantity>
+                  && TimeQuantity::always_constexpr_unit
+                  && (NGrid > 0))
+        class subsampled_vol {
+        public:
+            /** @defgroup subsampled-vol-type-traits subsampled_vol type traits **/
+            ///@{
+            using repr_type = typename PriceQuantity::repr_type;
+            using time_repr_type = typename TimeQuantity::repr_type;
+            using variance_type = quantity<VolUnit * VolUnit, repr_type>;
+            using volatility_type = quantity<VolUnit, repr_type>;
+            ///@}
+
+        public:
+            /** @defgroup subsampled-vol-ctors subsampled_vol constructors **/
+            ///@{
+            /** estimator sampling every @p interval.  May use any time unit;
+             *  rounded to nearest timestamp tick,  but at least one tick.
+             *  An interval that isn't positive disables the estimator:
+             *  @ref add ignores ticks.
+             **/
+            template <typename IntervalQuantity>
+            requires (quantity_concept<IntervalQuantity> && IntervalQuantity::always_constexpr_unit)
+            explicit subsampled_vol(const IntervalQuantity & interval)
+                : interval_{detail::positive_interval<TimeQuantity>(interval)}
+                {}
+            ///@}
+
+            /** @defgroup subsampled-vol-access-methods subsampled_vol access methods **/
+            ///@{
+
+            /** sampling interval **/
+            const TimeQuantity & interval() const { return interval_; }
+            /** number of sampled returns,  over all grids **/
+            std::uint64_t n_return() const {
+                std::uint64_t n = 0;
+                for (const auto & g : grid_v_)
+                    n += g.n_return_;
+                return n;
+            }
+            /** realized variance rate,  averaged over grids.  NaN if no returns yet **/
+            variance_type variance() const {
+                repr_type sum_sq = 0;
+                for (const auto & g : grid_v_)
+                    sum_sq += g.sum_sq_;
+
+                return detail::variance_rate<VolUnit, TimeQuantity>
+                    (sum_sq, static_cast<time_repr_type>(this->n_return()) * interval_.scale());
+            }
+            /** realized volatility:  square root of @ref variance **/
+            volatility_type volatility() const {
+                return volatility_type(::sqrt(this->variance().scale()));
+            }
+
+            ///@}
+
+            /** @defgroup subsampled-vol-general-methods subsampled_vol general methods **/
+            ///@{
+
+            /** include price @p p observed at time @p t.
+             *  @pre @p t not earlier than previous timestamp
+             **/
+            void add(const TimeQuantity & t, const PriceQuantity & p) {
+                if (!(interval_.scale() > 0))
+                    return;
+
+                time_repr_type ts = t.scale();
+                repr_type ps = p.scale();
+
+                if (!started_) {
+                    for (std::size_t j = 0; j < NGrid; ++j) {
+                        grid_v_[j].next_ = (ts + (static_cast<time_repr_type>(j) * interval_.scale()
+                                                  / static_cast<time_repr_type>(NGrid)));
+                    }
+                    started_ = true;
+                    last_p_ = ps;
+                }
+
+                for (auto & g : grid_v_) {
+                    while (g.next_ <= ts) {
+                        g.sample((g.next_ == ts) ? ps : last_p_);
+                        g.next_ += interval_.scale();
+                    }
+                }
+
+                last_p_ = ps;
+            }
+
+            /** include prices (@p t_v[i], @p p_v[i]) in order **/
+            void add(std::span<const TimeQuantity> t_v, std::span<const PriceQuantity> p_v) {
+                for (std::size_t i = 0, n = p_v.size(); i < n; ++i)
+                    this->add(t_v[i], p_v[i]);
+            }
+
+            ///@}
+
+        private:
+            /** state for one sampling grid **/
+            struct grid_state {
+                void sample(repr_type p) {
+                    if (n_sample_ > 0) {
+                        repr_type r = ::log(p / p_);
+                        sum_sq_ += r * r;
+                        ++n_return_;
+                    }
+                    p_ = p;
+                    ++n_sample_;
+                }
+
+                /** time of next grid point **/
+                time_repr_type next_ = 0;
+                /** price at last grid point **/
+                repr_type p_ = 0;
+                /** number of grid points sampled **/
+                std::uint64_t n_sample_ = 0;
+                /** number of returns **/
+                std::uint64_t n_return_ = 0;
+                /** sum of squared log returns **/
+                repr_type sum_sq_ = 0;
+            };
+
+        private:
+            /** @defgroup subsampled-vol-instance-vars subsampled_vol instance variables **/
+            ///@{
+
+            /** sampling interval **/
+            TimeQuantity interval_;
+            /** true once first tick seen **/
+            bool started_ = false;
+            /** last price seen **/
+            repr_type last_p_ = 0;
+            /** per-grid state;  grid j offset by j*interval/NGrid **/
+            std::array<grid_state, NGrid> grid_v_;
+
+            ///@}
+        }; /*subsampled_vol*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end realized_vol.hpp **/
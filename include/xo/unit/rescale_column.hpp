@@ -0,0 +1,189 @@
+/** @file rescale_column.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "quantity.hpp"
+#include "xquantity.hpp"
+#include "constexpr_math.hpp"
+#include <span>
+#include <cmath>
+#include <type_traits>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            /** multiplier converting a multiple of @p ScaledUnit to a multiple of @p ScaledUnit2.
+             *  Evaluated at compile time,  including fractional-power (square root) terms.
+             *
+             *  Mirrors @c quantity::rescale_ext operation-for-operation.
+             *  Consequently for any @c x:
+             *  @code
+             *  rescale_factor<S1,S2,Repr>() * x
+             *    == quantity<S1,Repr>(x).template rescale_ext<S2>().scale()   // bitwise
+             *  @endcode
+             **/
+            template <auto ScaledUnit, auto ScaledUnit2, typename Repr>
+            requires (ScaledUnit.is_natural() && ScaledUnit2.is_natural())
+            constexpr auto
+            rescale_factor()
+            {
+                using ratio_int_type = typename decltype(ScaledUnit)::ratio_int_type;
+                using ratio_int2x_type = width2x_t<ratio_int_type>;
+
+                constexpr auto rr = su_ratio_v<ratio_int_type,
+                                               ratio_int2x_type,
+                                               ScaledUnit.natural_unit_,
+                                               ScaledUnit2.natural_unit_>;
+
+                static_assert(rr.natural_unit_.is_dimensionless(),
+                              "rescale_factor: expected units with the same dimension");
+
+                return ((((rr.outer_scale_sq_ == 1.0)
+                          && (ScaledUnit2.outer_scale_sq_ == 1.0))
+                         ? 1.0
+                         : cx_sqrt(rr.outer_scale_sq_ / ScaledUnit2.outer_scale_sq_))
+                        * rr.outer_scale_factor_.template convert_to<Repr>());
+            }
+
+            /** @p nu with each basis unit replaced by the native unit (scalefactor 1)
+             *  for the same dimension,  in dimension order.
+             *  For example @c s^-1.km -> @c m.s^-1
+             **/
+            template <typename Int>
+            constexpr natural_unit<Int>
+            native_nu(const natural_unit<Int> & nu)
+            {
+                natural_unit<Int> retval;
+
+                for (std::size_t d = 0; d < n_dim; ++d) {
+                    bpu<Int> b = nu.lookup_dim(static_cast<dimension>(d));
+
+                    if (b.power() != power_ratio_type(0))
+                        retval.push_back(bpu<Int>(b.native_dim(),
+                                                  scalefactor_ratio_type(1, 1),
+                                                  b.power()));
+                }
+
+                return retval;
+            }
+
+            /** true iff natural units @p U1, @p U2 have the same dimension **/
+            template <auto U1, auto U2>
+            inline constexpr bool same_dimension_v = [] {
+                using int_type = typename decltype(U1)::ratio_int_type;
+
+                return su_ratio_v<int_type, width2x_t<int_type>,
+                                  U1.natural_unit_,
+                                  U2.natural_unit_>.natural_unit_.is_dimensionless();
+            }();
+
+            /** value of quantity @p x,  as a multiple of @p ScaledUnit2 (repr @p Repr2).
+             *  Conversion factor is a compile-time constant;
+             *  fails to compile if dimensions differ.
+             **/
+            template <auto ScaledUnit2, typename Repr2, typename Quantity>
+            requires (quantity_concept<Quantity> && Quantity::always_constexpr_unit)
+            constexpr Repr2
+            scale_in(const Quantity & x)
+            {
+                constexpr auto k = rescale_factor<Quantity::s_scaled_unit, ScaledUnit2, double>();
+
+                if constexpr (k == 1.0) {
+                    return static_cast<Repr2>(x.scale());
+                } else {
+                    if constexpr (std::is_integral_v<Repr2>)
+                        return static_cast<Repr2>(std::llround(k * x.scale()));
+                    else
+                        return static_cast<Repr2>(k * x.scale());
+                }
+            }
+        } /*namespace detail*/
+
+        /** @defgroup rescale-column column rescaling **/
+        ///@{
+
+        /** convert a column of values expressed in @p ScaledUnit,
+         *  to the same values expressed in @p ScaledUnit2.
+         *  Conversion factor is a compile-time constant;  one multiply per element.
+         *
+         *  @pre @p dest.size() >= @p src.size()
+         **/
+        template <auto ScaledUnit, auto ScaledUnit2, typename Repr>
+        inline void
+        rescale_column(std::span<const std::type_identity_t<Repr>> src,
+                       std::span<Repr> dest)
+        {
+            constexpr auto k = detail::rescale_factor<ScaledUnit, ScaledUnit2, Repr>();
+
+            for (std::size_t i = 0, n = src.size(); i < n; ++i)
+                dest[i] = k * src[i];
+        }
+
+        /** convert a column of quantities @p src to unit @p ScaledUnit2.
+         *  Conversion factor is a compile-time constant;  one multiply per element.
+         *  Bitwise identical to per-element @c rescale_ext
+         *
+         *  @pre @p dest.size() >= @p src.size()
+         **/
+        template <auto ScaledUnit2, auto ScaledUnit, typename Repr>
+        inline void
+        rescale_column(std::span<const quantity<ScaledUnit, Repr>> src,
+                       std::span<quantity<ScaledUnit2, Repr>> dest)
+        {
+            constexpr auto k = detail::rescale_factor<ScaledUnit, ScaledUnit2, Repr>();
+
+            for (std::size_t i = 0, n = src.size(); i < n; ++i)
+                dest[i] = quantity<ScaledUnit2, Repr>(k * src[i].scale());
+        }
+
+        /** convert a column of xquantities @p src to unit @p unit2.
+         *  Conversion factor is computed once;  one multiply per element.
+         *  Produces NaN if dimensions differ.
+         *
+         *  @pre all members of @p src share the same unit.
+         *  @pre @p dest.size() >= @p src.size()
+         **/
+        template <typename Repr, typename Int>
+        inline void
+        rescale_column(std::span<const xquantity<Repr, Int>> src,
+                       const natural_unit<Int> & unit2,
+                       std::span<xquantity<Repr, Int>> dest)
+        {
+            if (src.empty())
+                return;
+
+            /* factor computed same as xquantity::rescale() */
+            Repr k = src[0].unit_qty().rescale(unit2).scale();
+
+            for (std::size_t i = 0, n = src.size(); i < n; ++i)
+                dest[i] = xquantity<Repr, Int>(k * src[i].scale(), unit2);
+        }
+
+        /** re-annualize a column of volatilities (dimension time^-1/2)
+         *  or variances (dimension time^-1),  for example from @c u::volatility_250d
+         *  to @c u::volatility_365d.
+         *
+         *  Day-count ratio,  including its square root for volatilities,
+         *  is computed at compile time.
+         *
+         *  @pre @p dest.size() >= @p src.size()
+         **/
+        template <auto ScaledUnit2, auto ScaledUnit, typename Repr>
+        requires ((ScaledUnit2.n_bpu() == 1)
+                  && ((ScaledUnit2.lookup_dim(dim::time).power() == power_ratio_type(-1, 2))
+                      || (ScaledUnit2.lookup_dim(dim::time).power() == power_ratio_type(-1))))
+        inline void
+        reannualize(std::span<const quantity<ScaledUnit, Repr>> src,
+                    std::span<quantity<ScaledUnit2, Repr>> dest)
+        {
+            rescale_column<ScaledUnit2>(src, dest);
+        }
+
+        ///@}
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end rescale_column.hpp **/
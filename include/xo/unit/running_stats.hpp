@@ -0,0 +1,485 @@
+/** @file running_stats.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "quantity.hpp"
+#include "xquantity.hpp"
+#include <span>
+#include <algorithm>
+#include <type_traits>
+#include <limits>
+#include <cmath>
+#include <cstdint>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            /** scale of sample @p x,  expressed as a multiple of @p unit.
+             *  Free for compile-time units;  runtime units rescaled only when they differ.
+             **/
+            template <typename Quantity>
+            requires quantity_concept<Quantity>
+            inline typename Quantity::repr_type
+            sample_scale(const Quantity & unit, const Quantity & x)
+            {
+                if constexpr (Quantity::always_constexpr_unit) {
+                    (void)unit;
+                    return x.scale();
+                } else {
+                    if (x.unit() == unit.unit())
+                        return x.scale();
+                    else
+                        return x.rescale(unit.unit()).scale();
+                }
+            }
+
+            /** multiplier converting a multiple of @p from_unit to a multiple of @p to_unit **/
+            template <typename Quantity>
+            requires quantity_concept<Quantity>
+            inline typename Quantity::repr_type
+            unit_factor(const Quantity & from_unit, const Quantity & to_unit)
+            {
+                return sample_scale(to_unit, from_unit);
+            }
+
+            /** compensated (Kahan-Babuska) running sum **/
+            template <typename Repr>
+            struct compensated_sum {
+                static_assert(std::is_floating_point_v<Repr>,
+                              "compensated_sum: expected floating-point Repr");
+
+                void add(Repr x) {
+                    Repr t = sum_ + x;
+
+                    if (::fabs(sum_) >= ::fabs(x))
+                        comp_ += (sum_ - t) + x;
+                    else
+                        comp_ += (x - t) + sum_;
+
+                    sum_ = t;
+                }
+
+                void merge(const compensated_sum & other, Repr k) {
+                    this->add(k * other.sum_);
+                    this->add(k * other.comp_);
+                }
+
+                Repr value() const { return sum_ + comp_; }
+
+                Repr sum_ = 0;
+                Repr comp_ = 0;
+            };
+        } /*namespace detail*/
+
+        /** @class running_stats
+         *  @brief online count/sum/mean/variance/min/max for a stream of quantities.
+         *
+         *  Uses Welford's update for mean and variance,
+         *  and a compensated sum,  so accuracy does not degrade with stream length.
+         *  Arithmetic runs on bare @c repr_type values;  units are reattached
+         *  by accessors,  so there is no per-sample unit overhead for @ref quantity.
+         *
+         *  Results are unit-correct:
+         *  - @ref mean, @ref stddev, @ref min, @ref max have the same unit as samples
+         *  - @ref variance has the square of sample unit.
+         *
+         *  For @ref xquantity samples,  unit is taken from the first sample;
+         *  later samples are rescaled to that unit as needed.
+         *
+         *  Accumulators for disjoint parts of a stream can be combined with @ref merge,
+         *  for example to reduce per-thread results.  Never allocates.
+         **/
+        template <typename Quantity>
+        requires quantity_concept<Quantity>
+        class running_stats {
+        public:
+            /** @defgroup running-stats-type-traits running_stats type traits **/
+            ///@{
+            /** @brief type for a single sample **/
+            using quantity_type = Quantity;
+            /** @brief representation for sample scale **/
+            using repr_type = typename Quantity::repr_type;
+            /** @brief type for variance;  unit is square of sample unit **/
+            using variance_type = decltype(std::declval<Quantity>() * std::declval<Quantity>());
+            ///@}
+
+            /* Welford update divides by sample count;  integer repr would truncate mean and variance */
+            static_assert(std::is_floating_point_v<repr_type>,
+                          "running_stats: expected floating-point repr_type");
+
+        public:
+            /** @defgroup running-stats-ctors running_stats constructors **/
+            ///@{
+            /** empty accumulator **/
+            running_stats() = default;
+            /** empty accumulator;  results will be reported as multiples of @p unit **/
+            explicit running_stats(const Quantity & unit) : unit_{unit.unit_qty()}, unit_fixed_{true} {}
+            ///@}
+
+            /** @defgroup running-stats-access-methods running_stats access methods **/
+            ///@{
+
+            /** number of samples **/
+            std::uint64_t count() const { return n_; }
+
+            /** sum of samples **/
+            Quantity sum() const { return unit_ * sum_.value(); }
+
+            /** sample mean.  NaN if empty **/
+            Quantity mean() const { return unit_ * ((n_ > 0) ? mean_ : nan()); }
+
+            /** unbiased sample variance (divides by n-1).  NaN if fewer than 2 samples **/
+            variance_type variance() const {
+                return (unit_ * unit_) * this->variance_scale(1);
+            }
+
+            /** population variance (divides by n).  NaN if empty **/
+            variance_type pop_variance() const {
+                return (unit_ * unit_) * this->variance_scale(0);
+            }
+
+            /** sample standard deviation;  square root of @ref variance **/
+            Quantity stddev() const { return unit_ * ::sqrt(this->variance_scale(1)); }
+
+            /** smallest sample.  NaN if empty **/
+            Quantity min() const { return unit_ * ((n_ > 0) ? min_ : nan()); }
+
+            /** largest sample.  NaN if empty **/
+            Quantity max() const { return unit_ * ((n_ > 0) ? max_ : nan()); }
+
+            ///@}
+
+            /** @defgroup running-stats-general-methods running_stats general methods **/
+            ///@{
+
+            /** include sample @p x **/
+            void add(const Quantity & x) {
+                if ((n_ == 0) && !unit_fixed_) {
+                    unit_ = x.unit_qty();
+                    unit_fixed_ = true;
+                }
+
+                this->add_scale(detail::sample_scale(unit_, x));
+            }
+
+            /** include all samples in @p x_v **/
+            void add(std::span<const Quantity> x_v) {
+                for (const auto & x : x_v)
+                    this->add(x);
+            }
+
+            /** include all samples from @p other,
+             *  as if they had been added to @c this directly.
+             *  (Chan et al. parallel update)
+             **/
+            void merge(const running_stats & other) {
+                if (other.n_ == 0)
+                    return;
+
+                if (n_ == 0) {
+                    if (unit_fixed_) {
+                        /* keep our unit */
+                    } else {
+                        *this = other;
+                        return;
+                    }
+                }
+
+                repr_type k = detail::unit_factor(other.unit_, unit_);
+
+                repr_type o_mean = k * other.mean_;
+                repr_type o_m2 = k * k * other.m2_;
+                repr_type o_min = k * other.min_;
+                repr_type o_max = k * other.max_;
+
+                if (n_ == 0) {
+                    n_ = other.n_;
+                    mean_ = o_mean;
+                    m2_ = o_m2;
+                    min_ = o_min;
+                    max_ = o_max;
+                } else {
+                    std::uint64_t n = n_ + other.n_;
+                    repr_type delta = o_mean - mean_;
+                    repr_type na = static_cast<repr_type>(n_);
+                    repr_type nb = static_cast<repr_type>(other.n_);
+
+                    mean_ += delta * (nb / static_cast<repr_type>(n));
+                    m2_ += o_m2 + delta * delta * (na * nb / static_cast<repr_type>(n));
+                    min_ = std::min(min_, o_min);
+                    max_ = std::max(max_, o_max);
+                    n_ = n;
+                }
+
+                sum_.merge(other.sum_, k);
+            }
+
+            ///@}
+
+        private:
+            static constexpr repr_type nan() { return std::numeric_limits<repr_type>::quiet_NaN(); }
+
+            void add_scale(repr_type x) {
+                ++n_;
+
+                repr_type delta = x - mean_;
+                mean_ += delta / static_cast<repr_type>(n_);
+                m2_ += delta * (x - mean_);
+
+                if (n_ == 1) {
+                    min_ = x;
+                    max_ = x;
+                } else {
+                    min_ = std::min(min_, x);
+                    max_ = std::max(max_, x);
+                }
+
+                sum_.add(x);
+            }
+
+            /** variance scale,  with @p ddof delta degrees of freedom **/
+            repr_type variance_scale(std::uint64_t ddof) const {
+                if (n_ <= ddof)
+                    return nan();
+
+                return m2_ / static_cast<repr_type>(n_ - ddof);
+            }
+
+        private:
+            /** @defgroup running-stats-instance-vars running_stats instance variables **/
+            ///@{
+
+            /** unit quantity;  all accumulated values are multiples of this **/
+            Quantity unit_ = Quantity().unit_qty();
+            /** true once @ref unit_ established (by ctor, or from first sample) **/
+            bool unit_fixed_ = false;
+            /** number of samples **/
+            std::uint64_t n_ = 0;
+            /** running mean **/
+            repr_type mean_ = 0;
+            /** running sum of squared deviations from mean **/
+            repr_type m2_ = 0;
+            /** smallest sample **/
+            repr_type min_ = 0;
+            /** largest sample **/
+            repr_type max_ = 0;
+            /** compensated sum of samples **/
+            detail::compensated_sum<repr_type> sum_;
+
+            ///@}
+        }; /*running_stats*/
+
+        /** @class running_covariance
+         *  @brief online covariance and correlation for a stream of
+         *  paired quantities @c (a,b).
+         *
+         *  @ref covariance has unit given by product of @p QuantityA and @p QuantityB units.
+         *  Mergeable,  like @ref running_stats.
+         **/
+        template <typename QuantityA, typename QuantityB>
+        requires quantity_concept<QuantityA> && quantity_concept<QuantityB>
+        class running_covariance {
+        public:
+            /** @defgroup running-covariance-type-traits running_covariance type traits **/
+            ///@{
+            using repr_type = std::common_type_t<typename QuantityA::repr_type,
+                                                 typename QuantityB::repr_type>;
+            /** @brief type for covariance;  unit is product of a,b units **/
+            using covariance_type = decltype(std::declval<QuantityA>() * std::declval<QuantityB>());
+            ///@}
+
+            static_assert(std::is_floating_point_v<repr_type>,
+                          "running_covariance: expected floating-point repr_type");
+
+        public:
+            /** @defgroup running-covariance-access-methods running_covariance access methods **/
+            ///@{
+
+            /** number of sample pairs **/
+            std::uint64_t count() const { return n_; }
+
+            /** mean of first member of each pair **/
+            QuantityA mean_a() const { return unit_a_ * ((n_ > 0) ? mean_a_ : nan()); }
+            /** mean of second member of each pair **/
+            QuantityB mean_b() const { return unit_b_ * ((n_ > 0) ? mean_b_ : nan()); }
+
+            /** unbiased sample covariance.  NaN if fewer than 2 samples **/
+            covariance_type covariance() const {
+                return (unit_a_ * unit_b_) * ((n_ > 1) ? c_ / static_cast<repr_type>(n_ - 1) : nan());
+            }
+
+            /** sample correlation (dimensionless).  NaN if fewer than 2 samples **/
+            repr_type correlation() const {
+                return ((n_ > 1) ? c_ / ::sqrt(m2a_ * m2b_) : nan());
+            }
+
+            ///@}
+
+            /** @defgroup running-covariance-general-methods running_covariance general methods **/
+            ///@{
+
+            /** include sample pair (@p a, @p b) **/
+            void add(const QuantityA & a, const QuantityB & b) {
+                if (n_ == 0) {
+                    unit_a_ = a.unit_qty();
+                    unit_b_ = b.unit_qty();
+                }
+
+                repr_type x = detail::sample_scale(unit_a_, a);
+                repr_type y = detail::sample_scale(unit_b_, b);
+
+                ++n_;
+
+                repr_type dx = x - mean_a_;
+                mean_a_ += dx / static_cast<repr_type>(n_);
+                repr_type dy = y - mean_b_;
+                mean_b_ += dy / static_cast<repr_type>(n_);
+
+                m2a_ += dx * (x - mean_a_);
+                m2b_ += dy * (y - mean_b_);
+                c_ += dx * (y - mean_b_);
+            }
+
+            /** include all pairs (@p a_v[i], @p b_v[i])
+             *  @pre @p a_v.size() == @p b_v.size()
+             **/
+            void add(std::span<const QuantityA> a_v, std::span<const QuantityB> b_v) {
+                for (std::size_t i = 0, n = a_v.size(); i < n; ++i)
+                    this->add(a_v[i], b_v[i]);
+            }
+
+            /** include all sample pairs from @p other **/
+            void merge(const running_covariance & other) {
+                if (other.n_ == 0)
+                    return;
+
+                if (n_ == 0) {
+                    *this = other;
+                    return;
+                }
+
+                repr_type ka = detail::unit_factor(other.unit_a_, unit_a_);
+                repr_type kb = detail::unit_factor(other.unit_b_, unit_b_);
+
+                std::uint64_t n = n_ + other.n_;
+                repr_type na = static_cast<repr_type>(n_);
+                repr_type nb = static_cast<repr_type>(other.n_);
+                repr_type w = na * nb / static_cast<repr_type>(n);
+
+                repr_type dx = ka * other.mean_a_ - mean_a_;
+                repr_type dy = kb * other.mean_b_ - mean_b_;
+
+                mean_a_ += dx * (nb / static_cast<repr_type>(n));
+                mean_b_ += dy * (nb / static_cast<repr_type>(n));
+                m2a_ += ka * ka * other.m2a_ + dx * dx * w;
+                m2b_ += kb * kb * other.m2b_ + dy * dy * w;
+                c_ += ka * kb * other.c_ + dx * dy * w;
+                n_ = n;
+            }
+
+            ///@}
+
+        private:
+            static constexpr repr_type nan() { return std::numeric_limits<repr_type>::quiet_NaN(); }
+
+        private:
+            /** @defgroup running-covariance-instance-vars running_covariance instance variables **/
+            ///@{
+
+            /** unit for first member of each pair **/
+            QuantityA unit_a_ = QuantityA().unit_qty();
+            /** unit for second member of each pair **/
+            QuantityB unit_b_ = QuantityB().unit_qty();
+            /** number of sample pairs **/
+            std::uint64_t n_ = 0;
+            /** running mean of first members **/
+            repr_type mean_a_ = 0;
+            /** running mean of second members **/
+            repr_type mean_b_ = 0;
+            /** running sum of squared deviations,  first members **/
+            repr_type m2a_ = 0;
+            /** running sum of squared deviations,  second members **/
+            repr_type m2b_ = 0;
+            /** running co-moment **/
+            repr_type c_ = 0;
+
+            ///@}
+        }; /*running_covariance*/
+
+        /** @class running_ewma
+         *  @brief exponentially-weighted moving average over a stream of quantities.
+         *
+         *  Each sample @c x updates average @c m to @c m + alpha*(x-m).
+         *  Result depends on sample order,  so unlike @ref running_stats
+         *  there is no merge.
+         **/
+        template <typename Quantity>
+        requires quantity_concept<Quantity>
+        class running_ewma {
+        public:
+            using quantity_type = Quantity;
+            using repr_type = typename Quantity::repr_type;
+
+        public:
+            /** @p alpha: weight on each new sample,  in (0,1] **/
+            explicit running_ewma(repr_type alpha) : alpha_{alpha} {}
+
+            /** @defgroup running-ewma-access-methods running_ewma access methods **/
+            ///@{
+
+            /** weight on each new sample **/
+            repr_type alpha() const { return alpha_; }
+            /** number of samples **/
+            std::uint64_t count() const { return n_; }
+            /** current moving average.  NaN if empty **/
+            Quantity value() const {
+                return unit_ * ((n_ > 0) ? m_ : std::numeric_limits<repr_type>::quiet_NaN());
+            }
+
+            ///@}
+
+            /** @defgroup running-ewma-general-methods running_ewma general methods **/
+            ///@{
+
+            /** include sample @p x.  First sample initializes average **/
+            void add(const Quantity & x) {
+                if (n_ == 0) {
+                    unit_ = x.unit_qty();
+                    m_ = x.scale();
+                } else {
+                    m_ += alpha_ * (detail::sample_scale(unit_, x) - m_);
+                }
+
+                ++n_;
+            }
+
+            /** include all samples in @p x_v,  in order **/
+            void add(std::span<const Quantity> x_v) {
+                for (const auto & x : x_v)
+                    this->add(x);
+            }
+
+            ///@}
+
+        private:
+            /** @defgroup running-ewma-instance-vars running_ewma instance variables **/
+            ///@{
+
+            /** unit quantity;  @ref m_ is a multiple of this **/
+            Quantity unit_ = Quantity().unit_qty();
+            /** weight on each new sample **/
+            repr_type alpha_;
+            /** number of samples **/
+            std::uint64_t n_ = 0;
+            /** current average **/
+            repr_type m_ = 0;
+
+            ///@}
+        }; /*running_ewma*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end running_stats.hpp **/
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "width2x.hpp"
+#include <bit>
 
 namespace xo {
     namespace qty {
@@ -82,6 +83,23 @@ namespace xo {
                 return natural_unit_.lookup_dim(d);
             }
 
+            /** 64-bit fingerprint of this unit.
+             *  Extends @c natural_unit::fingerprint with outer scalefactors;
+             *  for a natural scaled unit (see @ref is_natural) the two agree.
+             **/
+            constexpr std::uint64_t fingerprint() const {
+                std::uint64_t h = natural_unit_.fingerprint();
+
+                if (this->is_natural())
+                    return h;
+
+                h = detail::fnv1a_step(h, static_cast<std::int64_t>(outer_scale_factor_.num()));
+                h = detail::fnv1a_step(h, static_cast<std::int64_t>(outer_scale_factor_.den()));
+                h = detail::fnv1a_step(h, std::bit_cast<std::uint64_t>(outer_scale_sq_));
+
+                return h;
+            }
+
             /** return @p i'th bpu associated with this unit **/
             constexpr bpu<Int> & operator[](std::size_t i) { return natural_unit_[i]; }
             /** return @p i'th bpu associated with this unit (const version) **/
@@ -106,7 +124,21 @@ namespace xo {
             ///@}
         };
 
-        // TODO: comparison operators
+        /** @defgroup scaled-unit-comparison-functions scaled-unit comparison functions **/
+        ///@{
+
+        /** compare scaled units @p x, @p y for equality **/
+        template <typename Int, typename OuterScale>
+        constexpr bool
+        operator==(const scaled_unit<Int, OuterScale> & x,
+                   const scaled_unit<Int, OuterScale> & y)
+        {
+            return ((x.outer_scale_factor_ == y.outer_scale_factor_)
+                    && (x.outer_scale_sq_ == y.outer_scale_sq_)
+                    && (x.natural_unit_ == y.natural_unit_));
+        }
+
+        ///@}
 
         namespace detail {
             /** promote natural unit to scaled unit (with unit outer scalefactors) **/
@@ -136,7 +168,7 @@ namespace xo {
             ///@{
 
             /** dimensionless unit; equivalent to 1 **/
-            constexpr auto dimensionless    = detail::su_promote(natural_unit<std::int64_t>());
+            inline constexpr auto dimensionless    = detail::su_promote(natural_unit<std::int64_t>());
 
             ///@}
 
@@ -146,25 +178,25 @@ namespace xo {
             ///@{
 
             /** unit of 10^-12 grams **/
-            constexpr auto picogram         = su_from_bu(detail::bu::picogram);
+            inline constexpr auto picogram         = su_from_bu(detail::bu::picogram);
             /** unit of 10^-9 grams **/
-            constexpr auto nanogram         = su_from_bu(detail::bu::nanogram);
+            inline constexpr auto nanogram         = su_from_bu(detail::bu::nanogram);
             /** unit of 10^-6 grams **/
-            constexpr auto microgram        = su_from_bu(detail::bu::microgram);
+            inline constexpr auto microgram        = su_from_bu(detail::bu::microgram);
             /** unit of 10^-3 grams **/
-            constexpr auto milligram        = su_from_bu(detail::bu::milligram);
+            inline constexpr auto milligram        = su_from_bu(detail::bu::milligram);
             /** unit of 1 gram **/
-            constexpr auto gram             = su_from_bu(detail::bu::gram);
+            inline constexpr auto gram             = su_from_bu(detail::bu::gram);
             /** unit of 10^3 grams **/
-            constexpr auto kilogram         = su_from_bu(detail::bu::kilogram);
+            inline constexpr auto kilogram         = su_from_bu(detail::bu::kilogram);
             /** unit of 1 metric tonne = 10^3 kg **/
-            constexpr auto tonne            = su_from_bu(detail::bu::tonne);
+            inline constexpr auto tonne            = su_from_bu(detail::bu::tonne);
             /** unit of 10^3 tonnes = 10^6 kg **/
-            constexpr auto kilotonne        = su_from_bu(detail::bu::kilotonne);
+            inline constexpr auto kilotonne        = su_from_bu(detail::bu::kilotonne);
             /** unit of 10^6 tonnes = 10^9 kg **/
-            constexpr auto megatonne        = su_from_bu(detail::bu::megatonne);
+            inline constexpr auto megatonne        = su_from_bu(detail::bu::megatonne);
             /** unit of 10^9 tonnes = 10^12 kg **/
-            constexpr auto gigatonne        = su_from_bu(detail::bu::gigatonne);
+            inline constexpr auto gigatonne        = su_from_bu(detail::bu::gigatonne);
 
             ///@}
 
@@ -174,35 +206,35 @@ namespace xo {
             ///@{
 
             /** unit of 10^-12 meters **/
-            constexpr auto picometer        = su_from_bu(detail::bu::picometer);
+            inline constexpr auto picometer        = su_from_bu(detail::bu::picometer);
             /** unit of 10^-9 meters **/
-            constexpr auto nanometer        = su_from_bu(detail::bu::nanometer);
+            inline constexpr auto nanometer        = su_from_bu(detail::bu::nanometer);
             /** unit of 10^-6 meters **/
-            constexpr auto micrometer       = su_from_bu(detail::bu::micrometer);
+            inline constexpr auto micrometer       = su_from_bu(detail::bu::micrometer);
             /** unit of 10^-3 meters **/
-            constexpr auto millimeter       = su_from_bu(detail::bu::millimeter);
+            inline constexpr auto millimeter       = su_from_bu(detail::bu::millimeter);
             /** unit of 1 meter **/
-            constexpr auto meter            = su_from_bu(detail::bu::meter);
+            inline constexpr auto meter            = su_from_bu(detail::bu::meter);
             /** unit of 10^3 meters **/
-            constexpr auto kilometer        = su_from_bu(detail::bu::kilometer);
+            inline constexpr auto kilometer        = su_from_bu(detail::bu::kilometer);
             /** unit of 10^6 meters (not commonly used) **/
-            constexpr auto megameter        = su_from_bu(detail::bu::megameter);
+            inline constexpr auto megameter        = su_from_bu(detail::bu::megameter);
             /** unit of 10^9 meters (not commonly used) **/
-            constexpr auto gigameter        = su_from_bu(detail::bu::gigameter);
+            inline constexpr auto gigameter        = su_from_bu(detail::bu::gigameter);
 
             /** unit of 1 light-second = distance light travels in a vacuum in 1 second **/
-            constexpr auto lightsecond      = su_from_bu(detail::bu::lightsecond);
+            inline constexpr auto lightsecond      = su_from_bu(detail::bu::lightsecond);
             /** unit of 1 astronomical unit, for approximate radius of earth orbit **/
-            constexpr auto astronomicalunit = su_from_bu(detail::bu::astronomicalunit);
+            inline constexpr auto astronomicalunit = su_from_bu(detail::bu::astronomicalunit);
 
             /** unit of 1 inch = 1/12 feet **/
-            constexpr auto inch             = su_from_bu(detail::bu::inch);
+            inline constexpr auto inch             = su_from_bu(detail::bu::inch);
             /** unit of 1 foot = 0.3048 meters **/
-            constexpr auto foot             = su_from_bu(detail::bu::foot);
+            inline constexpr auto foot             = su_from_bu(detail::bu::foot);
             /** unit of 1 yard = 3 feet **/
-            constexpr auto yard             = su_from_bu(detail::bu::yard);
+            inline constexpr auto yard             = su_from_bu(detail::bu::yard);
             /** unit of 1 mile = 1760 yards **/
-            constexpr auto mile             = su_from_bu(detail::bu::mile);
+            inline constexpr auto mile             = su_from_bu(detail::bu::mile);
 
             ///@}
 
@@ -212,35 +244,35 @@ namespace xo {
             ///@{
 
             /** unit of 1 picosecond = 10^-12 seconds **/
-            constexpr auto picosecond       = su_from_bu(detail::bu::picosecond);
+            inline constexpr auto picosecond       = su_from_bu(detail::bu::picosecond);
             /** unit of 1 nanosecond = 10^-9 seconds **/
-            constexpr auto nanosecond       = su_from_bu(detail::bu::nanosecond);
+            inline constexpr auto nanosecond       = su_from_bu(detail::bu::nanosecond);
             /** unit of 1 microseccond = 10^-6 seconds **/
-            constexpr auto microsecond      = su_from_bu(detail::bu::microsecond);
+            inline constexpr auto microsecond      = su_from_bu(detail::bu::microsecond);
             /** unit of 1 millisecond = 10^-3 seconds **/
-            constexpr auto millisecond      = su_from_bu(detail::bu::millisecond);
+            inline constexpr auto millisecond      = su_from_bu(detail::bu::millisecond);
             /** unit of 1 second **/
-            constexpr auto second           = su_from_bu(detail::bu::second);
+            inline constexpr auto second           = su_from_bu(detail::bu::second);
             /** unit of 1 minute **/
-            constexpr auto minute           = su_from_bu(detail::bu::minute);
+            inline constexpr auto minute           = su_from_bu(detail::bu::minute);
             /** unit of 1 hour **/
-            constexpr auto hour             = su_from_bu(detail::bu::hour);
+            inline constexpr auto hour             = su_from_bu(detail::bu::hour);
             /** unit for a 24-hour day **/
-            constexpr auto day              = su_from_bu(detail::bu::day);
+            inline constexpr auto day              = su_from_bu(detail::bu::day);
             /** unit for a week comprising exactly 7 24-hour days **/
-            constexpr auto week             = su_from_bu(detail::bu::week);
+            inline constexpr auto week             = su_from_bu(detail::bu::week);
             /** unit for a 30-day month **/
-            constexpr auto month            = su_from_bu(detail::bu::month);
+            inline constexpr auto month            = su_from_bu(detail::bu::month);
             /** unit for a year containing exactly 365.25 24-hour days **/
-            constexpr auto year             = su_from_bu(detail::bu::year);
+            inline constexpr auto year             = su_from_bu(detail::bu::year);
             /** unit for a 'year' containing exactly 250 24-hour days.
              *  (approximates the number of business days in a year)
              **/
-            constexpr auto year250          = su_from_bu(detail::bu::year250);
+            inline constexpr auto year250          = su_from_bu(detail::bu::year250);
             /** unit for a 'year' containing exactly 360 24-hour days **/
-            constexpr auto year360          = su_from_bu(detail::bu::year360);
+            inline constexpr auto year360          = su_from_bu(detail::bu::year360);
             /** unit for a 'year' containing exactly 365 24-hour days **/
-            constexpr auto year365          = su_from_bu(detail::bu::year365);
+            inline constexpr auto year365          = su_from_bu(detail::bu::year365);
 
             ///@}
 
@@ -250,13 +282,51 @@ namespace xo {
             // ----- currency -----
 
             /** generic currency unit **/
-            constexpr auto currency         = su_from_bu(detail::bu::currency);
+            inline constexpr auto currency         = su_from_bu(detail::bu::currency);
 
             // ----- price - ---
 
             /** generic price unit **/
-            constexpr auto price            = su_from_bu(detail::bu::price);
+            inline constexpr auto price            = su_from_bu(detail::bu::price);
+
+            ///@}
+
+            // ----- information units -----
+
+            /** @defgroup scaled-unit-information scaled-unit information units **/
+            ///@{
+
+            /** unit of 1 bit = 1/8 byte **/
+            inline constexpr auto bit              = su_from_bu(detail::bu::bit);
+            /** unit of 1 byte **/
+            inline constexpr auto byte             = su_from_bu(detail::bu::byte);
+            /** unit of 1 kilobyte = 10^3 bytes **/
+            inline constexpr auto kilobyte         = su_from_bu(detail::bu::kilobyte);
+            /** unit of 1 megabyte = 10^6 bytes **/
+            inline constexpr auto megabyte         = su_from_bu(detail::bu::megabyte);
+            /** unit of 1 gigabyte = 10^9 bytes **/
+            inline constexpr auto gigabyte         = su_from_bu(detail::bu::gigabyte);
+            /** unit of 1 terabyte = 10^12 bytes **/
+            inline constexpr auto terabyte         = su_from_bu(detail::bu::terabyte);
+            /** unit of 1 kibibyte = 2^10 bytes **/
+            inline constexpr auto kibibyte         = su_from_bu(detail::bu::kibibyte);
+            /** unit of 1 mebibyte = 2^20 bytes **/
+            inline constexpr auto mebibyte         = su_from_bu(detail::bu::mebibyte);
+            /** unit of 1 gibibyte = 2^30 bytes **/
+            inline constexpr auto gibibyte         = su_from_bu(detail::bu::gibibyte);
+            /** unit of 1 tebibyte = 2^40 bytes **/
+            inline constexpr auto tebibyte         = su_from_bu(detail::bu::tebibyte);
+            ///@}
+
+            // ----- packet, message units -----
+
+            /** @defgroup scaled-unit-count scaled-unit packet and message units **/
+            ///@{
 
+            /** unit of 1 network packet **/
+            inline constexpr auto packet           = su_from_bu(detail::bu::packet);
+            /** unit of 1 application message **/
+            inline constexpr auto message          = su_from_bu(detail::bu::message);
             ///@}
 
             // ----- volatility units -----
@@ -265,18 +335,37 @@ namespace xo {
             ///@{
 
             /** volatility, in 30-day units **/
-            constexpr auto volatility_30d   = su_from_bu(detail::bu::month,
+            inline constexpr auto volatility_30d   = su_from_bu(detail::bu::month,
                                                          power_ratio_type(-1,2));
             /** volatility, in 250-day 'annual' units **/
-            constexpr auto volatility_250d  = su_from_bu(detail::bu::year250,
+            inline constexpr auto volatility_250d  = su_from_bu(detail::bu::year250,
                                                          power_ratio_type(-1,2));
             /** volatility, in 360-day 'annual' units **/
-            constexpr auto volatility_360d  = su_from_bu(detail::bu::year360,
+            inline constexpr auto volatility_360d  = su_from_bu(detail::bu::year360,
                                                          power_ratio_type(-1,2));
             /** volatility, in 365-day 'annual' units **/
-            constexpr auto volatility_365d  = su_from_bu(detail::bu::year365,
+            inline constexpr auto volatility_365d  = su_from_bu(detail::bu::year365,
                                                          power_ratio_type(-1,2));
             ///@}
+
+            // ----- variance units -----
+
+            /** @defgroup scaled-unit-variance scaled-unit variance units **/
+            ///@{
+
+            /** variance, in 30-day units **/
+            inline constexpr auto variance_30d     = su_from_bu(detail::bu::month,
+                                                         power_ratio_type(-1));
+            /** variance, in 250-day 'annual' units **/
+            inline constexpr auto variance_250d    = su_from_bu(detail::bu::year250,
+                                                         power_ratio_type(-1));
+            /** variance, in 360-day 'annual' units **/
+            inline constexpr auto variance_360d    = su_from_bu(detail::bu::year360,
+                                                         power_ratio_type(-1));
+            /** variance, in 365-day 'annual' units **/
+            inline constexpr auto variance_365d    = su_from_bu(detail::bu::year365,
+                                                         power_ratio_type(-1));
+            ///@}
         }
 
         namespace detail {
@@ -349,6 +438,26 @@ namespace xo {
             }
         }
 
+        namespace detail {
+            /** @defgroup scaled-unit-memo memoized unit algebra
+             *
+             *  @ref su_product and @ref su_ratio for compile-time units,
+             *  as variable templates:  evaluated once per translation unit for each unit pair,
+             *  however many quantity types (e.g. with different @c Repr) share that pair.
+             **/
+            ///@{
+
+            /** su_product(NU1, NU2),  memoized **/
+            template <typename Int, typename Int2x, natural_unit<Int> NU1, natural_unit<Int> NU2>
+            inline constexpr auto su_product_v = su_product<Int, Int2x>(NU1, NU2);
+
+            /** su_ratio(NU1, NU2),  memoized **/
+            template <typename Int, typename Int2x, natural_unit<Int> NU1, natural_unit<Int> NU2>
+            inline constexpr auto su_ratio_v = su_ratio<Int, Int2x>(NU1, NU2);
+
+            ///@}
+        }
+
         /** @defgroup scaled-unit-operators **/
         ///@{
 
@@ -395,7 +504,46 @@ namespace xo {
         }
 
         ///@}
+
+        namespace u {
+            // ----- throughput units -----
+
+            /** @defgroup scaled-unit-throughput scaled-unit throughput units **/
+            ///@{
+
+            /** unit of 1 bit per second **/
+            inline constexpr auto bit_per_second      = bit / second;
+            /** unit of 1 byte per second **/
+            inline constexpr auto byte_per_second     = byte / second;
+            /** unit of 10^3 bytes per second **/
+            inline constexpr auto kilobyte_per_second = kilobyte / second;
+            /** unit of 10^6 bytes per second **/
+            inline constexpr auto megabyte_per_second = megabyte / second;
+            /** unit of 10^9 bytes per second **/
+            inline constexpr auto gigabyte_per_second = gigabyte / second;
+            /** unit of 2^20 bytes per second **/
+            inline constexpr auto mebibyte_per_second = mebibyte / second;
+            /** unit of 1 packet per second **/
+            inline constexpr auto packet_per_second   = packet / second;
+            /** unit of 1 message per second **/
+            inline constexpr auto message_per_second  = message / second;
+            /** unit of 1 byte per packet **/
+            inline constexpr auto byte_per_packet     = byte / packet;
+            /** unit of 1 byte per message **/
+            inline constexpr auto byte_per_message    = byte / message;
+            ///@}
+        } /*namespace u*/
     } /*namespace qty*/
 } /*namespace xo*/
 
+namespace std {
+    /** hash scaled units by @c scaled_unit::fingerprint **/
+    template <typename Int, typename OuterScale>
+    struct hash<xo::qty::scaled_unit<Int, OuterScale>> {
+        std::size_t operator()(const xo::qty::scaled_unit<Int, OuterScale> & x) const noexcept {
+            return static_cast<std::size_t>(x.fingerprint());
+        }
+    };
+} /*namespace std*/
+
 /** end scaled_unit.hpp **/
@@ -0,0 +1,211 @@
+/** @file schema_converter.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "quantity_member.hpp"
+#include "xquantity.hpp"
+#include <array>
+#include <algorithm>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <string_view>
+#include <type_traits>
+#include <cmath>
+
+namespace xo {
+    namespace qty {
+        /** @class schema_field
+         *  @brief one field of a runtime record schema: name and unit.
+         **/
+        struct schema_field {
+            /** field name **/
+            std::string_view name_;
+            /** unit in which field values are expressed **/
+            natural_unit<std::int64_t> unit_;
+        };
+
+        /** @class schema_converter
+         *  @brief convert records from a runtime source schema to compile-time struct @p Target.
+         *
+         *  @p Members are pointers to quantity members of @p Target,
+         *  each with a compile-time unit.  For example:
+         *  @code
+         *  struct fill {
+         *      quantity<u::millisecond> latency;
+         *      quantity<u::kilometer> distance;
+         *  };
+         *
+         *  schema_converter<fill, &fill::latency, &fill::distance> cvt;
+         *
+         *  schema_field src[] = { {"dist", nu::meter}, {"lat", nu::microsecond} };
+         *
+         *  cvt.compile(src, {"lat", "dist"});
+         *  cvt.convert(std::span<const double>(rows), std::span<fill>(out));
+         *  @endcode
+         *
+         *  @ref compile does all unit reasoning once per (source schema, target) pair:
+         *  matches fields by name,  checks dimensions,  and builds a flat table
+         *  of (source offset, multiplier) per target member.
+         *  @ref convert is then one fused pass over the batch:
+         *  per record,  one load + multiply + store per member,  with member dispatch
+         *  unrolled at compile time.
+         **/
+        template <typename Target, auto... Members>
+        requires (sizeof...(Members) > 0 && (detail::quantity_member<Target, Members> && ...))
+        class schema_converter {
+        public:
+            /** number of target fields **/
+            static constexpr std::size_t n_field = sizeof...(Members);
+
+            using unit_type = natural_unit<std::int64_t>;
+            using name_array_type = std::array<std::string_view, n_field>;
+
+        public:
+            schema_converter() = default;
+
+            /** @defgroup schema-converter-access-methods schema_converter access methods **/
+            ///@{
+
+            /** true after successful @ref compile **/
+            bool is_compiled() const { return stride_ > 0; }
+            /** number of values per source record **/
+            std::size_t stride() const { return stride_; }
+            /** after failed @ref compile: index of first target field that could not be bound **/
+            std::size_t error_field() const { return error_field_; }
+            /** position in source record of target field @p k **/
+            std::size_t source_index(std::size_t k) const { return src_ix_v_[k]; }
+            /** multiplier from source unit to target unit for target field @p k **/
+            double factor(std::size_t k) const { return factor_v_[k]; }
+
+            ///@}
+
+            /** @defgroup schema-converter-general-methods schema_converter general methods **/
+            ///@{
+
+            /** bind target fields (named by @p target_names,  in @p Members order)
+             *  to fields of source schema @p src.
+             *
+             *  @return false if some target name is missing from @p src,
+             *          or has a different dimension;  see @ref error_field
+             **/
+            bool compile(std::span<const schema_field> src,
+                         const name_array_type & target_names)
+            {
+                return this->compile_aux(src, target_names, std::make_index_sequence<n_field>());
+            }
+
+            /** convert row-major source records @p src (@ref stride values each)
+             *  into @p out.
+             *
+             *  @return number of records converted:
+             *          min(@p src.size() / @ref stride, @p out.size());
+             *          0 if not compiled.
+             **/
+            template <typename SrcRepr>
+            std::size_t convert(std::span<const SrcRepr> src, std::span<Target> out) const
+            {
+                if (stride_ == 0)
+                    return 0;
+
+                std::size_t n = std::min(src.size() / stride_, out.size());
+
+                this->convert_aux(src.data(), out.data(), n, std::make_index_sequence<n_field>());
+
+                return n;
+            }
+
+            ///@}
+
+        private:
+            static constexpr auto c_member_v = std::make_tuple(Members...);
+
+            template <std::size_t K>
+            using field_type = detail::member_type_t<std::get<K>(c_member_v)>;
+
+            /** convert source value @p x to target member @p K,  given multiplier @p f **/
+            template <std::size_t K, typename SrcRepr>
+            static field_type<K> make_field(SrcRepr x, double f) {
+                using repr_type = typename field_type<K>::repr_type;
+
+                if constexpr (std::is_integral_v<repr_type>)
+                    return field_type<K>(static_cast<repr_type>(std::llround(f * x)));
+                else
+                    return field_type<K>(static_cast<repr_type>(f * x));
+            }
+
+            template <std::size_t... K>
+            bool compile_aux(std::span<const schema_field> src,
+                             const name_array_type & target_names,
+                             std::index_sequence<K...>)
+            {
+                stride_ = 0;
+                error_field_ = n_field;
+
+                if ((this->compile_field<K>(src, target_names[K]) && ...)) {
+                    stride_ = src.size();
+                    return true;
+                }
+
+                return false;
+            }
+
+            template <std::size_t K>
+            bool compile_field(std::span<const schema_field> src, std::string_view name)
+            {
+                constexpr auto c_nu = field_type<K>::s_scaled_unit.natural_unit_.template to_repr<std::int64_t>();
+
+                for (std::size_t i = 0, n = src.size(); i < n; ++i) {
+                    if (src[i].name_ != name)
+                        continue;
+
+                    double f = ((src[i].unit_ == c_nu)
+                                ? 1.0
+                                : xquantity<double, std::int64_t>(1, src[i].unit_).rescale(c_nu).scale());
+
+                    /* rescale produces NaN on dimension mismatch */
+                    if (std::isnan(f))
+                        break;
+
+                    src_ix_v_[K] = i;
+                    factor_v_[K] = f;
+                    return true;
+                }
+
+                error_field_ = K;
+                return false;
+            }
+
+            template <typename SrcRepr, std::size_t... K>
+            void convert_aux(const SrcRepr * src, Target * out, std::size_t n,
+                             std::index_sequence<K...>) const
+            {
+                /* hoist table into locals,  so compiler can keep it in registers */
+                const std::size_t stride = stride_;
+                const std::array<std::size_t, n_field> ix_v = src_ix_v_;
+                const std::array<double, n_field> f_v = factor_v_;
+
+                for (std::size_t r = 0; r < n; ++r) {
+                    const SrcRepr * rec = src + r * stride;
+
+                    ((out[r].*(std::get<K>(c_member_v)) = make_field<K>(rec[ix_v[K]], f_v[K])), ...);
+                }
+            }
+
+        private:
+            /** values per source record;  0 until compiled **/
+            std::size_t stride_ = 0;
+            /** first unbound target field from last compile **/
+            std::size_t error_field_ = n_field;
+            /** src_ix_v_[k]: position in source record of target field k **/
+            std::array<std::size_t, n_field> src_ix_v_ = {};
+            /** factor_v_[k]: multiplier from source unit to target unit for field k **/
+            std::array<double, n_field> factor_v_ = {};
+        };
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end schema_converter.hpp **/
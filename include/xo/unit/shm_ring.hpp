@@ -0,0 +1,593 @@
+/** @file shm_ring.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "column_file.hpp"
+#include "quantity_member.hpp"
+#include "int_rescale.hpp"
+#include <atomic>
+#include <algorithm>
+#include <bit>
+#include <new>
+#include <array>
+#include <span>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            namespace shm {
+                /** segment layout:
+                 *  @code
+                 *  [header: c_header_bytes]
+                 *  [head index: c_line_bytes]    written by producer only
+                 *  [tail index: c_line_bytes]    written by consumer only
+                 *  [slots: capacity * elt_bytes]
+                 *  @endcode
+                 *
+                 *  header:
+                 *  @code
+                 *  ready:u64 byte_order:u32 n_field:u32 capacity:u64 elt_bytes:u32 pad[4]
+                 *  n_field * { offset:u32 repr:u8 unit (see detail::wire::put_unit) }
+                 *  @endcode
+                 *  @c ready is an atomic word,  0 until the header is complete.
+                 *  Producer stores @ref c_magic to it (release) after writing the rest of the header;
+                 *  consumer loads it (acquire) before reading the rest,
+                 *  so a consumer never sees a partial header.
+                 *
+                 *  Head and tail are free-running counters;  slot index is counter & (capacity - 1).
+                 **/
+                /** header ready word,  once header is published.  Bytes "xoqring" 0x01 when little-endian **/
+                constexpr std::uint64_t c_magic = 0x01676e6972716f78ull;
+                constexpr std::size_t c_ready_offset = 0;
+                constexpr std::size_t c_line_bytes = 64;
+                constexpr std::size_t c_header_bytes = 4096;
+                constexpr std::size_t c_fixed_bytes = 32;
+                /** max fields per element,  so that worst-case header fits **/
+                constexpr std::size_t c_max_field = 16;
+
+                static_assert(c_fixed_bytes + c_max_field * (4 + 1 + n_dim * wire::c_bpu_bytes + 8)
+                              <= c_header_bytes);
+                static_assert(std::atomic<std::uint64_t>::is_always_lock_free);
+
+                constexpr std::size_t c_head_offset = c_header_bytes;
+                constexpr std::size_t c_tail_offset = c_header_bytes + c_line_bytes;
+                constexpr std::size_t c_slot_offset = c_header_bytes + 2 * c_line_bytes;
+
+                /** description of one quantity field within a ring element **/
+                struct field_info {
+                    std::uint32_t offset_ = 0;
+                    colfile::repr_code repr_ = colfile::repr_code::invalid;
+                    natural_unit<std::int64_t> unit_;
+                };
+
+                /** @class element_layout
+                 *  @brief field layout of ring element type @p Elt.
+                 *
+                 *  Either @p Elt is itself a quantity (and @p Members is empty),
+                 *  or @p Members are pointers to quantity members of @p Elt.
+                 **/
+                template <typename Elt, auto... Members>
+                struct element_layout {
+                    static constexpr std::size_t n_field = sizeof...(Members);
+
+                    template <std::size_t K>
+                    using field_type = member_type_t<std::get<K>(std::make_tuple(Members...))>;
+
+                    template <std::size_t K>
+                    static field_info field() {
+                        constexpr auto c_member = std::get<K>(std::make_tuple(Members...));
+                        using repr_type = typename field_type<K>::repr_type;
+
+                        static const Elt s_elt{};
+
+                        field_info retval;
+                        retval.offset_ = (reinterpret_cast<const std::byte *>(&(s_elt.*c_member))
+                                          - reinterpret_cast<const std::byte *>(&s_elt));
+                        retval.repr_ = colfile::repr2code<repr_type>();
+                        retval.unit_ = field_type<K>::s_scaled_unit.natural_unit_.template to_repr<std::int64_t>();
+                        return retval;
+                    }
+
+                    template <std::size_t K>
+                    static auto & member(Elt & x) {
+                        return x.*(std::get<K>(std::make_tuple(Members...)));
+                    }
+
+                    static std::array<field_info, n_field> fields() {
+                        return fields_aux(std::make_index_sequence<n_field>());
+                    }
+
+                    template <std::size_t... K>
+                    static std::array<field_info, n_field> fields_aux(std::index_sequence<K...>) {
+                        return { field<K>()... };
+                    }
+                };
+
+                template <typename Elt>
+                struct element_layout<Elt> {
+                    static constexpr std::size_t n_field = 1;
+
+                    template <std::size_t K>
+                    using field_type = Elt;
+
+                    template <std::size_t K>
+                    static auto & member(Elt & x) { return x; }
+
+                    static std::array<field_info, 1> fields() {
+                        field_info fi;
+                        fi.offset_ = 0;
+                        fi.repr_ = colfile::repr2code<typename Elt::repr_type>();
+                        fi.unit_ = Elt::s_scaled_unit.natural_unit_.template to_repr<std::int64_t>();
+                        return { fi };
+                    }
+                };
+
+                /** true iff @p Elt can be carried by a ring using field list @p Members **/
+                template <typename Elt, auto... Members>
+                concept ring_element = (std::is_trivially_copyable_v<Elt>
+                                        && std::is_default_constructible_v<Elt>
+                                        && (sizeof...(Members) <= c_max_field)
+                                        && (((sizeof...(Members) == 0)
+                                             && quantity_concept<Elt>
+                                             && Elt::always_constexpr_unit)
+                                            || ((sizeof...(Members) > 0)
+                                                && (quantity_member<Elt, Members> && ...))));
+
+                /** @class segment
+                 *  @brief mapping of a named POSIX shared-memory segment
+                 **/
+                class segment {
+                public:
+                    segment() = default;
+                    segment(const segment &) = delete;
+                    segment & operator=(const segment &) = delete;
+                    ~segment() { this->close(); }
+
+                    std::byte * base() const { return base_; }
+                    std::size_t size() const { return z_; }
+
+                    std::atomic<std::uint64_t> & ready() const {
+                        return *reinterpret_cast<std::atomic<std::uint64_t> *>(base_ + c_ready_offset);
+                    }
+                    std::atomic<std::uint64_t> & head() const {
+                        return *reinterpret_cast<std::atomic<std::uint64_t> *>(base_ + c_head_offset);
+                    }
+                    std::atomic<std::uint64_t> & tail() const {
+                        return *reinterpret_cast<std::atomic<std::uint64_t> *>(base_ + c_tail_offset);
+                    }
+                    std::byte * slot(std::uint64_t i, std::size_t capacity, std::size_t elt_bytes) const {
+                        return base_ + c_slot_offset + (i & (capacity - 1)) * elt_bytes;
+                    }
+
+                    /** create (or truncate) segment @p name with size @p z **/
+                    bool create(const char * name, std::size_t z) {
+                        this->close();
+
+                        int fd = ::shm_open(name, O_CREAT | O_RDWR, 0600);
+
+                        if (fd < 0)
+                            return false;
+
+                        if ((::ftruncate(fd, 0) != 0) || (::ftruncate(fd, z) != 0)) {
+                            ::close(fd);
+                            return false;
+                        }
+
+                        return this->map(fd, z);
+                    }
+
+                    /** map existing segment @p name **/
+                    bool attach(const char * name) {
+                        this->close();
+
+                        int fd = ::shm_open(name, O_RDWR, 0);
+
+                        if (fd < 0)
+                            return false;
+
+                        struct stat st;
+
+                        if ((::fstat(fd, &st) != 0) || (static_cast<std::size_t>(st.st_size) < c_slot_offset)) {
+                            ::close(fd);
+                            return false;
+                        }
+
+                        return this->map(fd, st.st_size);
+                    }
+
+                    void close() {
+                        if (base_)
+                            ::munmap(base_, z_);
+
+                        base_ = nullptr;
+                        z_ = 0;
+                    }
+
+                private:
+                    bool map(int fd, std::size_t z) {
+                        void * base = ::mmap(nullptr, z, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+                        ::close(fd);
+
+                        if (base == MAP_FAILED)
+                            return false;
+
+                        base_ = static_cast<std::byte *>(base);
+                        z_ = z;
+                        return true;
+                    }
+
+                private:
+                    std::byte * base_ = nullptr;
+                    std::size_t z_ = 0;
+                };
+            } /*namespace shm*/
+        } /*namespace detail*/
+
+        /** @class shm_ring_writer
+         *  @brief producer end of a single-producer / single-consumer ring
+         *  of quantities in POSIX shared memory.
+         *
+         *  Element type @p Elt is either a quantity with compile-time unit,
+         *  or a trivially-copyable struct whose quantity members are listed in @p Members:
+         *  @code
+         *  struct quote { quantity<u::price> bid; quantity<u::price> ask; };
+         *
+         *  shm_ring_writer<quote, &quote::bid, &quote::ask> w;
+         *  w.create("/quotes", 4096);
+         *  w.try_push(quote{...});
+         *  @endcode
+         *
+         *  Segment header records offset,  representation and unit of each field,
+         *  so a reader can validate layout and convert units once at attach time
+         *  (see @ref shm_ring_reader).  Elements are copied into slots as raw bytes;
+         *  no serialization.
+         **/
+        template <typename Elt, auto... Members>
+        requires detail::shm::ring_element<Elt, Members...>
+        class shm_ring_writer {
+        public:
+            using layout_type = detail::shm::element_layout<Elt, Members...>;
+
+        public:
+            shm_ring_writer() = default;
+
+            /** @defgroup shm-ring-writer-access-methods shm_ring_writer access methods **/
+            ///@{
+
+            bool is_open() const { return seg_.base() != nullptr; }
+            std::size_t capacity() const { return capacity_; }
+
+            ///@}
+
+            /** @defgroup shm-ring-writer-general-methods shm_ring_writer general methods **/
+            ///@{
+
+            /** create segment @p name holding @p capacity elements.
+             *  @p capacity is rounded up to a power of 2.
+             *  @return false if segment cannot be created
+             **/
+            bool create(const char * name, std::size_t capacity) {
+                namespace sh = detail::shm;
+
+                capacity = std::bit_ceil(std::max<std::size_t>(capacity, 1));
+
+                if (!seg_.create(name, sh::c_slot_offset + capacity * sizeof(Elt)))
+                    return false;
+
+                std::byte * p = seg_.base();
+                auto field_v = layout_type::fields();
+
+                new (&seg_.ready()) std::atomic<std::uint64_t>(0);
+
+                std::memcpy(p + 8, &detail::colfile::c_byte_order, 4);
+                std::uint32_t n_field = field_v.size();
+                std::memcpy(p + 12, &n_field, 4);
+                std::uint64_t cap = capacity;
+                std::memcpy(p + 16, &cap, 8);
+                std::uint32_t elt_bytes = sizeof(Elt);
+                std::memcpy(p + 24, &elt_bytes, 4);
+
+                std::byte * q = p + sh::c_fixed_bytes;
+
+                for (const auto & fi : field_v) {
+                    std::memcpy(q, &fi.offset_, 4);
+                    q[4] = static_cast<std::byte>(fi.repr_);
+                    q = detail::wire::put_unit(q + 5, fi.unit_);
+                }
+
+                new (&seg_.head()) std::atomic<std::uint64_t>(0);
+                new (&seg_.tail()) std::atomic<std::uint64_t>(0);
+
+                /* publish header */
+                seg_.ready().store(sh::c_magic, std::memory_order_release);
+
+                capacity_ = capacity;
+                head_ = 0;
+                tail_cache_ = 0;
+
+                return true;
+            }
+
+            /** append @p x,  unless ring is full.  @return true if appended **/
+            bool try_push(const Elt & x) {
+                if (head_ - tail_cache_ == capacity_) {
+                    tail_cache_ = seg_.tail().load(std::memory_order_acquire);
+
+                    if (head_ - tail_cache_ == capacity_)
+                        return false;
+                }
+
+                std::memcpy(seg_.slot(head_, capacity_, sizeof(Elt)), &x, sizeof(Elt));
+
+                ++head_;
+                seg_.head().store(head_, std::memory_order_release);
+
+                return true;
+            }
+
+            /** append prefix of @p v,  as much as fits;  publishes once.
+             *  @return number of elements appended
+             **/
+            std::size_t push(std::span<const Elt> v) {
+                std::size_t room = capacity_ - (head_ - tail_cache_);
+
+                if (room < v.size()) {
+                    tail_cache_ = seg_.tail().load(std::memory_order_acquire);
+                    room = capacity_ - (head_ - tail_cache_);
+                }
+
+                std::size_t n = std::min(room, v.size());
+
+                for (std::size_t i = 0; i < n; ++i)
+                    std::memcpy(seg_.slot(head_ + i, capacity_, sizeof(Elt)), &v[i], sizeof(Elt));
+
+                head_ += n;
+                seg_.head().store(head_, std::memory_order_release);
+
+                return n;
+            }
+
+            /** unmap segment (does not remove it;  see @ref unlink) **/
+            void close() { seg_.close(); capacity_ = 0; }
+
+            /** remove segment @p name from the system **/
+            static bool unlink(const char * name) { return ::shm_unlink(name) == 0; }
+
+            ///@}
+
+        private:
+            detail::shm::segment seg_;
+            std::size_t capacity_ = 0;
+            /** producer-private copy of head index **/
+            std::uint64_t head_ = 0;
+            /** last observed tail index **/
+            std::uint64_t tail_cache_ = 0;
+        };
+
+        /** @class shm_ring_reader
+         *  @brief consumer end of a ring created by @ref shm_ring_writer.
+         *
+         *  Reader's element type may use different units from writer's,
+         *  provided dimensions and representations agree field-by-field (in @p Members order).
+         *  Multipliers are computed once,  at attach time.
+         *  When every field matches exactly,  elements are copied as raw bytes.
+         **/
+        template <typename Elt, auto... Members>
+        requires detail::shm::ring_element<Elt, Members...>
+        class shm_ring_reader {
+        public:
+            using layout_type = detail::shm::element_layout<Elt, Members...>;
+            static constexpr std::size_t n_field = layout_type::n_field;
+
+        public:
+            shm_ring_reader() = default;
+
+            /** @defgroup shm-ring-reader-access-methods shm_ring_reader access methods **/
+            ///@{
+
+            bool is_open() const { return seg_.base() != nullptr; }
+            std::size_t capacity() const { return capacity_; }
+            /** true iff writer layout and units match reader exactly **/
+            bool is_identity() const { return identity_; }
+            /** multiplier from writer unit to reader unit,  for field @p k **/
+            double factor(std::size_t k) const { return factor_v_[k]; }
+            /** number of elements available to read **/
+            std::size_t size() const {
+                return seg_.head().load(std::memory_order_acquire) - tail_;
+            }
+
+            ///@}
+
+            /** @defgroup shm-ring-reader-general-methods shm_ring_reader general methods **/
+            ///@{
+
+            /** attach to segment @p name.
+             *  @return false if segment missing or not initialized,
+             *          or writer fields do not correspond to reader fields
+             *          (count,  representation or dimension)
+             **/
+            bool attach(const char * name) {
+                namespace sh = detail::shm;
+
+                this->close();
+
+                if (!seg_.attach(name))
+                    return false;
+
+                if (!this->validate()) {
+                    this->close();
+                    return false;
+                }
+
+                tail_ = seg_.tail().load(std::memory_order_relaxed);
+                head_cache_ = tail_;
+
+                return true;
+            }
+
+            /** read next element into @p *p_x.  @return false if ring empty **/
+            bool try_pop(Elt * p_x) {
+                if (head_cache_ == tail_) {
+                    head_cache_ = seg_.head().load(std::memory_order_acquire);
+
+                    if (head_cache_ == tail_)
+                        return false;
+                }
+
+                this->read_slot(seg_.slot(tail_, capacity_, elt_bytes_), p_x);
+
+                ++tail_;
+                seg_.tail().store(tail_, std::memory_order_release);
+
+                return true;
+            }
+
+            /** read up to @p v.size() elements into @p v;  releases slots once.
+             *  @return number of elements read
+             **/
+            std::size_t pop(std::span<Elt> v) {
+                head_cache_ = seg_.head().load(std::memory_order_acquire);
+
+                std::size_t n = std::min<std::size_t>(head_cache_ - tail_, v.size());
+
+                for (std::size_t i = 0; i < n; ++i)
+                    this->read_slot(seg_.slot(tail_ + i, capacity_, elt_bytes_), &v[i]);
+
+                tail_ += n;
+                seg_.tail().store(tail_, std::memory_order_release);
+
+                return n;
+            }
+
+            void close() { seg_.close(); capacity_ = 0; }
+
+            ///@}
+
+        private:
+            bool validate() {
+                namespace sh = detail::shm;
+
+                const std::byte * p = seg_.base();
+
+                if (seg_.ready().load(std::memory_order_acquire) != sh::c_magic)
+                    return false;
+
+                std::uint32_t byte_order = 0;
+                std::uint32_t n = 0;
+                std::uint64_t cap = 0;
+                std::uint32_t elt_bytes = 0;
+
+                std::memcpy(&byte_order, p + 8, 4);
+                std::memcpy(&n, p + 12, 4);
+                std::memcpy(&cap, p + 16, 8);
+                std::memcpy(&elt_bytes, p + 24, 4);
+
+                if ((byte_order != detail::colfile::c_byte_order)
+                    || (n != n_field)
+                    || (cap == 0) || ((cap & (cap - 1)) != 0)
+                    || (sh::c_slot_offset + cap * elt_bytes > seg_.size()))
+                    return false;
+
+                auto field_v = layout_type::fields();
+
+                identity_ = (elt_bytes == sizeof(Elt));
+
+                std::size_t pos = sh::c_fixed_bytes;
+
+                for (std::size_t k = 0; k < n_field; ++k) {
+                    sh::field_info wfi;
+
+                    std::memcpy(&wfi.offset_, p + pos, 4);
+                    wfi.repr_ = static_cast<detail::colfile::repr_code>(p[pos + 4]);
+
+                    std::size_t uz = detail::wire::get_unit(std::span<const std::byte>(p + pos + 5,
+                                                                                       sh::c_header_bytes - pos - 5),
+                                                            &wfi.unit_);
+
+                    if ((uz == 0)
+                        || (wfi.repr_ != field_v[k].repr_)
+                        || (wfi.offset_ + detail::colfile::repr_bytes(wfi.repr_) > elt_bytes))
+                        return false;
+
+                    double f = ((wfi.unit_ == field_v[k].unit_)
+                                ? 1.0
+                                : xquantity<double, std::int64_t>(1, wfi.unit_).rescale(field_v[k].unit_).scale());
+
+                    /* rescale produces NaN on dimension mismatch */
+                    if (std::isnan(f))
+                        return false;
+
+                    woffset_v_[k] = wfi.offset_;
+                    factor_v_[k] = f;
+                    int_rescale_v_[k] = detail::int_rescale<std::int64_t>(f);
+                    identity_ = identity_ && (f == 1.0) && (wfi.offset_ == field_v[k].offset_);
+
+                    pos += 5 + uz;
+                }
+
+                capacity_ = cap;
+                elt_bytes_ = elt_bytes;
+
+                return true;
+            }
+
+            void read_slot(const std::byte * src, Elt * p_x) const {
+                if (identity_)
+                    std::memcpy(p_x, src, sizeof(Elt));
+                else
+                    this->convert_slot(src, p_x, std::make_index_sequence<n_field>());
+            }
+
+            template <std::size_t... K>
+            void convert_slot(const std::byte * src, Elt * p_x, std::index_sequence<K...>) const {
+                (this->convert_field<K>(src, p_x), ...);
+            }
+
+            template <std::size_t K>
+            void convert_field(const std::byte * src, Elt * p_x) const {
+                using field_type = typename layout_type::template field_type<K>;
+                using repr_type = typename field_type::repr_type;
+
+                repr_type x;
+                std::memcpy(&x, src + woffset_v_[K], sizeof(repr_type));
+
+                if constexpr (std::is_integral_v<repr_type>)
+                    layout_type::template member<K>(*p_x) = field_type(static_cast<repr_type>(int_rescale_v_[K](x)));
+                else
+                    layout_type::template member<K>(*p_x) = field_type(static_cast<repr_type>(factor_v_[K] * x));
+            }
+
+        private:
+            detail::shm::segment seg_;
+            std::size_t capacity_ = 0;
+            std::size_t elt_bytes_ = 0;
+            /** consumer-private copy of tail index **/
+            std::uint64_t tail_ = 0;
+            /** last observed head index **/
+            std::uint64_t head_cache_ = 0;
+            /** true iff slots can be copied verbatim **/
+            bool identity_ = false;
+            /** woffset_v_[k]: offset of field k in writer element **/
+            std::array<std::uint32_t, n_field> woffset_v_ = {};
+            /** factor_v_[k]: multiplier from writer unit to reader unit for field k **/
+            std::array<double, n_field> factor_v_ = {};
+            /** int_rescale_v_[k]: same as factor_v_[k],  for integer fields **/
+            std::array<detail::int_rescale<std::int64_t>, n_field> int_rescale_v_;
+        };
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end shm_ring.hpp **/
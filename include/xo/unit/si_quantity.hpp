@@ -0,0 +1,231 @@
+/** @file si_quantity.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "rescale_column.hpp"
+#include <compare>
+#include <type_traits>
+
+namespace xo {
+    namespace qty {
+        /** @class si_quantity
+         *  @brief quantity stored in native units;  @p DisplayUnit annotates IO only.
+         *
+         *  The stored value is always a multiple of the native unit
+         *  (scalefactor 1) of each dimension,  e.g. meters and seconds.
+         *  Conversion happens on construction from a @c quantity,
+         *  and on output (@ref display, @ref as);
+         *  addition,  subtraction and comparison between any si_quantities
+         *  of the same dimension are plain @p Repr operations,
+         *  as are multiplication and division (product of native units is native).
+         *
+         *  @code
+         *  si_quantity<u::millisecond> t1 = qty::microseconds(250.0);
+         *  si_quantity<u::second> t2 = qty::seconds(1.0);
+         *
+         *  auto t = t1 + t2;             // one add; displays in ms
+         *  t.display();                  // quantity<u::millisecond>(1000.25)
+         *  bool lt = (t1 < t2);          // one compare
+         *  @endcode
+         *
+         *  Conversion rounds once on the way in and once on the way out.
+         *  With integer @p Repr,  values are rounded to whole native units
+         *  (e.g. whole seconds),  so prefer a floating-point @p Repr.
+         **/
+        template <auto DisplayUnit, typename Repr = double>
+        requires (DisplayUnit.is_natural())
+        class si_quantity {
+        public:
+            /** @defgroup si-quantity-type-traits si_quantity type traits **/
+            ///@{
+            using repr_type = Repr;
+            using ratio_int_type = typename decltype(DisplayUnit)::ratio_int_type;
+            ///@}
+
+            /** @defgroup si-quantity-constants si_quantity constants **/
+            ///@{
+            /** unit used for output **/
+            static constexpr auto s_display_unit = DisplayUnit;
+            /** unit of stored value **/
+            static constexpr auto s_native_unit = detail::su_promote<ratio_int_type>(detail::native_nu(DisplayUnit.natural_unit_));
+            ///@}
+
+            using display_type = quantity<DisplayUnit, Repr>;
+            using native_type = quantity<s_native_unit, Repr>;
+
+        public:
+            /** @defgroup si-quantity-ctors si_quantity constructors **/
+            ///@{
+
+            constexpr si_quantity() = default;
+
+            /** convert quantity @p x (any unit with the same dimension) to native units **/
+            template <typename Quantity>
+            requires (quantity_concept<Quantity> && Quantity::always_constexpr_unit)
+            constexpr si_quantity(const Quantity & x)
+                : native_scale_{detail::scale_in<s_native_unit, Repr>(x)} {}
+
+            /** convert si_quantity with another display unit;  no arithmetic **/
+            template <auto DisplayUnit2, typename Repr2>
+            requires (detail::same_dimension_v<DisplayUnit, DisplayUnit2>)
+            constexpr si_quantity(const si_quantity<DisplayUnit2, Repr2> & x)
+                : native_scale_{static_cast<Repr>(x.native_scale())} {}
+
+            /** si_quantity with native value @p x **/
+            static constexpr si_quantity from_native(Repr x) {
+                si_quantity retval;
+                retval.native_scale_ = x;
+                return retval;
+            }
+
+            ///@}
+
+            /** @defgroup si-quantity-access-methods si_quantity access methods **/
+            ///@{
+
+            /** stored value,  as a multiple of @ref s_native_unit **/
+            constexpr Repr native_scale() const { return native_scale_; }
+            /** stored value as a quantity in native units (no arithmetic) **/
+            constexpr native_type native() const { return native_type(native_scale_); }
+            /** value in display unit **/
+            constexpr display_type display() const { return this->as<DisplayUnit>(); }
+
+            /** value in unit @p ScaledUnit2.  One multiply (compile-time factor) **/
+            template <auto ScaledUnit2, typename Repr2 = Repr>
+            constexpr quantity<ScaledUnit2, Repr2> as() const {
+                return quantity<ScaledUnit2, Repr2>(detail::scale_in<ScaledUnit2, Repr2>(this->native()));
+            }
+
+            ///@}
+
+            /** @defgroup si-quantity-arithmetic si_quantity arithmetic **/
+            ///@{
+
+            constexpr si_quantity operator-() const { return from_native(-native_scale_); }
+
+            template <auto DisplayUnit2, typename Repr2>
+            requires (detail::same_dimension_v<DisplayUnit, DisplayUnit2>)
+            constexpr si_quantity & operator+=(const si_quantity<DisplayUnit2, Repr2> & x) {
+                native_scale_ += x.native_scale();
+                return *this;
+            }
+
+            template <auto DisplayUnit2, typename Repr2>
+            requires (detail::same_dimension_v<DisplayUnit, DisplayUnit2>)
+            constexpr si_quantity & operator-=(const si_quantity<DisplayUnit2, Repr2> & x) {
+                native_scale_ -= x.native_scale();
+                return *this;
+            }
+
+            ///@}
+
+        private:
+            /** value as multiple of @ref s_native_unit **/
+            Repr native_scale_ = 0;
+        };
+
+        /** @defgroup si-quantity-operators si_quantity operators
+         *
+         *  Sum and difference take the left operand's display unit;
+         *  product and quotient take the product/quotient of display units.
+         **/
+        ///@{
+
+        template <auto D1, typename R1, auto D2, typename R2>
+        requires (detail::same_dimension_v<D1, D2>)
+        constexpr auto
+        operator+ (const si_quantity<D1, R1> & x, const si_quantity<D2, R2> & y)
+        {
+            using repr_type = std::common_type_t<R1, R2>;
+
+            return si_quantity<D1, repr_type>::from_native(x.native_scale() + y.native_scale());
+        }
+
+        template <auto D1, typename R1, auto D2, typename R2>
+        requires (detail::same_dimension_v<D1, D2>)
+        constexpr auto
+        operator- (const si_quantity<D1, R1> & x, const si_quantity<D2, R2> & y)
+        {
+            using repr_type = std::common_type_t<R1, R2>;
+
+            return si_quantity<D1, repr_type>::from_native(x.native_scale() - y.native_scale());
+        }
+
+        template <auto D1, typename R1, auto D2, typename R2>
+        constexpr auto
+        operator* (const si_quantity<D1, R1> & x, const si_quantity<D2, R2> & y)
+        {
+            using repr_type = std::common_type_t<R1, R2>;
+            using int_type = typename decltype(D1)::ratio_int_type;
+
+            constexpr auto d = detail::su_promote<int_type>(detail::su_product_v<int_type, detail::width2x_t<int_type>,
+                                                                                 D1.natural_unit_, D2.natural_unit_>.natural_unit_);
+
+            return si_quantity<d, repr_type>::from_native(x.native_scale() * y.native_scale());
+        }
+
+        template <auto D1, typename R1, auto D2, typename R2>
+        constexpr auto
+        operator/ (const si_quantity<D1, R1> & x, const si_quantity<D2, R2> & y)
+        {
+            using repr_type = std::common_type_t<R1, R2>;
+            using int_type = typename decltype(D1)::ratio_int_type;
+
+            constexpr auto d = detail::su_promote<int_type>(detail::su_ratio_v<int_type, detail::width2x_t<int_type>,
+                                                                               D1.natural_unit_, D2.natural_unit_>.natural_unit_);
+
+            return si_quantity<d, repr_type>::from_native(x.native_scale() / y.native_scale());
+        }
+
+        template <auto D1, typename R1, typename Dimensionless>
+        requires std::is_arithmetic_v<Dimensionless>
+        constexpr auto
+        operator* (const si_quantity<D1, R1> & x, Dimensionless y)
+        {
+            using repr_type = std::common_type_t<R1, Dimensionless>;
+
+            return si_quantity<D1, repr_type>::from_native(x.native_scale() * y);
+        }
+
+        template <auto D1, typename R1, typename Dimensionless>
+        requires std::is_arithmetic_v<Dimensionless>
+        constexpr auto
+        operator* (Dimensionless x, const si_quantity<D1, R1> & y)
+        {
+            return y * x;
+        }
+
+        template <auto D1, typename R1, typename Dimensionless>
+        requires std::is_arithmetic_v<Dimensionless>
+        constexpr auto
+        operator/ (const si_quantity<D1, R1> & x, Dimensionless y)
+        {
+            using repr_type = std::common_type_t<R1, Dimensionless>;
+
+            return si_quantity<D1, repr_type>::from_native(x.native_scale() / y);
+        }
+
+        template <auto D1, typename R1, auto D2, typename R2>
+        requires (detail::same_dimension_v<D1, D2>)
+        constexpr bool
+        operator== (const si_quantity<D1, R1> & x, const si_quantity<D2, R2> & y)
+        {
+            return x.native_scale() == y.native_scale();
+        }
+
+        template <auto D1, typename R1, auto D2, typename R2>
+        requires (detail::same_dimension_v<D1, D2>)
+        constexpr auto
+        operator<=> (const si_quantity<D1, R1> & x, const si_quantity<D2, R2> & y)
+        {
+            return x.native_scale() <=> y.native_scale();
+        }
+
+        ///@}
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end si_quantity.hpp **/
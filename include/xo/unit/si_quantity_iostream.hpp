@@ -0,0 +1,27 @@
+/** @file si_quantity_iostream.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "si_quantity.hpp"
+#include "quantity_iostream.hpp"
+
+namespace xo {
+    namespace qty {
+        /** print @p x in its display unit **/
+        template < auto DisplayUnit, typename Repr >
+        inline std::ostream &
+        operator<< (std::ostream & os,
+                    const si_quantity<DisplayUnit, Repr> & x)
+        {
+            os << x.display();
+            return os;
+        }
+
+    } /*namespace qty*/
+
+} /*namespace xo*/
+
+/** end si_quantity_iostream.hpp **/
@@ -0,0 +1,131 @@
+/** @file throughput.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "rescale_column.hpp"
+
+namespace xo {
+    namespace qty {
+        /** @defgroup throughput throughput helpers **/
+        ///@{
+
+        /** rate at which amount @p count accrued over elapsed time @p dt,
+         *  expressed in @p RateUnit.
+         *
+         *  Conversion factor from (count unit / time unit) to @p RateUnit
+         *  is a compile-time constant;  cost is one multiply and one divide.
+         *
+         *  @code
+         *  auto r = throughput<u::megabyte_per_second>(qty::bytes(std::int64_t(n)),
+         *                                              qty::nanoseconds(std::int64_t(dt)));
+         *  @endcode
+         **/
+        template <auto RateUnit, typename Repr = double, typename CountQuantity, typename TimeQuantity>
+        requires (quantity_concept<CountQuantity> && CountQuantity::always_constexpr_unit
+                  && quantity_concept<TimeQuantity> && TimeQuantity::always_constexpr_unit)
+        constexpr quantity<RateUnit, Repr>
+        throughput(const CountQuantity & count, const TimeQuantity & dt)
+        {
+            constexpr auto k = detail::rescale_factor<CountQuantity::s_scaled_unit / TimeQuantity::s_scaled_unit,
+                                                      RateUnit,
+                                                      double>();
+
+            return quantity<RateUnit, Repr>(static_cast<Repr>(k * static_cast<double>(count.scale())
+                                                              / static_cast<double>(dt.scale())));
+        }
+
+        ///@}
+
+        /** @class throughput_meter
+         *  @brief rate of a monotone counter (bytes sent,  messages received ..)
+         *  between successive samples.
+         *
+         *  @tparam CountQuantity  quantity type for counter values,  e.g. @c quantity<u::byte,std::int64_t>
+         *  @tparam TimeQuantity   quantity type for timestamps,  e.g. @c quantity<u::nanosecond,std::int64_t>
+         *  @tparam RateUnit       unit for reported rate;  defaults to count unit per second
+         *
+         *  Packets and messages have their own dimensions,
+         *  so e.g. a message counter (@c quantity<u::message,std::int64_t>)
+         *  reports @c u::message_per_second,  and can't be mixed up with a packet or byte rate.
+         **/
+        template <typename CountQuantity = quantity<u::byte, std::int64_t>,
+                  typename TimeQuantity = quantity<u::nanosecond, std::int64_t>,
+                  auto RateUnit = CountQuantity::s_scaled_unit / u::second>
+        requires (quantity_concept<CountQuantity> && CountQuantity::always_constexpr_unit
+                  && quantity_concept<TimeQuantity> && TimeQuantity::always_constexpr_unit)
+        class throughput_meter {
+        public:
+            using count_type = CountQuantity;
+            using time_type = TimeQuantity;
+            using rate_type = quantity<RateUnit, double>;
+
+        public:
+            throughput_meter() = default;
+
+            /** @defgroup throughput-meter-access-methods throughput_meter access methods **/
+            ///@{
+
+            /** number of samples seen **/
+            std::size_t n_sample() const { return n_sample_; }
+            /** rate between last two samples **/
+            const rate_type & rate() const { return rate_; }
+            /** rate from first to last sample **/
+            rate_type mean_rate() const {
+                if (n_sample_ < 2)
+                    return rate_type();
+
+                return throughput<RateUnit>(count_type(count_.scale() - count0_.scale()),
+                                            time_type(t_.scale() - t0_.scale()));
+            }
+
+            ///@}
+
+            /** @defgroup throughput-meter-general-methods throughput_meter general methods **/
+            ///@{
+
+            /** record counter value @p count at time @p t.
+             *  Ignores samples that do not advance time.
+             *
+             *  @return rate since previous sample (zero for first sample)
+             **/
+            const rate_type & sample(const count_type & count, const time_type & t) {
+                if (n_sample_ == 0) {
+                    count0_ = count;
+                    t0_ = t;
+                } else if (t.scale() > t_.scale()) {
+                    rate_ = throughput<RateUnit>(count_type(count.scale() - count_.scale()),
+                                                 time_type(t.scale() - t_.scale()));
+                } else {
+                    return rate_;
+                }
+
+                count_ = count;
+                t_ = t;
+                ++n_sample_;
+
+                return rate_;
+            }
+
+            ///@}
+
+        private:
+            /** number of samples recorded **/
+            std::size_t n_sample_ = 0;
+            /** counter value at first sample **/
+            count_type count0_;
+            /** time of first sample **/
+            time_type t0_;
+            /** counter value at last sample **/
+            count_type count_;
+            /** time of last sample **/
+            time_type t_;
+            /** rate between last two samples **/
+            rate_type rate_;
+        };
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end throughput.hpp **/
@@ -0,0 +1,263 @@
+/** @file unit_instrument.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "unit_instrument_hook.hpp"
+#include <source_location>
+#include <ostream>
+#include <iostream>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <algorithm>
+#include <cstring>
+#include <cstdint>
+
+namespace xo {
+    namespace qty {
+        namespace instrument {
+            /** kinds of runtime unit work **/
+            enum class op : std::uint8_t {
+                rescale,
+                su_ratio,
+                su_product,
+                dim_mismatch,
+                sqrt,
+                /** not an op: number of op values **/
+                n_op
+            };
+
+            inline const char *
+            op2str(op x) {
+                switch (x) {
+                case op::rescale: return "rescale";
+                case op::su_ratio: return "su_ratio";
+                case op::su_product: return "su_product";
+                case op::dim_mismatch: return "dim_mismatch";
+                case op::sqrt: return "sqrt";
+                case op::n_op: break;
+                }
+
+                return "?op";
+            }
+
+            /** counts for one instrumented site **/
+            struct site_stats {
+                /** source file **/
+                const char * file_ = nullptr;
+                /** enclosing function **/
+                const char * function_ = nullptr;
+                /** source line **/
+                std::uint32_t line_ = 0;
+                /** kind of unit work **/
+                op op_ = op::n_op;
+                /** number of times executed **/
+                std::uint64_t count_ = 0;
+                /** most recent conversion factor applied (NaN for dimension mismatch) **/
+                double factor_ = 0.0;
+            };
+        } /*namespace instrument*/
+
+        namespace detail {
+            /** @class instrument_registry
+             *  @brief fixed-capacity lock-free table of per-site counters.
+             *
+             *  Open addressing on a hash of (file, line, column, function, op).
+             *  Site strings come from @c std::source_location,  so are never copied.
+             *  Sites beyond capacity are counted in @ref n_overflow.
+             **/
+            class instrument_registry {
+            public:
+                static constexpr std::size_t c_n_slot = 4096;
+
+            public:
+                ~instrument_registry() {
+                    if (dump_at_exit_.load(std::memory_order_relaxed))
+                        this->dump(std::cerr);
+                }
+
+                static instrument_registry & instance() {
+                    static instrument_registry s_instance;
+
+                    return s_instance;
+                }
+
+                std::uint64_t n_overflow() const { return n_overflow_.load(std::memory_order_relaxed); }
+
+                void set_dump_at_exit(bool x) { dump_at_exit_.store(x, std::memory_order_relaxed); }
+
+                void record(instrument::op kind, const std::source_location & loc, double factor) {
+                    std::uint64_t key = site_key(kind, loc);
+
+                    for (std::size_t probe = 0; probe < c_n_slot; ++probe) {
+                        slot & s = slot_v_[(key + probe) & (c_n_slot - 1)];
+                        std::uint64_t k = s.key_.load(std::memory_order_acquire);
+
+                        if (k == 0) {
+                            if (s.key_.compare_exchange_strong(k, key, std::memory_order_acq_rel)) {
+                                s.file_ = loc.file_name();
+                                s.function_ = loc.function_name();
+                                s.line_ = loc.line();
+                                s.op_ = kind;
+                                s.ready_.store(true, std::memory_order_release);
+
+                                k = key;
+                            }
+                        }
+
+                        if (k == key) {
+                            s.count_.fetch_add(1, std::memory_order_relaxed);
+                            s.factor_.store(factor, std::memory_order_relaxed);
+                            return;
+                        }
+                    }
+
+                    n_overflow_.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                /** per-site counts,  busiest first.
+                 *  Merges sites with identical location
+                 *  (a header's @c __FILE__ string may differ by address across translation units)
+                 **/
+                std::vector<instrument::site_stats> snapshot() const {
+                    std::vector<instrument::site_stats> retval;
+
+                    for (const slot & s : slot_v_) {
+                        if (!s.ready_.load(std::memory_order_acquire))
+                            continue;
+
+                        instrument::site_stats x{s.file_, s.function_, s.line_, s.op_,
+                                                 s.count_.load(std::memory_order_relaxed),
+                                                 s.factor_.load(std::memory_order_relaxed)};
+
+                        if (x.count_ == 0)
+                            continue;
+
+                        auto ix = std::find_if(retval.begin(), retval.end(),
+                                               [&x](const instrument::site_stats & y) {
+                                                   return ((x.line_ == y.line_)
+                                                           && (x.op_ == y.op_)
+                                                           && (std::strcmp(x.file_, y.file_) == 0)
+                                                           && (std::strcmp(x.function_, y.function_) == 0));
+                                               });
+
+                        if (ix == retval.end())
+                            retval.push_back(x);
+                        else
+                            ix->count_ += x.count_;
+                    }
+
+                    std::sort(retval.begin(), retval.end(),
+                              [](const instrument::site_stats & x, const instrument::site_stats & y) {
+                                  return x.count_ > y.count_;
+                              });
+
+                    return retval;
+                }
+
+                void dump(std::ostream & os) const {
+                    auto v = this->snapshot();
+
+                    os << "xo-unit instrumentation: " << v.size() << " sites";
+                    if (this->n_overflow() > 0)
+                        os << " (+" << this->n_overflow() << " events at untracked sites)";
+                    os << "\n";
+
+                    for (const auto & x : v) {
+                        os << "  " << x.count_
+                           << " " << instrument::op2str(x.op_)
+                           << " factor=" << x.factor_
+                           << " " << x.file_ << ":" << x.line_
+                           << " " << x.function_
+                           << "\n";
+                    }
+                }
+
+                /** zero all counts.  Site table is retained **/
+                void reset() {
+                    for (slot & s : slot_v_)
+                        s.count_.store(0, std::memory_order_relaxed);
+
+                    n_overflow_.store(0, std::memory_order_relaxed);
+                }
+
+            private:
+                struct slot {
+                    /** hash of site;  0 while unclaimed **/
+                    std::atomic<std::uint64_t> key_{0};
+                    /** true once site fields below are written **/
+                    std::atomic<bool> ready_{false};
+                    const char * file_ = nullptr;
+                    const char * function_ = nullptr;
+                    std::uint32_t line_ = 0;
+                    instrument::op op_ = instrument::op::n_op;
+                    std::atomic<std::uint64_t> count_{0};
+                    std::atomic<double> factor_{0.0};
+                };
+
+                static_assert((c_n_slot & (c_n_slot - 1)) == 0);
+
+                static std::uint64_t mix(std::uint64_t h, std::uint64_t x) {
+                    /* FNV-1a style step on 64-bit words */
+                    return (h ^ x) * 0x100000001b3ull;
+                }
+
+                static std::uint64_t site_key(instrument::op kind, const std::source_location & loc) {
+                    std::uint64_t h = 0xcbf29ce484222325ull;
+
+                    h = mix(h, reinterpret_cast<std::uintptr_t>(loc.file_name()));
+                    h = mix(h, reinterpret_cast<std::uintptr_t>(loc.function_name()));
+                    h = mix(h, (std::uint64_t(loc.line()) << 32) | loc.column());
+                    h = mix(h, static_cast<std::uint64_t>(kind));
+
+                    return (h == 0) ? 1 : h;
+                }
+
+            private:
+                std::array<slot, c_n_slot> slot_v_;
+                std::atomic<std::uint64_t> n_overflow_{0};
+                std::atomic<bool> dump_at_exit_{true};
+            };
+        } /*namespace detail*/
+
+        namespace instrument {
+            /** count one occurrence of @p op at @p loc,  applying conversion factor @p factor.
+             *  No-op during constant evaluation.
+             **/
+            constexpr void
+            record(op kind, const std::source_location & loc, double factor) {
+                if (!std::is_constant_evaluated())
+                    detail::instrument_registry::instance().record(kind, loc, factor);
+            }
+
+            /** per-site counts recorded so far,  busiest first **/
+            inline std::vector<site_stats>
+            snapshot() {
+                return detail::instrument_registry::instance().snapshot();
+            }
+
+            /** write per-site counts to @p os **/
+            inline void
+            dump(std::ostream & os) {
+                detail::instrument_registry::instance().dump(os);
+            }
+
+            /** zero all counts **/
+            inline void
+            reset() {
+                detail::instrument_registry::instance().reset();
+            }
+
+            /** enable/disable printing counts to @c std::cerr at exit (default: enabled) **/
+            inline void
+            set_dump_at_exit(bool x) {
+                detail::instrument_registry::instance().set_dump_at_exit(x);
+            }
+        } /*namespace instrument*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end unit_instrument.hpp **/
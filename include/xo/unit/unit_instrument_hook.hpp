@@ -0,0 +1,45 @@
+/** @file unit_instrument_hook.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+/** @defgroup unit-instrument runtime unit-work instrumentation
+ *
+ *  Opt-in count of unit work actually executed at runtime.
+ *  Build with @c -DXO_UNIT_INSTRUMENT (cmake option @c XO_UNIT_INSTRUMENT)
+ *  to enable.  Otherwise the hook macros below expand to nothing
+ *  (or to a no-op expression),  so instrumented code is unchanged,
+ *  and the registry in @c unit_instrument.hpp is not included.
+ *
+ *  Counted events (see @ref xo::qty::instrument::op):
+ *  - @c rescale       xquantity rescale / rescale_ext with factor other than 1
+ *  - @c su_ratio      runtime unit ratio (xquantity divide, add, subtract)
+ *  - @c su_product    runtime unit product (xquantity multiply)
+ *  - @c dim_mismatch  add/subtract of quantities with different dimension (result is NaN)
+ *  - @c sqrt          runtime @c ::sqrt of a scale factor,  from fractional dimension powers (xquantity)
+ *
+ *  Counts are aggregated per site:  source location plus enclosing function
+ *  (for templates,  includes the template arguments, so identifies the units involved).
+ *  @c rescale and @c rescale_ext report their caller's location.
+ *
+ *  With instrumentation enabled,  sites are printed to @c std::cerr at exit,
+ *  busiest first;  see @ref xo::qty::instrument::set_dump_at_exit
+ **/
+///@{
+
+#ifdef XO_UNIT_INSTRUMENT
+#  include "unit_instrument.hpp"
+#  define XO_UNIT_SITE_PARAM , std::source_location xo_site = std::source_location::current()
+#  define XO_UNIT_RECORD(op, factor) ::xo::qty::instrument::record((op), xo_site, (factor))
+#  define XO_UNIT_RECORD_HERE(op, factor) ::xo::qty::instrument::record((op), std::source_location::current(), (factor))
+#else
+#  define XO_UNIT_SITE_PARAM
+#  define XO_UNIT_RECORD(op, factor) ((void)0)
+#  define XO_UNIT_RECORD_HERE(op, factor) ((void)0)
+#endif
+
+///@}
+
+/** end unit_instrument_hook.hpp **/
@@ -0,0 +1,201 @@
+/** @file unit_policy.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "rescale_column.hpp"
+#include <type_traits>
+
+namespace xo {
+    namespace qty {
+        /** @defgroup unit-policy result-unit selection policies
+         *
+         *  @c operator* and @c operator/ on quantities adopt the left operand's
+         *  basis unit for each dimension (so @c km*m gives @c km^2,  scaled by 1/1000).
+         *  Chains mixing units then rescale at each step.
+         *
+         *  @ref multiply and @ref divide take a compile-time policy
+         *  choosing the result unit instead.  The product's conversion factor
+         *  and the move to the chosen unit fold into one compile-time constant:
+         *  one multiply when it differs from 1,  none otherwise.
+         *
+         *  Per call site:
+         *  @code
+         *  auto area = multiply<unit_policy::finest_unit>(qty::kilometers(2.0), qty::meters(3.0));
+         *  // area: quantity<u::meter * u::meter>,  6000 m^2
+         *  @endcode
+         *
+         *  Per namespace,  alias @ref policy_arith:
+         *  @code
+         *  namespace kernel {
+         *      using arith = xo::qty::policy_arith<xo::qty::unit_policy::si_canonical>;
+         *
+         *      auto f(auto d, auto t) { return arith::divide(d, arith::multiply(t, t)); }
+         *  }
+         *  @endcode
+         **/
+        ///@{
+
+        namespace unit_policy {
+            /** per dimension,  left operand's basis unit (if present,  else right operand's).
+             *  Same result unit as @c operator* / @c operator/
+             **/
+            struct left_wins {};
+            /** per dimension,  SI base unit:  kilogram for mass,  native unit otherwise
+             *  (meter, second, byte, currency, price)
+             **/
+            struct si_canonical {};
+            /** per dimension,  finer (smaller scalefactor) of the two operands' basis units **/
+            struct finest_unit {};
+        }
+
+        template <typename Policy>
+        concept unit_policy_concept = (std::is_same_v<Policy, unit_policy::left_wins>
+                                       || std::is_same_v<Policy, unit_policy::si_canonical>
+                                       || std::is_same_v<Policy, unit_policy::finest_unit>);
+
+        namespace detail {
+            /** basis unit chosen by @p Policy for dimension @p d,
+             *  given left operand unit @p lhs,  right operand unit @p rhs,
+             *  and default (left-wins) choice @p bu
+             **/
+            template <typename Policy, typename Int>
+            constexpr basis_unit
+            policy_bu(dimension d,
+                      const natural_unit<Int> & lhs,
+                      const natural_unit<Int> & rhs,
+                      const basis_unit & bu)
+            {
+                if constexpr (std::is_same_v<Policy, unit_policy::si_canonical>) {
+                    return basis_unit(d, scalefactor_ratio_type((d == dimension::mass) ? 1000 : 1, 1));
+                } else if constexpr (std::is_same_v<Policy, unit_policy::finest_unit>) {
+                    bpu<Int> x = lhs.lookup_dim(d);
+                    bpu<Int> y = rhs.lookup_dim(d);
+
+                    /* lookup_dim reports power 0 if dimension absent */
+                    if (x.power() == power_ratio_type(0))
+                        return y.bu();
+                    if (y.power() == power_ratio_type(0))
+                        return x.bu();
+
+                    return ((y.scalefactor().template convert_to<double>()
+                             < x.scalefactor().template convert_to<double>())
+                            ? y.bu()
+                            : x.bu());
+                } else {
+                    return bu;
+                }
+            }
+
+            /** @p nu,  with each basis unit replaced by @p Policy's choice **/
+            template <typename Policy, typename Int>
+            constexpr natural_unit<Int>
+            policy_unit(const natural_unit<Int> & nu,
+                        const natural_unit<Int> & lhs,
+                        const natural_unit<Int> & rhs)
+            {
+                natural_unit<Int> retval;
+
+                for (std::size_t i = 0, n = nu.n_bpu(); i < n; ++i) {
+                    retval.push_back(bpu<Int>(policy_bu<Policy>(nu[i].native_dim(), lhs, rhs, nu[i].bu()),
+                                              nu[i].power()));
+                }
+
+                return retval;
+            }
+
+            /** multiply (@p IsProduct) or divide @p x by @p y,  result unit chosen by @p Policy **/
+            template <typename Policy, bool IsProduct, typename Q1, typename Q2>
+            constexpr auto
+            policy_combine(const Q1 & x, const Q2 & y)
+            {
+                using r_repr_type = std::common_type_t<typename Q1::repr_type,
+                                                       typename Q2::repr_type>;
+                using r_int_type = std::common_type_t<typename Q1::ratio_int_type,
+                                                      typename Q2::ratio_int_type>;
+                using r_int2x_type = width2x_t<r_int_type>;
+
+                constexpr auto lhs_nu = Q1::s_scaled_unit.natural_unit_.template to_repr<r_int_type>();
+                constexpr auto rhs_nu = Q2::s_scaled_unit.natural_unit_.template to_repr<r_int_type>();
+
+                constexpr auto rr = [] {
+                    if constexpr (IsProduct)
+                        return su_product_v<r_int_type, r_int2x_type, lhs_nu, rhs_nu>;
+                    else
+                        return su_ratio_v<r_int_type, r_int2x_type, lhs_nu, rhs_nu>;
+                }();
+
+                constexpr auto r_unit = su_promote<r_int_type>(rr.natural_unit_);
+                constexpr auto p_unit = su_promote<r_int_type>(policy_unit<Policy>(rr.natural_unit_,
+                                                                                  lhs_nu, rhs_nu));
+
+                /* su_product/su_ratio outer factor,  then r_unit -> p_unit */
+                constexpr double k = ((((rr.outer_scale_sq_ == 1.0)
+                                        ? 1.0
+                                        : cx_sqrt(rr.outer_scale_sq_))
+                                       * rr.outer_scale_factor_.template convert_to<double>())
+                                      * rescale_factor<r_unit, p_unit, double>());
+
+                r_repr_type r_scale;
+
+                if constexpr (IsProduct)
+                    r_scale = static_cast<r_repr_type>(x.scale()) * static_cast<r_repr_type>(y.scale());
+                else
+                    r_scale = static_cast<r_repr_type>(x.scale()) / static_cast<r_repr_type>(y.scale());
+
+                if constexpr (k == 1.0)
+                    return quantity<p_unit, r_repr_type>(r_scale);
+                else
+                    return quantity<p_unit, r_repr_type>(static_cast<r_repr_type>(k) * r_scale);
+            }
+        } /*namespace detail*/
+
+        /** product @p x * @p y,  with result unit chosen by @p Policy **/
+        template <typename Policy, typename Q1, typename Q2>
+        requires (unit_policy_concept<Policy>
+                  && quantity_concept<Q1> && Q1::always_constexpr_unit
+                  && quantity_concept<Q2> && Q2::always_constexpr_unit)
+        constexpr auto
+        multiply(const Q1 & x, const Q2 & y)
+        {
+            return detail::policy_combine<Policy, true>(x, y);
+        }
+
+        /** quotient @p x / @p y,  with result unit chosen by @p Policy **/
+        template <typename Policy, typename Q1, typename Q2>
+        requires (unit_policy_concept<Policy>
+                  && quantity_concept<Q1> && Q1::always_constexpr_unit
+                  && quantity_concept<Q2> && Q2::always_constexpr_unit)
+        constexpr auto
+        divide(const Q1 & x, const Q2 & y)
+        {
+            return detail::policy_combine<Policy, false>(x, y);
+        }
+
+        /** @class policy_arith
+         *  @brief @ref multiply and @ref divide with policy fixed,
+         *  for use as a per-namespace alias
+         **/
+        template <typename Policy>
+        requires unit_policy_concept<Policy>
+        struct policy_arith {
+            using policy_type = Policy;
+
+            template <typename Q1, typename Q2>
+            static constexpr auto multiply(const Q1 & x, const Q2 & y) {
+                return xo::qty::multiply<Policy>(x, y);
+            }
+
+            template <typename Q1, typename Q2>
+            static constexpr auto divide(const Q1 & x, const Q2 & y) {
+                return xo::qty::divide<Policy>(x, y);
+            }
+        };
+
+        ///@}
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end unit_policy.hpp **/
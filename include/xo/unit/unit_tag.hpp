@@ -0,0 +1,103 @@
+/** @file unit_tag.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "quantity.hpp"
+#include <type_traits>
+
+/** declare unit tag @p name for unit @p unit_expr (a constexpr @c scaled_unit).
+ *
+ *  @code
+ *  XO_UNIT_TAG(mps_tag, xo::qty::u::meter / xo::qty::u::second);
+ *  @endcode
+ **/
+#define XO_UNIT_TAG(name, unit_expr)                                    \
+    struct name {                                                       \
+        static constexpr auto value = unit_expr;                        \
+    }
+
+namespace xo {
+    namespace qty {
+        /** @class tagged_quantity
+         *  @brief @c quantity whose unit is named by tag type @p UnitTag.
+         *
+         *  A @c quantity carries its @c scaled_unit as a non-type template parameter;
+         *  its mangled name spells out every basis unit, scalefactor and power
+         *  (several hundred characters per quantity type).
+         *  Each function taking or returning a quantity pays this in its symbol name,
+         *  and in debug info.
+         *
+         *  @c tagged_quantity<Tag,Repr> names the same unit through a tag type
+         *  declared with @ref XO_UNIT_TAG,  so it mangles as e.g.
+         *  @c tagged_quantity<mps_tag,double>.
+         *  Opt-in:  use it at API boundaries (function parameters, return types, members)
+         *  where symbol size matters.
+         *
+         *  Structurally the same as @c quantity<UnitTag::value,Repr>:
+         *  - derives from it,  with no extra state (same size and layout);
+         *  - arithmetic and comparison use the @c quantity operators,  and yield plain quantities;
+         *  - converts implicitly to and from any @c quantity of the same dimension.
+         *
+         *  @code
+         *  XO_UNIT_TAG(mps_tag, u::meter / u::second);
+         *  using speed = tagged_quantity<mps_tag>;
+         *
+         *  speed f(speed v, quantity<u::second> t);   // short symbol
+         *
+         *  speed v = qty::kilometers(1.0) / qty::seconds(1.0);
+         *  auto d = v * qty::seconds(10.0);            // quantity<u::meter>
+         *  @endcode
+         **/
+        template <typename UnitTag, typename Repr = double>
+        requires (UnitTag::value.is_natural() && UnitTag::value.is_scaled_unit_type())
+        class tagged_quantity : public quantity<UnitTag::value, Repr> {
+        public:
+            /** @defgroup tagged-quantity-type-traits tagged_quantity type traits **/
+            ///@{
+            using tag_type = UnitTag;
+            using quantity_type = quantity<UnitTag::value, Repr>;
+            ///@}
+
+        public:
+            /** @defgroup tagged-quantity-ctors tagged_quantity constructors **/
+            ///@{
+
+            using quantity_type::quantity_type;
+
+            /** same quantity;  no arithmetic.
+             *  Quantities in other units of the same dimension reach here
+             *  through @c quantity's conversion operator
+             **/
+            constexpr tagged_quantity(const quantity_type & x) : quantity_type(x) {}
+
+            ///@}
+
+            /** @defgroup tagged-quantity-access-methods tagged_quantity access methods **/
+            ///@{
+
+            /** this value as a plain @c quantity **/
+            constexpr const quantity_type & to_quantity() const { return *this; }
+
+            ///@}
+        };
+
+        /** @defgroup tagged-quantity-traits tagged_quantity traits **/
+        ///@{
+
+        template <typename T>
+        struct is_tagged_quantity : std::false_type {};
+
+        template <typename UnitTag, typename Repr>
+        struct is_tagged_quantity<tagged_quantity<UnitTag, Repr>> : std::true_type {};
+
+        template <typename T>
+        inline constexpr bool is_tagged_quantity_v = is_tagged_quantity<T>::value;
+
+        ///@}
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end unit_tag.hpp **/
@@ -0,0 +1,182 @@
+/** @file unit_visit.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "quantity.hpp"
+#include "xquantity.hpp"
+#include <span>
+#include <array>
+#include <algorithm>
+#include <utility>
+#include <type_traits>
+#include <cstdint>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            /** one entry in a @ref unit_dispatch jump table **/
+            struct unit_dispatch_entry {
+                std::uint64_t fingerprint_ = 0;
+                std::size_t index_ = 0;
+            };
+
+            /** @class unit_dispatch
+             *  @brief jump table from runtime natural unit to position in @p Units.
+             *
+             *  Entries are sorted by compile-time unit fingerprint;
+             *  lookup is a binary search on the runtime fingerprint,
+             *  followed by one unit comparison to rule out collisions.
+             **/
+            template <typename Int, auto... Units>
+            struct unit_dispatch {
+                static constexpr std::size_t c_n_unit = sizeof...(Units);
+
+                static constexpr std::array<natural_unit<Int>, c_n_unit> s_unit_v
+                = { Units.natural_unit_.template to_repr<Int>()... };
+
+                static constexpr std::array<unit_dispatch_entry, c_n_unit> s_table_v = [] {
+                    std::array<unit_dispatch_entry, c_n_unit> retval;
+
+                    for (std::size_t i = 0; i < c_n_unit; ++i)
+                        retval[i] = unit_dispatch_entry{s_unit_v[i].fingerprint(), i};
+
+                    std::sort(retval.begin(), retval.end(),
+                              [](const unit_dispatch_entry & x, const unit_dispatch_entry & y) {
+                                  return x.fingerprint_ < y.fingerprint_;
+                              });
+
+                    return retval;
+                }();
+
+                static constexpr bool distinct_units() {
+                    for (std::size_t i = 0; i < c_n_unit; ++i) {
+                        for (std::size_t j = i + 1; j < c_n_unit; ++j) {
+                            if (s_unit_v[i] == s_unit_v[j])
+                                return false;
+                        }
+                    }
+                    return true;
+                }
+
+                static_assert(distinct_units(), "unit_dispatch: expected distinct units");
+
+                /** position of @p nu in @p Units,  or @c c_n_unit if absent **/
+                static constexpr std::size_t lookup(const natural_unit<Int> & nu) {
+                    std::uint64_t h = nu.fingerprint();
+
+                    auto ix = std::lower_bound(s_table_v.begin(), s_table_v.end(), h,
+                                               [](const unit_dispatch_entry & x, std::uint64_t h) {
+                                                   return x.fingerprint_ < h;
+                                               });
+
+                    for (; (ix != s_table_v.end()) && (ix->fingerprint_ == h); ++ix) {
+                        if (s_unit_v[ix->index_] == nu)
+                            return ix->index_;
+                    }
+
+                    return c_n_unit;
+                }
+            };
+
+            /** invoke @p fn(std::type_identity<quantity<U,Repr>>(), args...)
+             *  for the @p i'th member @c U of @p Units,  through a table of function pointers
+             **/
+            template <typename Repr, auto... Units, typename Fn, typename... Args>
+            constexpr void
+            unit_invoke(std::size_t i, Fn && fn, Args &&... args)
+            {
+                using fnptr_type = void (*)(Fn &, Args &...);
+
+                constexpr fnptr_type c_fn_v[] = {
+                    [](Fn & fn, Args &... args) {
+                        fn(std::type_identity<quantity<Units, Repr>>(), args...);
+                    }...
+                };
+
+                c_fn_v[i](fn, args...);
+            }
+        } /*namespace detail*/
+
+        /** @defgroup unit-visit dispatch from runtime unit to compile-time unit
+         *
+         *  Match a runtime unit against a compile-time list of expected units @p Units,
+         *  then invoke a kernel templated on the matching @c quantity type.
+         *  One dispatch (fingerprint, binary search, one unit compare) per call;
+         *  inside the kernel all units are known statically.
+         *
+         *  The kernel is called with a tag @c std::type_identity<quantity<U,Repr>>:
+         *  @code
+         *  std::span<const double> col = ...;   // column of values with runtime unit nu
+         *
+         *  double total_ms = 0.0;
+         *  bool ok = visit_column<u::second, u::millisecond, u::microsecond>
+         *     (col, nu,
+         *      [&total_ms]<typename Q>(std::type_identity<Q>, std::span<const double> v) {
+         *          for (double x : v)
+         *              total_ms += Q(x).template rescale_ext<u::millisecond>().scale();
+         *      });
+         *  @endcode
+         *
+         *  Units must match exactly (same basis units and powers;  bpu order doesn't matter):
+         *  for example @c km is not matched by @c u::meter.
+         *  Visit returns false without invoking the kernel when nothing matches.
+         **/
+        ///@{
+
+        /** invoke @p fn with quantity type (repr @p Repr) for the member of @p Units equal to @p nu,
+         *  followed by @p args.
+         *  @return true iff @p nu matched one of @p Units
+         **/
+        template <typename Repr, auto... Units, typename Int, typename Fn, typename... Args>
+        requires ((Units.is_natural() && ...))
+        constexpr bool
+        visit_unit(const natural_unit<Int> & nu, Fn && fn, Args &&... args)
+        {
+            using dispatch_type = detail::unit_dispatch<Int, Units...>;
+
+            std::size_t i = dispatch_type::lookup(nu);
+
+            if (i == dispatch_type::c_n_unit)
+                return false;
+
+            detail::unit_invoke<Repr, Units...>(i, fn, args...);
+            return true;
+        }
+
+        /** invoke @p fn(std::type_identity<quantity<U,Repr>>(), quantity<U,Repr>),
+         *  where @c U is the member of @p Units with the same unit as @p x.
+         *  @return true iff unit of @p x matched one of @p Units
+         **/
+        template <auto... Units, typename Repr, typename Int, typename Fn>
+        requires ((Units.is_natural() && ...))
+        constexpr bool
+        visit(const xquantity<Repr, Int> & x, Fn && fn)
+        {
+            return visit_unit<Repr, Units...>
+                (x.unit(),
+                 [&fn, &x]<typename Quantity>(std::type_identity<Quantity> tag) {
+                     fn(tag, Quantity(x.scale()));
+                 });
+        }
+
+        /** invoke @p fn(std::type_identity<quantity<U,Repr>>(), @p col) once,
+         *  where @p col is a column of values in unit @p nu,
+         *  and @c U is the member of @p Units with the same unit as @p nu.
+         *  @return true iff @p nu matched one of @p Units
+         **/
+        template <auto... Units, typename Repr, typename Int, typename Fn>
+        requires ((Units.is_natural() && ...))
+        constexpr bool
+        visit_column(std::span<const Repr> col, const natural_unit<Int> & nu, Fn && fn)
+        {
+            return visit_unit<Repr, Units...>(nu, fn, col);
+        }
+
+        ///@}
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end unit_visit.hpp **/
@@ -0,0 +1,596 @@
+/** @file unit_wire.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "quantity.hpp"
+#include "xquantity.hpp"
+#include <array>
+#include <span>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace xo {
+    namespace qty {
+        /** @brief 16-bit code identifying a unit in a binary stream **/
+        using unit_code_type = std::uint16_t;
+
+        namespace detail {
+            namespace wire {
+                /** Built-in unit table.  Position in this table is the wire code.
+                 *
+                 *  Append-only:  reordering or removing entries breaks
+                 *  compatibility with previously-written streams.
+                 **/
+                constexpr natural_unit<std::int64_t> builtin_unit_v[] = {
+                    nu::dimensionless,
+
+                    nu::picogram, nu::nanogram, nu::microgram, nu::milligram, nu::gram,
+                    nu::kilogram, nu::tonne, nu::kilotonne, nu::megatonne, nu::gigatonne,
+
+                    nu::picometer, nu::nanometer, nu::micrometer, nu::millimeter, nu::meter,
+                    nu::kilometer, nu::megameter, nu::gigameter, nu::lightsecond, nu::astronomicalunit,
+                    nu::inch, nu::foot, nu::yard, nu::mile,
+
+                    nu::picosecond, nu::nanosecond, nu::microsecond, nu::millisecond, nu::second,
+                    nu::minute, nu::hour, nu::day, nu::week, nu::month,
+                    nu::year, nu::year250, nu::year360, nu::year365,
+
+                    nu::currency,
+                    nu::price,
+
+                    nu::volatility_30d, nu::volatility_250d, nu::volatility_360d, nu::volatility_365d,
+                    nu::variance_30d, nu::variance_250d, nu::variance_360d, nu::variance_365d,
+
+                    nu::bit, nu::byte,
+                    nu::kilobyte, nu::megabyte, nu::gigabyte, nu::terabyte,
+                    nu::kibibyte, nu::mebibyte, nu::gibibyte, nu::tebibyte,
+
+                    nu::packet, nu::message,
+                };
+
+                /** number of built-in units **/
+                constexpr unit_code_type n_builtin = std::size(builtin_unit_v);
+
+                /** code announcing a new dictionary entry:
+                 *  followed by full unit encoding,  then payload.
+                 *  Reader assigns next dictionary code,  same as writer did.
+                 **/
+                constexpr unit_code_type c_define = 0xfffe;
+                /** code for a unit sent inline,  without a dictionary entry:
+                 *  followed by full unit encoding,  then payload.
+                 **/
+                constexpr unit_code_type c_escape = 0xffff;
+
+                /** number of slots in @ref builtin_slot_v;  power of 2,  at most half full **/
+                constexpr std::size_t c_n_slot = std::bit_ceil(2u * n_builtin);
+
+                /** open-addressed hash table,  built at compile time:
+                 *  slot holds built-in code,  or @ref c_escape if empty
+                 **/
+                constexpr std::array<unit_code_type, c_n_slot> builtin_slot_v = []() {
+                    std::array<unit_code_type, c_n_slot> v;
+
+                    for (auto & x : v)
+                        x = c_escape;
+
+                    for (unit_code_type i = 0; i < n_builtin; ++i) {
+                        std::size_t j = builtin_unit_v[i].fingerprint() & (c_n_slot - 1);
+
+                        while (v[j] != c_escape)
+                            j = (j + 1) & (c_n_slot - 1);
+
+                        v[j] = i;
+                    }
+
+                    return v;
+                }();
+
+                /** wire code for built-in unit @p nu,  or @ref c_escape if not built-in **/
+                constexpr unit_code_type
+                builtin_code(const natural_unit<std::int64_t> & nu)
+                {
+                    std::size_t j = nu.fingerprint() & (c_n_slot - 1);
+
+                    for (;;) {
+                        unit_code_type code = builtin_slot_v[j];
+
+                        if ((code == c_escape) || (builtin_unit_v[code] == nu))
+                            return code;
+
+                        j = (j + 1) & (c_n_slot - 1);
+                    }
+                }
+
+                /** unsigned integer type with same width as @p T **/
+                template <typename T>
+                using same_width_uint_t = std::conditional_t<sizeof(T) == 1, std::uint8_t,
+                                          std::conditional_t<sizeof(T) == 2, std::uint16_t,
+                                          std::conditional_t<sizeof(T) == 4, std::uint32_t,
+                                                             std::uint64_t>>>;
+
+                /** store @p x at @p p,  little-endian **/
+                template <typename T>
+                inline void
+                put_le(std::byte * p, T x)
+                {
+                    using U = same_width_uint_t<T>;
+
+                    U u = std::bit_cast<U>(x);
+
+                    for (std::size_t i = 0; i < sizeof(U); ++i)
+                        p[i] = static_cast<std::byte>((u >> (8 * i)) & 0xff);
+                }
+
+                /** load little-endian value from @p p **/
+                template <typename T>
+                inline T
+                get_le(const std::byte * p)
+                {
+                    using U = same_width_uint_t<T>;
+
+                    U u = 0;
+
+                    for (std::size_t i = 0; i < sizeof(U); ++i)
+                        u |= static_cast<U>(static_cast<U>(p[i]) << (8 * i));
+
+                    return std::bit_cast<T>(u);
+                }
+
+                /** bytes in full encoding of a single bpu:
+                 *  dim (1) + scalefactor num,den (8+8) + power num,den (2+2)
+                 **/
+                constexpr std::size_t c_bpu_bytes = 1 + 8 + 8 + 2 + 2;
+
+                /** bytes in full encoding of unit @p nu **/
+                template <typename Int>
+                constexpr std::size_t
+                unit_bytes(const natural_unit<Int> & nu)
+                {
+                    return 1 + nu.n_bpu() * c_bpu_bytes;
+                }
+
+                /** write full encoding of unit @p nu at @p p.
+                 *  @return end of encoding
+                 *  @pre room for @c unit_bytes(nu) bytes at @p p
+                 **/
+                inline std::byte *
+                put_unit(std::byte * p, const natural_unit<std::int64_t> & nu)
+                {
+                    *p++ = static_cast<std::byte>(nu.n_bpu());
+
+                    for (std::size_t i = 0; i < nu.n_bpu(); ++i) {
+                        const auto & bpu = nu[i];
+
+                        *p++ = static_cast<std::byte>(bpu.native_dim());
+                        put_le(p, bpu.scalefactor().num()); p += 8;
+                        put_le(p, bpu.scalefactor().den()); p += 8;
+                        put_le(p, static_cast<std::int16_t>(bpu.power().num())); p += 2;
+                        put_le(p, static_cast<std::int16_t>(bpu.power().den())); p += 2;
+                    }
+
+                    return p;
+                }
+
+                /** read full encoding of a unit from @p buf into @p *p_nu.
+                 *
+                 *  Malformed unless each bpu has a distinct dimension,
+                 *  a positive scalefactor and a non-zero power;
+                 *  @c natural_unit equality,  fingerprint and rescaling rely on this.
+                 *
+                 *  @return number of bytes consumed,  or 0 if truncated or malformed
+                 **/
+                inline std::size_t
+                get_unit(std::span<const std::byte> buf, natural_unit<std::int64_t> * p_nu)
+                {
+                    if (buf.size() < 1)
+                        return 0;
+
+                    std::size_t n_bpu = static_cast<std::size_t>(buf[0]);
+                    std::size_t z = 1 + n_bpu * c_bpu_bytes;
+
+                    if ((n_bpu > n_dim) || (z > buf.size()))
+                        return 0;
+
+                    natural_unit<std::int64_t> nu;
+                    /* bit d set once dimension d seen */
+                    std::uint32_t dim_seen = 0;
+
+                    static_assert(n_dim <= 32);
+
+                    for (std::size_t i = 0; i < n_bpu; ++i) {
+                        const std::byte * p = &buf[1 + i * c_bpu_bytes];
+
+                        auto d = static_cast<std::uint8_t>(p[0]);
+                        auto sf_num = get_le<std::int64_t>(p + 1);
+                        auto sf_den = get_le<std::int64_t>(p + 9);
+                        auto pw_num = get_le<std::int16_t>(p + 17);
+                        auto pw_den = get_le<std::int16_t>(p + 19);
+
+                        if ((d >= n_dim) || (dim_seen & (std::uint32_t(1) << d)))
+                            return 0;
+                        if ((sf_num <= 0) || (sf_den <= 0))
+                            return 0;
+                        if ((pw_num == 0) || (pw_den == 0))
+                            return 0;
+
+                        dim_seen |= (std::uint32_t(1) << d);
+
+                        nu.push_back(bpu<std::int64_t>(static_cast<dimension>(d),
+                                                       scalefactor_ratio_type(sf_num, sf_den),
+                                                       power_ratio_type(pw_num, pw_den)));
+                    }
+
+                    *p_nu = nu;
+                    return z;
+                }
+            } /*namespace wire*/
+        } /*namespace detail*/
+
+        /** @class unit_dictionary
+         *  @brief per-stream table of non-built-in units.
+         *
+         *  Writer and reader each keep one;  entries are assigned in order of
+         *  first appearance,  so both sides agree on codes without negotiation.
+         *  Fixed capacity,  so never allocates;  once full,
+         *  further non-built-in units are sent inline.
+         **/
+        template <std::size_t Capacity = 32>
+        class unit_dictionary {
+        public:
+            using unit_type = natural_unit<std::int64_t>;
+
+        public:
+            /** number of dictionary entries **/
+            std::size_t size() const { return n_; }
+            /** true if no more room **/
+            bool is_full() const { return n_ == Capacity; }
+
+            /** code for unit @p nu,  or @c detail::wire::c_escape if unknown **/
+            unit_code_type lookup(const unit_type & nu) const {
+                unit_code_type code = detail::wire::builtin_code(nu);
+
+                if (code != detail::wire::c_escape)
+                    return code;
+
+                for (std::size_t i = 0; i < n_; ++i) {
+                    if (unit_v_[i] == nu)
+                        return static_cast<unit_code_type>(detail::wire::n_builtin + i);
+                }
+
+                return detail::wire::c_escape;
+            }
+
+            /** unit for code @p code.  nullptr if @p code not known **/
+            const unit_type * decode(unit_code_type code) const {
+                if (code < detail::wire::n_builtin)
+                    return &detail::wire::builtin_unit_v[code];
+
+                std::size_t i = code - detail::wire::n_builtin;
+
+                return (i < n_) ? &unit_v_[i] : nullptr;
+            }
+
+            /** append @p nu,  returning its new code.
+             *  @pre @c !is_full()
+             **/
+            unit_code_type append(const unit_type & nu) {
+                unit_v_[n_] = nu;
+
+                return static_cast<unit_code_type>(detail::wire::n_builtin + n_++);
+            }
+
+        private:
+            /** number of occupied entries in @ref unit_v_ **/
+            std::size_t n_ = 0;
+            /** dictionary entries;  entry i has code n_builtin + i **/
+            std::array<unit_type, Capacity> unit_v_;
+        };
+
+        /** @class wire_writer
+         *  @brief encode units and quantities into a caller-supplied byte buffer.
+         *
+         *  Record layout (all integers little-endian):
+         *  @code
+         *  code:u16 [unit] [payload]
+         *  @endcode
+         *  where @c unit (full encoding) is present only if @c code is
+         *  @c c_define or @c c_escape:
+         *  @code
+         *  n_bpu:u8 { dim:u8 sf_num:i64 sf_den:i64 pow_num:i16 pow_den:i16 } * n_bpu
+         *  @endcode
+         *  and payload for a quantity is its scale, in @c sizeof(Repr) bytes.
+         *
+         *  Write methods return false,  and leave buffer position unchanged,
+         *  if there isn't enough room.
+         **/
+        template <std::size_t DictCapacity = 32>
+        class wire_writer {
+        public:
+            using unit_type = natural_unit<std::int64_t>;
+
+        public:
+            explicit wire_writer(std::span<std::byte> buf) : buf_{buf} {}
+
+            /** @defgroup wire-writer-access-methods wire_writer access methods **/
+            ///@{
+
+            /** number of bytes written so far **/
+            std::size_t size() const { return pos_; }
+            /** bytes written so far **/
+            std::span<const std::byte> written() const { return buf_.subspan(0, pos_); }
+            /** per-stream dictionary **/
+            const unit_dictionary<DictCapacity> & dictionary() const { return dict_; }
+
+            ///@}
+
+            /** @defgroup wire-writer-general-methods wire_writer general methods **/
+            ///@{
+
+            /** write unit @p nu (no payload) **/
+            bool write_unit(const unit_type & nu) {
+                return this->write_record(nu, nullptr, 0);
+            }
+
+            /** write quantity with runtime unit **/
+            template <typename Repr>
+            bool write(const xquantity<Repr, std::int64_t> & x) {
+                std::byte payload[sizeof(Repr)];
+                detail::wire::put_le(payload, x.scale());
+
+                return this->write_record(x.unit(), payload, sizeof(Repr));
+            }
+
+            /** write quantity with compile-time unit.
+             *  For a built-in unit,  code is a compile-time constant
+             *  and record has fixed size.
+             **/
+            template <typename Quantity>
+            requires (quantity_concept<Quantity> && Quantity::always_constexpr_unit)
+            bool write(const Quantity & x) {
+                using repr_type = typename Quantity::repr_type;
+
+                constexpr unit_code_type c_code
+                    = detail::wire::builtin_code(Quantity::s_scaled_unit.natural_unit_.template to_repr<std::int64_t>());
+
+                if constexpr (c_code != detail::wire::c_escape) {
+                    constexpr std::size_t z = sizeof(unit_code_type) + sizeof(repr_type);
+
+                    if (pos_ + z > buf_.size())
+                        return false;
+
+                    detail::wire::put_le(&buf_[pos_], c_code);
+                    detail::wire::put_le(&buf_[pos_ + sizeof(unit_code_type)], x.scale());
+                    pos_ += z;
+
+                    return true;
+                } else {
+                    std::byte payload[sizeof(repr_type)];
+                    detail::wire::put_le(payload, x.scale());
+
+                    return this->write_record(Quantity::s_scaled_unit.natural_unit_.template to_repr<std::int64_t>(),
+                                              payload, sizeof(repr_type));
+                }
+            }
+
+            ///@}
+
+        private:
+            bool write_record(const unit_type & nu, const std::byte * payload, std::size_t payload_z) {
+                unit_code_type code = dict_.lookup(nu);
+                bool full_unit = (code == detail::wire::c_escape);
+
+                if (full_unit && !dict_.is_full())
+                    code = detail::wire::c_define;
+
+                std::size_t z = (sizeof(unit_code_type)
+                                 + (full_unit ? detail::wire::unit_bytes(nu) : 0)
+                                 + payload_z);
+
+                if (pos_ + z > buf_.size())
+                    return false;
+
+                std::byte * p = &buf_[pos_];
+
+                detail::wire::put_le(p, code);
+                p += sizeof(unit_code_type);
+
+                if (full_unit) {
+                    p = detail::wire::put_unit(p, nu);
+
+                    if (code == detail::wire::c_define)
+                        dict_.append(nu);
+                }
+
+                for (std::size_t i = 0; i < payload_z; ++i)
+                    p[i] = payload[i];
+
+                pos_ += z;
+
+                return true;
+            }
+
+        private:
+            /** destination buffer **/
+            std::span<std::byte> buf_;
+            /** bytes written so far **/
+            std::size_t pos_ = 0;
+            /** per-stream dictionary **/
+            unit_dictionary<DictCapacity> dict_;
+        };
+
+        /** @class wire_reader
+         *  @brief decode units and quantities written by @ref wire_writer.
+         *
+         *  Read methods return false,  and leave stream position unchanged,
+         *  on truncated or malformed input.
+         **/
+        template <std::size_t DictCapacity = 32>
+        class wire_reader {
+        public:
+            using unit_type = natural_unit<std::int64_t>;
+
+        public:
+            explicit wire_reader(std::span<const std::byte> buf) : buf_{buf} {}
+
+            /** @defgroup wire-reader-access-methods wire_reader access methods **/
+            ///@{
+
+            /** number of bytes consumed so far **/
+            std::size_t position() const { return pos_; }
+            /** true when all input consumed **/
+            bool at_end() const { return pos_ == buf_.size(); }
+            /** per-stream dictionary **/
+            const unit_dictionary<DictCapacity> & dictionary() const { return dict_; }
+
+            ///@}
+
+            /** @defgroup wire-reader-general-methods wire_reader general methods **/
+            ///@{
+
+            /** continue reading from @p buf,  e.g. after more input arrives.
+             *  Position and dictionary are kept.
+             *  @pre @p buf begins with the bytes of the current buffer
+             **/
+            void extend(std::span<const std::byte> buf) { buf_ = buf; }
+
+            /** read unit (no payload) into @p *p_nu **/
+            bool read_unit(unit_type * p_nu) {
+                std::size_t pos = pos_;
+                bool define = false;
+
+                if (!this->read_unit_aux(&pos, p_nu, &define))
+                    return false;
+
+                this->commit_define(define, *p_nu);
+                pos_ = pos;
+                return true;
+            }
+
+            /** read quantity with runtime unit into @p *p_x **/
+            template <typename Repr>
+            bool read(xquantity<Repr, std::int64_t> * p_x) {
+                std::size_t pos = pos_;
+                unit_type nu;
+                bool define = false;
+
+                if (!this->read_unit_aux(&pos, &nu, &define))
+                    return false;
+
+                if (pos + sizeof(Repr) > buf_.size())
+                    return false;
+
+                /* whole record present:  now safe to extend dictionary */
+                this->commit_define(define, nu);
+
+                *p_x = xquantity<Repr, std::int64_t>(detail::wire::get_le<Repr>(&buf_[pos]), nu);
+                pos_ = pos + sizeof(Repr);
+
+                return true;
+            }
+
+            /** read quantity with compile-time unit into @p *p_x.
+             *  Rescales if written unit differs from @c Quantity unit;
+             *  produces NaN if dimensions differ.
+             **/
+            template <typename Quantity>
+            requires (quantity_concept<Quantity> && Quantity::always_constexpr_unit)
+            bool read(Quantity * p_x) {
+                using repr_type = typename Quantity::repr_type;
+
+                constexpr auto c_nu = Quantity::s_scaled_unit.natural_unit_.template to_repr<std::int64_t>();
+                constexpr unit_code_type c_code = detail::wire::builtin_code(c_nu);
+
+                if constexpr (c_code != detail::wire::c_escape) {
+                    /* fast path:  exact match on compile-time code */
+                    constexpr std::size_t z = sizeof(unit_code_type) + sizeof(repr_type);
+
+                    if ((pos_ + z <= buf_.size())
+                        && (detail::wire::get_le<unit_code_type>(&buf_[pos_]) == c_code))
+                    {
+                        *p_x = Quantity(detail::wire::get_le<repr_type>(&buf_[pos_ + sizeof(unit_code_type)]));
+                        pos_ += z;
+
+                        return true;
+                    }
+                }
+
+                xquantity<repr_type, std::int64_t> x;
+
+                if (!this->read(&x))
+                    return false;
+
+                if (x.unit() == c_nu)
+                    *p_x = Quantity(x.scale());
+                else
+                    *p_x = Quantity(x.rescale(c_nu).scale());
+
+                return true;
+            }
+
+            ///@}
+
+        private:
+            /** decode unit at @p *p_pos into @p *p_nu,  advancing @p *p_pos.
+             *  Does not touch the dictionary:  sets @p *p_define if the record defines
+             *  a new dictionary entry,  for the caller to @ref commit_define
+             *  once the rest of the record (e.g. payload) has been checked.
+             *  Otherwise a read failing on a short buffer,  then retried,
+             *  would append the same unit twice.
+             **/
+            bool read_unit_aux(std::size_t * p_pos, unit_type * p_nu, bool * p_define) {
+                std::size_t pos = *p_pos;
+
+                if (pos + sizeof(unit_code_type) > buf_.size())
+                    return false;
+
+                unit_code_type code = detail::wire::get_le<unit_code_type>(&buf_[pos]);
+                pos += sizeof(unit_code_type);
+
+                if ((code == detail::wire::c_define) || (code == detail::wire::c_escape)) {
+                    std::size_t z = detail::wire::get_unit(buf_.subspan(pos), p_nu);
+
+                    if (z == 0)
+                        return false;
+
+                    pos += z;
+
+                    if (code == detail::wire::c_define) {
+                        if (dict_.is_full())
+                            return false;
+                        *p_define = true;
+                    }
+                } else {
+                    const unit_type * nu = dict_.decode(code);
+
+                    if (!nu)
+                        return false;
+
+                    *p_nu = *nu;
+                }
+
+                *p_pos = pos;
+                return true;
+            }
+
+            /** append @p nu to dictionary if @p define **/
+            void commit_define(bool define, const unit_type & nu) {
+                if (define)
+                    dict_.append(nu);
+            }
+
+        private:
+            /** source buffer **/
+            std::span<const std::byte> buf_;
+            /** bytes consumed so far **/
+            std::size_t pos_ = 0;
+            /** per-stream dictionary **/
+            unit_dictionary<DictCapacity> dict_;
+        };
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end unit_wire.hpp **/
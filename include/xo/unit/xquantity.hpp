@@ -8,6 +8,7 @@
 #include "quantity_ops.hpp"
 #include "scaled_unit.hpp"
 #include "natural_unit.hpp"
+#include "unit_instrument_hook.hpp"
 
 namespace xo {
     namespace qty {
@@ -158,6 +159,10 @@ namespace xo {
 
                 auto rr = detail::su_product<r_int_type, r_int2x_type>(x.unit(), y.unit());
 
+                XO_UNIT_RECORD_HERE(instrument::op::su_product, rr.outer_scale_factor_.template convert_to<double>());
+                if (rr.outer_scale_sq_ != 1.0)
+                    XO_UNIT_RECORD_HERE(instrument::op::sqrt, rr.outer_scale_sq_);
+
                 r_repr_type r_scale = (::sqrt(rr.outer_scale_sq_)
                                        * rr.outer_scale_factor_.template convert_to<r_repr_type>()
                                        * static_cast<r_repr_type>(x.scale())
@@ -180,6 +185,10 @@ namespace xo {
 
                 auto rr = detail::su_ratio<r_int_type, r_int2x_type>(x.unit(), y.unit());
 
+                XO_UNIT_RECORD_HERE(instrument::op::su_ratio, rr.outer_scale_factor_.template convert_to<double>());
+                if (rr.outer_scale_sq_ != 1.0)
+                    XO_UNIT_RECORD_HERE(instrument::op::sqrt, rr.outer_scale_sq_);
+
                 /* note: su_ratio() reports multiplicative outer scaling factors,
                  *       so multiply is correct here
                  */
@@ -206,7 +215,12 @@ namespace xo {
                 /* conversion to get y in same units as x:  multiply by y/x */
                 auto rr = detail::su_ratio<r_int_type, r_int2x_type>(y.unit(), x.unit());
 
+                XO_UNIT_RECORD_HERE(instrument::op::su_ratio, rr.outer_scale_factor_.template convert_to<double>());
+
                 if (rr.natural_unit_.is_dimensionless()) {
+                    if (rr.outer_scale_sq_ != 1.0)
+                        XO_UNIT_RECORD_HERE(instrument::op::sqrt, rr.outer_scale_sq_);
+
                     r_repr_type r_scale = (static_cast<r_repr_type>(x.scale())
                                            + (::sqrt(rr.outer_scale_sq_)
                                               * rr.outer_scale_factor_.template convert_to<r_repr_type>()
@@ -215,6 +229,8 @@ namespace xo {
                     return xquantity<r_repr_type, r_int_type>(r_scale, x.unit_.template to_repr<r_int_type>());
                 } else {
                     /* units don't match! */
+                    XO_UNIT_RECORD_HERE(instrument::op::dim_mismatch, std::numeric_limits<double>::quiet_NaN());
+
                     return xquantity<r_repr_type, r_int_type>(std::numeric_limits<r_repr_type>::quiet_NaN(),
                                                              x.unit_.template to_repr<r_int_type>());
                 }
@@ -234,7 +250,12 @@ namespace xo {
                 /* conversion to get y in same units as x:  multiply by y/x */
                 auto rr = detail::su_ratio<r_int_type, r_int2x_type>(y.unit(), x.unit());
 
+                XO_UNIT_RECORD_HERE(instrument::op::su_ratio, rr.outer_scale_factor_.template convert_to<double>());
+
                 if (rr.natural_unit_.is_dimensionless()) {
+                    if (rr.outer_scale_sq_ != 1.0)
+                        XO_UNIT_RECORD_HERE(instrument::op::sqrt, rr.outer_scale_sq_);
+
                     r_repr_type r_scale = (static_cast<r_repr_type>(x.scale())
                                            - (::sqrt(rr.outer_scale_sq_)
                                               * rr.outer_scale_factor_.template convert_to<r_repr_type>()
@@ -243,6 +264,8 @@ namespace xo {
                     return xquantity<r_repr_type, r_int_type>(r_scale, x.unit_.template to_repr<r_int_type>());
                 } else {
                     /* units don't match! */
+                    XO_UNIT_RECORD_HERE(instrument::op::dim_mismatch, std::numeric_limits<double>::quiet_NaN());
+
                     return xquantity<r_repr_type, r_int_type>(std::numeric_limits<r_repr_type>::quiet_NaN(),
                                                              x.unit_.template to_repr<r_int_type>());
                 }
@@ -255,23 +278,30 @@ namespace xo {
 
             /** create quantity representing the same value,  but in units of @p unit2 **/
             constexpr
-            auto rescale(const natural_unit<Int> & unit2) const {
+            auto rescale(const natural_unit<Int> & unit2 XO_UNIT_SITE_PARAM) const {
                 /* conversion factor from .unit -> unit2*/
                 auto rr = detail::su_ratio<ratio_int_type,
                                            ratio_int2x_type>(this->unit_, unit2);
 
                 if (rr.natural_unit_.is_dimensionless()) {
-                    repr_type r_scale = (::sqrt(rr.outer_scale_sq_)
-                                         * rr.outer_scale_factor_.template convert_to<repr_type>()
-                                         * this->scale_);
-                    return xquantity(r_scale, unit2);
+                    repr_type k = (::sqrt(rr.outer_scale_sq_)
+                                   * rr.outer_scale_factor_.template convert_to<repr_type>());
+
+                    if (k != 1.0)
+                        XO_UNIT_RECORD(instrument::op::rescale, k);
+                    if (rr.outer_scale_sq_ != 1.0)
+                        XO_UNIT_RECORD(instrument::op::sqrt, rr.outer_scale_sq_);
+
+                    return xquantity(k * this->scale_, unit2);
                 } else {
+                    XO_UNIT_RECORD(instrument::op::dim_mismatch, std::numeric_limits<double>::quiet_NaN());
+
                     return xquantity(std::numeric_limits<repr_type>::quiet_NaN(), unit2);
                 }
             }
 
             constexpr
-            auto rescale_ext(const scaled_unit<Int> & unit2) const {
+            auto rescale_ext(const scaled_unit<Int> & unit2 XO_UNIT_SITE_PARAM) const {
                 /* conversion factor from .unit -> unit2*/
                 auto rr = detail::su_ratio<ratio_int_type,
                                            ratio_int2x_type>(unit_,
@@ -293,8 +323,25 @@ namespace xo {
                            * rr.outer_scale_factor_.template convert_to<repr_type>()
                            * this->scale_
                            / unit2.outer_scale_factor_.template convert_to<repr_type>());
+
+#ifdef XO_UNIT_INSTRUMENT
+                    double k = ((((rr.outer_scale_sq_ == 1.0)
+                                  && (unit2.outer_scale_sq_ == 1.0))
+                                 ? 1.0
+                                 : ::sqrt(rr.outer_scale_sq_ / unit2.outer_scale_sq_))
+                                * rr.outer_scale_factor_.template convert_to<double>()
+                                / unit2.outer_scale_factor_.template convert_to<double>());
+
+                    if (k != 1.0)
+                        XO_UNIT_RECORD(instrument::op::rescale, k);
+                    if ((rr.outer_scale_sq_ != 1.0) || (unit2.outer_scale_sq_ != 1.0))
+                        XO_UNIT_RECORD(instrument::op::sqrt, rr.outer_scale_sq_ / unit2.outer_scale_sq_);
+#endif
+
                     return xquantity(r_scale, unit2);
                 } else {
+                    XO_UNIT_RECORD(instrument::op::dim_mismatch, std::numeric_limits<double>::quiet_NaN());
+
                     return xquantity(std::numeric_limits<repr_type>::quiet_NaN(), unit2);
                 }
             }
@@ -407,7 +454,8 @@ namespace xo {
         /** note: won't have constexpr result until c++26 (when ::sqrt(), ::pow() are constexpr)
          **/
         template <typename Quantity>
-        requires quantity_concept<Quantity>
+        requires (quantity_concept<Quantity>
+                  && !Quantity::always_constexpr_unit)
         constexpr auto
         operator* (double x, const Quantity & y)
         {
@@ -417,7 +465,8 @@ namespace xo {
         /** note: won't have constexpr result until c++26 (when ::sqrt(), ::pow() are constexpr)
          **/
         template <typename Quantity>
-        requires quantity_concept<Quantity>
+        requires (quantity_concept<Quantity>
+                  && !Quantity::always_constexpr_unit)
         constexpr auto
         operator* (const Quantity & x, double y)
         {
@@ -436,7 +485,9 @@ namespace xo {
 
         /** note: doesn not require unit scaling, so constexpr with c++23 **/
         template <typename Quantity, typename Dimensionless>
-        requires quantity_concept<Quantity> && std::is_arithmetic_v<Dimensionless>
+        requires (quantity_concept<Quantity>
+                  && !Quantity::always_constexpr_unit
+                  && std::is_arithmetic_v<Dimensionless>)
         constexpr auto
         operator/ (const Quantity & x, Dimensionless y)
         {
@@ -445,7 +496,9 @@ namespace xo {
 
         /** note: doesn not require unit scaling, so constexpr with c++23 **/
         template <typename Dimensionless, typename Quantity>
-        requires std::is_arithmetic_v<Dimensionless> && quantity_concept<Quantity>
+        requires (std::is_arithmetic_v<Dimensionless>
+                  && quantity_concept<Quantity>
+                  && !Quantity::always_constexpr_unit)
         constexpr auto
         operator/ (Dimensionless x, const Quantity & y)
         {
@@ -465,7 +518,8 @@ namespace xo {
         /** note: won't have constexpr result until c++26 (when ::sqrt(), ::pow() are constexpr)
          **/
         template <typename Quantity>
-        requires quantity_concept<Quantity>
+        requires (quantity_concept<Quantity>
+                  && !Quantity::always_constexpr_unit)
         constexpr auto
         operator+ (const Quantity & x, double y)
         {
@@ -475,7 +529,8 @@ namespace xo {
         /** note: won't have constexpr result until c++26 (when ::sqrt(), ::pow() are constexpr)
          **/
         template <typename Quantity>
-        requires quantity_concept<Quantity>
+        requires (quantity_concept<Quantity>
+                  && !Quantity::always_constexpr_unit)
         constexpr auto
         operator+ (double x, const Quantity & y)
         {
@@ -496,7 +551,8 @@ namespace xo {
         /** note: won't have constexpr result until c++26 (when ::sqrt(), ::pow() are constexpr)
          **/
         template <typename Quantity>
-        requires quantity_concept<Quantity>
+        requires (quantity_concept<Quantity>
+                  && !Quantity::always_constexpr_unit)
         constexpr auto
         operator- (const Quantity & x, double y)
         {
@@ -506,7 +562,8 @@ namespace xo {
         /** note: won't have constexpr result until c++26 (when ::sqrt(), ::pow() are constexpr)
          **/
         template <typename Quantity>
-        requires quantity_concept<Quantity>
+        requires (quantity_concept<Quantity>
+                  && !Quantity::always_constexpr_unit)
         constexpr auto
         operator- (double x, const Quantity & y)
         {
@@ -516,7 +573,8 @@ namespace xo {
         /** note: won't have constexpr result until c++26 (when ::sqrt(), ::pow() are constexpr)
          **/
         template <typename Quantity>
-        requires quantity_concept<Quantity>
+        requires (quantity_concept<Quantity>
+                  && !Quantity::always_constexpr_unit)
         constexpr auto
         operator== (const Quantity & x, double y)
         {
@@ -526,7 +584,8 @@ namespace xo {
         /** note: won't have constexpr result until c++26 (when ::sqrt(), ::pow() are constexpr)
          **/
         template <typename Quantity>
-        requires quantity_concept<Quantity>
+        requires (quantity_concept<Quantity>
+                  && !Quantity::always_constexpr_unit)
         constexpr auto
         operator== (double x, const Quantity & y)
         {
@@ -536,7 +595,8 @@ namespace xo {
         /** note: won't have constexpr result until c++26 (when ::sqrt(), ::pow() are constexpr)
          **/
         template <typename Quantity, double>
-        requires quantity_concept<Quantity>
+        requires (quantity_concept<Quantity>
+                  && !Quantity::always_constexpr_unit)
         constexpr auto
         operator<=> (const Quantity & x, double y)
         {
@@ -546,7 +606,8 @@ namespace xo {
         /** note: won't have constexpr result until c++26 (when ::sqrt(), ::pow() are constexpr)
          **/
         template <typename Quantity, double>
-        requires quantity_concept<Quantity>
+        requires (quantity_concept<Quantity>
+                  && !Quantity::always_constexpr_unit)
         constexpr auto
         operator<=> (double x, const Quantity & y)
         {
@@ -554,7 +615,7 @@ namespace xo {
         }
 
         namespace xu {
-            constexpr auto nanogram = xquantity(1.0, u::nanogram);
+            inline constexpr auto nanogram = xquantity(1.0, u::nanogram);
         }
     } /*namespace qty*/
 } /*namespace xo*/
@@ -0,0 +1,119 @@
+/* @file atomic_quantity.test.cpp */
+
+#include "xo/unit/atomic_quantity.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <thread>
+#include <vector>
+
+namespace xo {
+    namespace qty {
+        TEST_CASE("atomic_quantity", "[atomic_quantity]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.atomic_quantity"));
+
+            static_assert(atomic_quantity<u::second>::is_always_lock_free);
+            static_assert(sizeof(atomic_quantity<u::second>) == sizeof(double));
+
+            atomic_quantity<u::second> x;
+
+            REQUIRE(x.load().scale() == 0.0);
+
+            x.store(qty::seconds(2.0));
+            REQUIRE(x.load().scale() == 2.0);
+
+            /* compatible unit: converted before atomic op */
+            REQUIRE(x.fetch_add(qty::milliseconds(500.0)).scale() == 2.0);
+            REQUIRE(x.load().scale() == 2.5);
+
+            REQUIRE(x.fetch_sub(qty::minutes(1.0 / 60.0)).scale() == 2.5);
+            REQUIRE(x.load().scale() == Approx(1.5));
+
+            REQUIRE(x.exchange(qty::milliseconds(250.0)).scale() == Approx(1.5));
+            REQUIRE(x.load().scale() == 0.25);
+
+            auto expected = qty::seconds(1.0);
+            REQUIRE(!x.compare_exchange_strong(&expected, qty::seconds(7.0)));
+            REQUIRE(expected.scale() == 0.25);
+            REQUIRE(x.compare_exchange_strong(&expected, qty::seconds(7.0)));
+            REQUIRE(x.load().scale() == 7.0);
+
+            /* integer repr */
+            atomic_quantity<u::nanosecond, std::int64_t> t;
+
+            t.fetch_add(qty::microseconds(3.0));
+            t.fetch_add(qty::nanoseconds(std::int64_t(5)));
+            REQUIRE(t.load().scale() == 3005);
+        } /*TEST_CASE(atomic_quantity)*/
+
+        TEST_CASE("atomic_quantity.concurrent", "[atomic_quantity]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.atomic_quantity.concurrent"));
+
+            constexpr std::size_t c_n_thread = 4;
+            constexpr std::size_t c_n = 20000;
+
+            atomic_quantity<u::nanosecond, std::int64_t> total;
+            atomic_quantity<u::second> high_water;
+
+            std::vector<std::thread> thread_v;
+
+            for (std::size_t k = 0; k < c_n_thread; ++k) {
+                thread_v.emplace_back([&, k]() {
+                    for (std::size_t i = 0; i < c_n; ++i) {
+                        total.fetch_add(qty::microseconds(std::int64_t(1)));
+
+                        /* cas loop: maximum */
+                        auto v = qty::seconds(static_cast<double>(k * c_n + i));
+                        auto cur = high_water.load();
+                        while ((cur.scale() < v.scale())
+                               && !high_water.compare_exchange_weak(&cur, v))
+                            ;
+                    }
+                });
+            }
+
+            for (auto & t : thread_v)
+                t.join();
+
+            REQUIRE(total.load().scale() == c_n_thread * c_n * 1000);
+            REQUIRE(high_water.load().scale() == c_n_thread * c_n - 1);
+        } /*TEST_CASE(atomic_quantity.concurrent)*/
+
+        TEST_CASE("sharded_counter", "[sharded_counter]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.sharded_counter"));
+
+            constexpr std::size_t c_n_thread = 6;
+            constexpr std::size_t c_n = 50000;
+
+            using counter_type = sharded_counter<u::nanosecond, std::int64_t, 4>;
+
+            static_assert(sizeof(counter_type) == 4 * counter_type::c_cache_line);
+
+            counter_type busy;
+
+            std::vector<std::thread> thread_v;
+
+            for (std::size_t k = 0; k < c_n_thread; ++k) {
+                thread_v.emplace_back([&]() {
+                    for (std::size_t i = 0; i < c_n; ++i)
+                        busy.add(qty::microseconds(std::int64_t(2)));
+                });
+            }
+
+            for (auto & t : thread_v)
+                t.join();
+
+            REQUIRE(busy.load().scale() == c_n_thread * c_n * 2000);
+
+            busy.reset();
+            REQUIRE(busy.load().scale() == 0);
+        } /*TEST_CASE(sharded_counter)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end atomic_quantity.test.cpp */
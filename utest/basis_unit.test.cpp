@@ -39,6 +39,9 @@ namespace xo {
             static_assert(native_unit2_v[static_cast<int>(dim::time)].native_dim() == dim::time);
             static_assert(native_unit2_v[static_cast<int>(dim::currency)].native_dim() == dim::currency);
             static_assert(native_unit2_v[static_cast<int>(dim::price)].native_dim() == dim::price);
+            static_assert(native_unit2_v[static_cast<int>(dim::information)].native_dim() == dim::information);
+            static_assert(native_unit2_v[static_cast<int>(dim::packet)].native_dim() == dim::packet);
+            static_assert(native_unit2_v[static_cast<int>(dim::message)].native_dim() == dim::message);
 
             log && log(xtag("mass*10^3", bu_abbrev(bu::kilogram)));
 
@@ -143,6 +146,22 @@ namespace xo {
 
             REQUIRE_x2(bu_abbrev(bu::price) == flatstring("px"));
 
+            log && log(xtag("information", bu_abbrev(bu::byte)));
+
+            REQUIRE_x2(bu_abbrev(bu::bit) == flatstring("bit"));
+            REQUIRE_x2(bu_abbrev(bu::byte) == flatstring("B"));
+            REQUIRE_x2(bu_abbrev(bu::kilobyte) == flatstring("kB"));
+            REQUIRE_x2(bu_abbrev(bu::kibibyte) == flatstring("KiB"));
+            REQUIRE_x2(bu_abbrev(bu::megabyte) == flatstring("MB"));
+            REQUIRE_x2(bu_abbrev(bu::mebibyte) == flatstring("MiB"));
+            REQUIRE_x2(bu_abbrev(bu::gigabyte) == flatstring("GB"));
+            REQUIRE_x2(bu_abbrev(bu::gibibyte) == flatstring("GiB"));
+            REQUIRE_x2(bu_abbrev(bu::terabyte) == flatstring("TB"));
+            REQUIRE_x2(bu_abbrev(bu::tebibyte) == flatstring("TiB"));
+
+            REQUIRE_x2(bu_abbrev(bu::packet) == flatstring("pkt"));
+            REQUIRE_x2(bu_abbrev(bu::message) == flatstring("msg"));
+
 #          undef REQUIRE_x2
 
         } /*TEST_CASE(basis_unit1)*/
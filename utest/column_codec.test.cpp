@@ -0,0 +1,164 @@
+/* @file column_codec.test.cpp */
+
+#include "xo/unit/column_codec.hpp"
+#include "xo/randomgen/xoshiro256.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <limits>
+#include <vector>
+
+namespace xo {
+    namespace qty {
+        using xo::rng::xoshiro256ss;
+
+        TEST_CASE("column_codec.zigzag", "[column_codec]") {
+            using namespace detail::codec;
+
+            static_assert(zigzag(0) == 0);
+            static_assert(zigzag(-1) == 1);
+            static_assert(zigzag(1) == 2);
+            static_assert(zigzag(-2) == 3);
+            static_assert(unzigzag(zigzag(std::numeric_limits<std::int64_t>::min()))
+                          == std::numeric_limits<std::int64_t>::min());
+            static_assert(unzigzag(zigzag(std::numeric_limits<std::int64_t>::max()))
+                          == std::numeric_limits<std::int64_t>::max());
+        } /*TEST_CASE(column_codec.zigzag)*/
+
+        TEST_CASE("column_codec.roundtrip", "[column_codec]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.column_codec.roundtrip"));
+
+            auto rng = xoshiro256ss(13579);
+
+            /* value patterns: monotone w/ jitter,  random walk,  extremes */
+            std::vector<std::vector<std::int64_t>> case_v;
+
+            {
+                std::vector<std::int64_t> v;
+                std::int64_t t = 1700000000000000000;
+                for (std::size_t i = 0; i < 1000; ++i) {
+                    t += 1000 + static_cast<std::int64_t>(rng() % 100);
+                    v.push_back(t);
+                }
+                case_v.push_back(v);
+            }
+            {
+                std::vector<std::int64_t> v;
+                std::int64_t px = 10000;
+                for (std::size_t i = 0; i < 777; ++i) {
+                    px += static_cast<std::int64_t>(rng() % 7) - 3;
+                    v.push_back(px);
+                }
+                case_v.push_back(v);
+            }
+            case_v.push_back({ std::numeric_limits<std::int64_t>::min(), std::numeric_limits<std::int64_t>::max(),
+                               0, -1, std::numeric_limits<std::int64_t>::min() });
+            case_v.push_back({ 42 });
+            case_v.push_back({ });
+
+            for (std::size_t k = 0; k < case_v.size(); ++k) {
+                const auto & v = case_v[k];
+
+                for (int_codec codec : { int_codec::varint, int_codec::bitpack }) {
+                    INFO(xtag("k", k) << xtag("codec", static_cast<int>(codec)));
+
+                    std::vector<std::byte> buf(encoded_block_bound(v.size()));
+
+                    std::size_t z = encode_block(codec, nu::nanosecond, std::span<const std::int64_t>(v), buf);
+
+                    REQUIRE(z > 0);
+
+                    log && log(xtag("k", k), xtag("codec", static_cast<int>(codec)), xtag("n", v.size()), xtag("z", z));
+
+                    std::vector<std::int64_t> out(v.size());
+                    natural_unit<std::int64_t> unit;
+
+                    REQUIRE(decode_block(std::span<const std::byte>(buf).subspan(0, z), std::span<std::int64_t>(out), &unit) == z);
+                    REQUIRE(unit == nu::nanosecond);
+                    REQUIRE(out == v);
+
+                    /* truncated input fails */
+                    if (z > 0)
+                        REQUIRE(decode_block(std::span<const std::byte>(buf).subspan(0, z - 1), std::span<std::int64_t>(out)) == 0);
+                }
+            }
+        } /*TEST_CASE(column_codec.roundtrip)*/
+
+        TEST_CASE("column_codec.bitpack_width", "[column_codec]") {
+            /* every bit width 0..64,  block sizes around lane multiples,
+             * so rows straddle 64-bit words and last row is short
+             */
+            auto rng = xoshiro256ss(24680);
+
+            for (unsigned w = 0; w <= 64; ++w) {
+                for (std::size_t n : { 1, 2, 3, 4, 5, 7, 8, 9, 63, 64, 65, 257 }) {
+                    INFO(xtag("w", w) << xtag("n", n));
+
+                    /* lane deltas up to w bits after zigzag */
+                    std::vector<std::int64_t> v(n);
+                    v[0] = static_cast<std::int64_t>(rng());
+                    for (std::size_t i = 1; i < n; ++i) {
+                        std::uint64_t u = (w == 0) ? 0 : (rng() >> (64 - w));
+                        std::int64_t ref = (i < 4) ? v[0] : v[i - 4];
+
+                        v[i] = static_cast<std::int64_t>(static_cast<std::uint64_t>(ref)
+                                                         + static_cast<std::uint64_t>(detail::codec::unzigzag(u)));
+                    }
+
+                    std::vector<std::byte> buf(encoded_block_bound(n));
+
+                    std::size_t z = encode_block(int_codec::bitpack, nu::nanosecond, std::span<const std::int64_t>(v), buf);
+
+                    REQUIRE(z > 0);
+
+                    std::vector<std::int64_t> out(n);
+
+                    REQUIRE(decode_block(std::span<const std::byte>(buf).subspan(0, z), std::span<std::int64_t>(out)) == z);
+                    REQUIRE(out == v);
+                    REQUIRE(decode_block(std::span<const std::byte>(buf).subspan(0, z - 1), std::span<std::int64_t>(out)) == 0);
+                }
+            }
+        } /*TEST_CASE(column_codec.bitpack_width)*/
+
+        TEST_CASE("column_codec.quantity", "[column_codec]") {
+            using t_type = quantity<u::nanosecond, std::int64_t>;
+
+            std::vector<t_type> v;
+            for (std::int64_t i = 0; i < 100; ++i)
+                v.push_back(t_type(1000000 + 250 * i));
+
+            std::vector<std::byte> buf(encoded_block_bound(v.size()));
+
+            std::size_t z = encode_block(int_codec::bitpack, std::span<const t_type>(v), buf);
+
+            REQUIRE(z > 0);
+            /* constant delta 250 -> zigzag 500 -> 9 bits per value */
+            REQUIRE(z < 100 * 2 + 64);
+
+            std::vector<t_type> out(v.size());
+
+            REQUIRE(decode_block(std::span<const std::byte>(buf).subspan(0, z), std::span<t_type>(out)) == z);
+
+            for (std::size_t i = 0; i < v.size(); ++i)
+                REQUIRE(out[i].scale() == v[i].scale());
+
+            /* unit mismatch rejected */
+            std::vector<quantity<u::microsecond, std::int64_t>> out2(v.size());
+
+            REQUIRE(decode_block(std::span<const std::byte>(buf).subspan(0, z),
+                                 std::span<quantity<u::microsecond, std::int64_t>>(out2)) == 0);
+
+            /* 32-bit repr */
+            std::vector<std::int32_t> px_v = { 100, 101, 99, 99, 105, -3 };
+            std::vector<std::int32_t> px2_v(px_v.size());
+
+            z = encode_block(int_codec::varint, nu::price, std::span<const std::int32_t>(px_v), buf);
+
+            REQUIRE(decode_block(std::span<const std::byte>(buf).subspan(0, z), std::span<std::int32_t>(px2_v)) == z);
+            REQUIRE(px2_v == px_v);
+        } /*TEST_CASE(column_codec.quantity)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end column_codec.test.cpp */
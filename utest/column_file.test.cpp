@@ -0,0 +1,210 @@
+/* @file column_file.test.cpp */
+
+#include "xo/unit/column_file.hpp"
+#include "xo/unit/xquantity_iostream.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <filesystem>
+#include <cstdio>
+#include <vector>
+
+namespace xo {
+    namespace qty {
+        TEST_CASE("column_file.roundtrip", "[column_file]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.column_file.roundtrip"));
+
+            std::string path = (std::filesystem::temp_directory_path() / "xo_unit_column_file.test.xqc").string();
+
+            constexpr std::size_t n = 1000;
+
+            std::vector<quantity<u::millisecond>> t_v;
+            std::vector<double> px_v;
+            std::vector<float> qty_v;
+
+            for (std::size_t i = 0; i < n; ++i) {
+                t_v.push_back(qty::milliseconds(static_cast<double>(i) * 1.5));
+                px_v.push_back(100.0 + 0.01 * static_cast<double>(i));
+                qty_v.push_back(static_cast<float>(i % 17));
+            }
+
+            {
+                column_file_writer w(n);
+
+                REQUIRE(w.add_column("t", std::span<const quantity<u::millisecond>>(t_v)));
+                REQUIRE(w.add_column("px", nu::price, std::span<const double>(px_v)));
+                REQUIRE(w.add_column("qty", nu::kilogram, std::span<const float>(qty_v)));
+                /* wrong length */
+                REQUIRE(!w.add_column("bad", nu::kilogram, std::span<const float>(qty_v).subspan(1)));
+
+                REQUIRE(w.write(path.c_str()));
+            }
+
+            column_file f;
+
+            REQUIRE(f.open(path.c_str()));
+            REQUIRE(f.n_col() == 3);
+            REQUIRE(f.n_row() == n);
+            REQUIRE(f.column_name(1) == "px");
+            REQUIRE(f.column_unit(0) == nu::millisecond);
+            REQUIRE(f.find_column("qty") == 2);
+            REQUIRE(f.find_column("nope") == 3);
+            REQUIRE(f.column_name(3).empty());
+            REQUIRE(f.column_unit(3).n_bpu() == 0);
+
+            /* same unit:  exact,  zero-copy */
+            {
+                auto v = f.column<u::millisecond>("t");
+
+                REQUIRE(v.size() == n);
+                REQUIRE(v.is_exact());
+                REQUIRE(reinterpret_cast<std::uintptr_t>(v.raw().data()) % 64 == 0);
+
+                for (std::size_t i = 0; i < n; ++i)
+                    REQUIRE(v[i] == t_v[i]);
+            }
+
+            /* different unit:  one factor,  applied on access */
+            {
+                auto v = f.column<u::second>("t");
+
+                REQUIRE(v.size() == n);
+                REQUIRE(v.factor() == 0.001);
+                REQUIRE(v[10].scale() == 0.001 * t_v[10].scale());
+            }
+
+            /* incompatible dimension:  NaN factor */
+            {
+                auto v = f.column<u::meter>("t");
+
+                REQUIRE(std::isnan(v.factor()));
+            }
+
+            /* repr mismatch:  empty view */
+            {
+                auto v = f.column<u::kilogram, double>("qty");
+
+                REQUIRE(v.empty());
+
+                auto v2 = f.column<u::gram, float>("qty");
+
+                REQUIRE(v2.size() == n);
+                REQUIRE(v2[5].scale() == 5000.0f);
+            }
+
+            /* runtime unit */
+            {
+                auto v = f.xcolumn<double>("px");
+
+                REQUIRE(v.size() == n);
+                REQUIRE(v.unit() == nu::price);
+                REQUIRE(v[3].scale() == px_v[3]);
+                REQUIRE(v[3].unit() == nu::price);
+            }
+
+            f.close();
+            REQUIRE(!f.is_open());
+
+            std::filesystem::remove(path);
+
+            /* not a column file */
+            REQUIRE(!f.open(path.c_str()));
+        } /*TEST_CASE(column_file.roundtrip)*/
+
+        TEST_CASE("column_file.corrupt", "[column_file]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.column_file.corrupt"));
+
+            std::string path = (std::filesystem::temp_directory_path() / "xo_unit_column_file_corrupt.test.xqc").string();
+
+            std::vector<double> px_v = { 1.0, 2.0, 3.0 };
+
+            {
+                column_file_writer w(px_v.size());
+
+                REQUIRE(w.add_column("px", nu::price, std::span<const double>(px_v)));
+                REQUIRE(w.write(path.c_str()));
+            }
+
+            column_file f;
+
+            REQUIRE(f.open(path.c_str()));
+            f.close();
+
+            /* n_row chosen so that n_row * 8 wraps to a small value */
+            {
+                std::FILE * fp = std::fopen(path.c_str(), "r+b");
+                REQUIRE(fp);
+
+                std::uint64_t n_row = std::uint64_t(1) << 61;
+
+                REQUIRE(std::fseek(fp, 16, SEEK_SET) == 0);
+                REQUIRE(std::fwrite(&n_row, 8, 1, fp) == 1);
+                std::fclose(fp);
+            }
+
+            REQUIRE(!f.open(path.c_str()));
+            REQUIRE(!f.is_open());
+
+            std::filesystem::remove(path);
+        } /*TEST_CASE(column_file.corrupt)*/
+
+        TEST_CASE("column_file.int_rescale", "[column_file]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.column_file.int_rescale"));
+
+            std::string path = (std::filesystem::temp_directory_path() / "xo_unit_column_file_int.test.xqc").string();
+
+            /* integer nanoseconds,  including an epoch-sized timestamp beyond 2^53 */
+            std::vector<std::int64_t> t_v = { 0, 2000, 2499, 2500, -2500, 1700000000123456789 };
+
+            {
+                column_file_writer w(t_v.size());
+
+                REQUIRE(w.add_column("t", nu::nanosecond, std::span<const std::int64_t>(t_v)));
+                REQUIRE(w.write(path.c_str()));
+            }
+
+            column_file f;
+
+            REQUIRE(f.open(path.c_str()));
+
+            /* coarser unit:  rounded to nearest,  not truncated to 0 */
+            {
+                auto v = f.column<u::microsecond, std::int64_t>("t");
+
+                REQUIRE(v.size() == t_v.size());
+                REQUIRE(v.factor() == Approx(0.001).epsilon(1e-15));
+                REQUIRE(v[0].scale() == 0);
+                REQUIRE(v[1].scale() == 2);
+                REQUIRE(v[2].scale() == 2);
+                REQUIRE(v[3].scale() == 3);
+                REQUIRE(v[4].scale() == -3);
+                REQUIRE(v[5].scale() == 1700000000123457);
+            }
+
+            /* finer unit:  exact integer multiply */
+            {
+                auto v = f.column<u::picosecond, std::int64_t>("t");
+
+                REQUIRE(v.factor() == 1000.0);
+                REQUIRE(v[2].scale() == 2499000);
+            }
+
+            /* incompatible dimension:  no integer NaN,  so empty view */
+            {
+                auto v = f.column<u::meter, std::int64_t>("t");
+
+                REQUIRE(v.empty());
+            }
+
+            f.close();
+            std::filesystem::remove(path);
+        } /*TEST_CASE(column_file.int_rescale)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end column_file.test.cpp */
@@ -0,0 +1,170 @@
+/* @file csv_reader.test.cpp */
+
+#include "xo/unit/csv_reader.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <string>
+#include <vector>
+
+namespace xo {
+    namespace qty {
+        TEST_CASE("csv_reader.header", "[csv_reader]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.csv_reader.header"));
+
+            std::string text = "ts[ns], latency[us],notional[ccy],qty,speed[m.s^-1],bogus[furlong]\r\n";
+
+            csv_reader rdr;
+
+            REQUIRE(rdr.attach(text));
+            REQUIRE(rdr.n_col() == 6);
+            REQUIRE(rdr.column_name(1) == "latency");
+            REQUIRE(rdr.column_unit(1) == nu::microsecond);
+            REQUIRE(rdr.column_unit(2) == nu::currency);
+            REQUIRE(rdr.column_unit(3).is_dimensionless());
+            REQUIRE(rdr.column_unit(4).n_bpu() == 2);
+            REQUIRE(rdr.column_unit_ok(4));
+            REQUIRE(!rdr.column_unit_ok(5));
+            REQUIRE(rdr.find_column("qty") == 3);
+            REQUIRE(rdr.find_column("nope") == rdr.n_col());
+
+            std::vector<quantity<u::millisecond>> ms_v;
+            std::vector<quantity<u::meter>> m_v;
+            std::vector<xquantity<double>> x_v;
+
+            REQUIRE(rdr.bind("latency", &ms_v));
+            /* dimension mismatch */
+            REQUIRE(!rdr.bind("latency", &m_v));
+            /* unrecognized unit */
+            REQUIRE(!rdr.bind("bogus", &x_v));
+            /* no such column */
+            REQUIRE(!rdr.bind("nope", &x_v));
+
+            /* header only: zero rows */
+            REQUIRE(rdr.read(4) == 0);
+            REQUIRE(ms_v.empty());
+        } /*TEST_CASE(csv_reader.header)*/
+
+        TEST_CASE("csv_reader.read", "[csv_reader]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.csv_reader.read"));
+
+            constexpr std::size_t c_n = 10007;
+
+            std::string text = "latency[us],side,notional[ccy],ts[ns]\n";
+
+            for (std::size_t i = 0; i < c_n; ++i) {
+                text += std::to_string(1000 + i) + ",B," + std::to_string(i) + ".5," + std::to_string(i) + "\n";
+                if (i % 1000 == 0)
+                    text += "\n";
+            }
+
+            for (std::size_t n_thread : {1, 2, 7}) {
+                INFO(xtag("n_thread", n_thread));
+
+                csv_reader rdr;
+
+                REQUIRE(rdr.attach(text));
+
+                std::vector<quantity<u::millisecond>> latency_v;
+                std::vector<xquantity<double>> notional_v;
+                std::vector<xquantity<double>> ts_v;
+                std::vector<quantity<u::nanosecond, std::int64_t>> ts2_v;
+
+                REQUIRE(rdr.bind("latency", &latency_v));
+                REQUIRE(rdr.bind("notional", &notional_v));
+                REQUIRE(rdr.bind("ts", nu::microsecond, &ts_v));
+                REQUIRE(rdr.bind("ts", &ts2_v));
+
+                REQUIRE(rdr.read(n_thread) == c_n);
+                REQUIRE(rdr.n_error() == 0);
+
+                REQUIRE(latency_v.size() == c_n);
+                REQUIRE(notional_v.size() == c_n);
+
+                for (std::size_t i = 0; i < c_n; ++i) {
+                    INFO(xtag("i", i));
+
+                    REQUIRE(latency_v[i].scale() == Approx((1000 + i) * 1e-3).epsilon(1e-12));
+                    REQUIRE(notional_v[i].unit() == nu::currency);
+                    REQUIRE(notional_v[i].scale() == i + 0.5);
+                    REQUIRE(ts_v[i].unit() == nu::microsecond);
+                    REQUIRE(ts_v[i].scale() == Approx(i * 1e-3).epsilon(1e-12));
+                    REQUIRE(ts2_v[i].scale() == static_cast<std::int64_t>(i));
+                }
+            }
+        } /*TEST_CASE(csv_reader.read)*/
+
+        TEST_CASE("csv_reader.errors", "[csv_reader]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.csv_reader.errors"));
+
+            std::string text = ("a[m];b[s]\n"
+                                "1;2\n"
+                                " +3 ; 4e1 \n"
+                                "x;5\n"
+                                "6\n"
+                                "7;8");
+
+            csv_reader rdr;
+
+            REQUIRE(rdr.attach(text, ';'));
+
+            std::vector<quantity<u::kilometer>> a_v;
+            std::vector<quantity<u::second>> b_v;
+
+            REQUIRE(rdr.bind("a", &a_v));
+            REQUIRE(rdr.bind("b", &b_v));
+
+            REQUIRE(rdr.read(3) == 5);
+            /* "x" malformed;  "6" row missing b */
+            REQUIRE(rdr.n_error() == 2);
+
+            REQUIRE(a_v[0].scale() == Approx(1e-3));
+            REQUIRE(a_v[1].scale() == Approx(3e-3));
+            REQUIRE(b_v[1].scale() == 40.0);
+            REQUIRE(a_v[2].scale() == 0.0);
+            REQUIRE(b_v[2].scale() == 5.0);
+            REQUIRE(a_v[3].scale() == Approx(6e-3));
+            REQUIRE(b_v[3].scale() == 0.0);
+            REQUIRE(b_v[4].scale() == 8.0);
+        } /*TEST_CASE(csv_reader.errors)*/
+
+        TEST_CASE("csv_reader.int_exact", "[csv_reader]") {
+            /* epoch timestamps beyond 2^53 survive integer unit conversion */
+            std::string text = ("ts_us[us],ts_ns[ns],frac[us]\n"
+                                "1700000000123457,1700000000123456789,1.5\n"
+                                "-1700000000123457,-1700000000123456501,-2.5\n");
+
+            csv_reader rdr;
+
+            REQUIRE(rdr.attach(text));
+
+            std::vector<quantity<u::nanosecond, std::int64_t>> ns_v;
+            std::vector<quantity<u::microsecond, std::int64_t>> us_v;
+            std::vector<quantity<u::nanosecond, std::int64_t>> frac_v;
+
+            REQUIRE(rdr.bind("ts_us", &ns_v));
+            REQUIRE(rdr.bind("ts_ns", &us_v));
+            REQUIRE(rdr.bind("frac", &frac_v));
+
+            REQUIRE(rdr.read(1) == 2);
+            REQUIRE(rdr.n_error() == 0);
+
+            /* us -> ns: exact multiply */
+            REQUIRE(ns_v[0].scale() == 1700000000123457000);
+            REQUIRE(ns_v[1].scale() == -1700000000123457000);
+            /* ns -> us: exact divide,  rounding half away from zero */
+            REQUIRE(us_v[0].scale() == 1700000000123457);
+            REQUIRE(us_v[1].scale() == -1700000000123457);
+            /* non-integer field still accepted */
+            REQUIRE(frac_v[0].scale() == 1500);
+            REQUIRE(frac_v[1].scale() == -2500);
+        } /*TEST_CASE(csv_reader.int_exact)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end csv_reader.test.cpp */
@@ -0,0 +1,143 @@
+/* @file decay_filter.test.cpp */
+
+#include "xo/unit/decay_filter.hpp"
+#include "xo/unit/quantity_iostream.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <vector>
+#include <cmath>
+
+namespace xo {
+    namespace qty {
+        TEST_CASE("decay_filter.halflife", "[decay_filter]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.decay_filter.halflife"));
+
+            using t_type = quantity<u::millisecond>;
+            using q_type = quantity<u::meter>;
+
+            /* half-life in seconds;  timestamps in milliseconds */
+            decay_filter<q_type, t_type> f(qty::seconds(2));
+
+            REQUIRE(f.halflife() == t_type(2000.0));
+            REQUIRE(std::isnan(f.value().scale()));
+
+            f.add(t_type(0.0), q_type(10.0));
+            REQUIRE(f.value() == q_type(10.0));
+
+            /* one half-life later: half weight on history */
+            f.add(t_type(2000.0), q_type(20.0));
+            REQUIRE(f.value() == q_type(15.0));
+
+            /* two more half-lives:  weight 1/4 on history */
+            f.add(t_type(6000.0), q_type(35.0));
+            REQUIRE(f.value().scale() == Approx(0.25 * 15.0 + 0.75 * 35.0).epsilon(1e-15));
+
+            REQUIRE(f.count() == 3);
+            REQUIRE(f.last_time() == t_type(6000.0));
+            REQUIRE(f.weight_at(t_type(8000.0)) == 0.5);
+        } /*TEST_CASE(decay_filter.halflife)*/
+
+        TEST_CASE("decay_filter.window", "[decay_filter]") {
+            using t_type = quantity<u::second>;
+            using q_type = quantity<u::meter>;
+
+            auto f = decay_filter<q_type, t_type>::from_decay_window(qty::minutes(1));
+
+            f.add(t_type(0.0), q_type(0.0));
+            f.add(t_type(60.0), q_type(1.0));
+
+            /* one e-folding time: weight 1/e on history */
+            REQUIRE(f.value().scale() == Approx(1.0 - ::exp(-1.0)).epsilon(1e-14));
+        } /*TEST_CASE(decay_filter.window)*/
+
+        TEST_CASE("decay_filter.batch", "[decay_filter]") {
+            using t_type = quantity<u::microsecond>;
+            using q_type = quantity<u::meter>;
+
+            std::vector<t_type> t_v;
+            std::vector<q_type> x_v;
+
+            double t = 0.0;
+            for (std::size_t i = 0; i < 500; ++i) {
+                /* mix of regular and irregular spacing */
+                t += (i % 7 == 0) ? 3.5 : 1.0;
+
+                t_v.push_back(t_type(t));
+                x_v.push_back(q_type(static_cast<double>(i % 13)));
+            }
+
+            decay_filter<q_type, t_type> f1(qty::microseconds(25));
+            decay_filter<q_type, t_type> f2(qty::microseconds(25));
+
+            for (std::size_t i = 0; i < t_v.size(); ++i)
+                f1.add(t_v[i], x_v[i]);
+
+            /* batch in two pieces */
+            f2.add(std::span<const t_type>(t_v).subspan(0, 100),
+                   std::span<const q_type>(x_v).subspan(0, 100));
+            f2.add(std::span<const t_type>(t_v).subspan(100),
+                   std::span<const q_type>(x_v).subspan(100));
+
+            REQUIRE(f2.count() == f1.count());
+            REQUIRE(f2.value() == f1.value());
+            REQUIRE(f2.last_time() == f1.last_time());
+        } /*TEST_CASE(decay_filter.batch)*/
+
+        TEST_CASE("decay_filter.int_time", "[decay_filter]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.decay_filter.int_time"));
+
+            /* integer nanosecond timestamps:  1/halflife must not truncate */
+            using t_type = quantity<u::nanosecond, std::int64_t>;
+            using q_type = quantity<u::meter>;
+
+            decay_filter<q_type, t_type> f(qty::milliseconds(1.0));
+
+            REQUIRE(f.halflife().scale() == 1000000);
+
+            f.add(t_type(0), q_type(0.0));
+            f.add(t_type(1000000), q_type(1.0));
+
+            REQUIRE(f.value().scale() == 0.5);
+            REQUIRE(f.weight_at(t_type(3000000)) == 0.25);
+
+            /* batch path */
+            decay_filter<q_type, t_type> f2(qty::milliseconds(1.0));
+
+            std::vector<t_type> t_v = { t_type(0), t_type(1000000), t_type(2000000) };
+            std::vector<q_type> x_v = { q_type(0.0), q_type(1.0), q_type(1.0) };
+
+            f2.add(t_v, x_v);
+
+            REQUIRE(f2.value().scale() == 0.75);
+
+            /* e-folding window */
+            auto f3 = decay_filter<q_type, t_type>::from_decay_window(qty::milliseconds(1.0));
+
+            f3.add(t_type(0), q_type(0.0));
+            f3.add(t_type(1000000), q_type(1.0));
+
+            REQUIRE(f3.value().scale() == Approx(1.0 - ::exp(-1.0)).epsilon(1e-6));
+
+            /* fractional half-life:  accessor rounds,  filter decays with exact value */
+            decay_filter<q_type, t_type> f4(qty::microseconds(1.5));
+
+            REQUIRE(f4.halflife().scale() == 1500);
+
+            f4.add(t_type(0), q_type(0.0));
+            f4.add(t_type(1500), q_type(1.0));
+
+            REQUIRE(f4.value().scale() == 0.5);
+
+            decay_filter<q_type, t_type> f5(qty::nanoseconds(2.5));
+
+            REQUIRE(f5.halflife().scale() == 3);
+            REQUIRE(f5.weight_at(t_type(5)) == 0.25);
+        } /*TEST_CASE(decay_filter.int_time)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end decay_filter.test.cpp */
@@ -0,0 +1,265 @@
+/* @file fx_matrix.test.cpp */
+
+#include "xo/unit/fx_matrix.hpp"
+#include "xo/unit/xquantity_iostream.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <thread>
+#include <vector>
+#include <cmath>
+
+namespace xo {
+    namespace qty {
+        namespace {
+            template <typename A, typename B>
+            concept addable = requires(A a, B b) { a + b; };
+
+            using usd_type = ccy_quantity<ccy::usd, quantity<u::currency>>;
+            using eur_type = ccy_quantity<ccy::eur, quantity<u::currency>>;
+        }
+
+        TEST_CASE("fx_matrix.rate", "[fx_matrix]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.fx_matrix.rate"));
+
+            fx_matrix<double> fx;
+
+            REQUIRE(fx.version() == 0);
+            REQUIRE(fx.rate(ccy::usd, ccy::usd) == 1.0);
+            REQUIRE(std::isnan(fx.rate(ccy::usd, ccy::eur)));
+
+            /* quotes in usd */
+            fx.publish(ccy::usd, 1.0);
+            fx.publish(ccy::eur, 1.25);
+
+            /* sequence lock:  two per publish */
+            REQUIRE(fx.version() == 4);
+            REQUIRE(fx.rate(ccy::eur, ccy::usd) == 1.25);
+            REQUIRE(fx.rate(ccy::usd, ccy::eur) == 1.0 / 1.25);
+            REQUIRE(std::isnan(fx.rate(ccy::usd, ccy::jpy)));
+
+            std::array<double, n_ccy> q_v;
+            for (std::size_t i = 0; i < n_ccy; ++i)
+                q_v[i] = 1.0 + 0.5 * i;
+
+            fx.publish_all(q_v);
+
+            REQUIRE(fx.version() == 6);
+
+            for (std::size_t i = 0; i < n_ccy; ++i) {
+                for (std::size_t j = 0; j < n_ccy; ++j) {
+                    auto ci = static_cast<currency_code>(i);
+                    auto cj = static_cast<currency_code>(j);
+
+                    INFO(tostr(xtag("from", ccy2str(ci)), xtag("to", ccy2str(cj))));
+
+                    REQUIRE(fx.rate(ci, cj) == Approx(q_v[i] / q_v[j]).epsilon(1e-15));
+                }
+            }
+        } /*TEST_CASE(fx_matrix.rate)*/
+
+        TEST_CASE("fx_matrix.convert", "[fx_matrix]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.fx_matrix.convert"));
+
+            fx_matrix<double> fx;
+            fx.publish(ccy::usd, 1.0);
+            fx.publish(ccy::gbp, 1.5);
+
+            /* raw column */
+            {
+                std::vector<double> src_v = { 1.0, 2.0, 4.0 };
+                std::vector<double> dest_v(src_v.size());
+
+                fx_convert(fx, ccy::gbp, ccy::usd, std::span<const double>(src_v), std::span<double>(dest_v));
+
+                REQUIRE(dest_v[0] == 1.5);
+                REQUIRE(dest_v[1] == 3.0);
+                REQUIRE(dest_v[2] == 6.0);
+            }
+
+            /* compile-time units;  currency appears with power 1 */
+            {
+                using q_type = quantity<u::currency / u::second>;
+
+                std::vector<q_type> src_v = { q_type(1.0), q_type(2.0) };
+                std::vector<q_type> dest_v(src_v.size());
+
+                fx_convert(fx, ccy::gbp, ccy::usd, std::span<const q_type>(src_v), std::span<q_type>(dest_v));
+
+                REQUIRE(dest_v[0].scale() == 1.5);
+                REQUIRE(dest_v[1].scale() == 3.0);
+            }
+
+            /* compile-time units;  currency appears with power 2 */
+            {
+                using q_type = quantity<u::currency * u::currency>;
+
+                std::vector<q_type> src_v = { q_type(1.0) };
+                std::vector<q_type> dest_v(src_v.size());
+
+                fx_convert(fx, ccy::gbp, ccy::usd, std::span<const q_type>(src_v), std::span<q_type>(dest_v));
+
+                REQUIRE(dest_v[0].scale() == Approx(2.25).epsilon(1e-15));
+            }
+
+            /* runtime units */
+            {
+                using xq_type = xquantity<double>;
+
+                std::vector<xq_type> src_v = { xq_type(10.0, nu::currency), xq_type(20.0, nu::currency) };
+                std::vector<xq_type> dest_v(src_v.size());
+
+                fx_convert(fx, ccy::usd, ccy::gbp, std::span<const xq_type>(src_v), std::span<xq_type>(dest_v));
+
+                REQUIRE(dest_v[0].scale() == Approx(10.0 / 1.5).epsilon(1e-15));
+                REQUIRE(dest_v[1].scale() == Approx(20.0 / 1.5).epsilon(1e-15));
+                REQUIRE(dest_v[1].unit() == nu::currency);
+            }
+        } /*TEST_CASE(fx_matrix.convert)*/
+
+        TEST_CASE("fx_matrix.concurrent", "[fx_matrix]") {
+            fx_matrix<double> fx;
+            fx.publish(ccy::usd, 1.0);
+            fx.publish(ccy::eur, 1.0);
+
+            constexpr std::size_t n_publish = 10000;
+
+            /* writer publishes eur quotes in [1, 2);
+             * reader must always observe a rate from that range
+             */
+            std::thread writer([&fx]() {
+                for (std::size_t i = 0; i < n_publish; ++i)
+                    fx.publish(ccy::eur, 1.0 + static_cast<double>(i) / n_publish);
+            });
+
+            std::size_t n_bad = 0;
+            while (fx.version() < 2 * (n_publish + 2)) {
+                double r = fx.rate(ccy::eur, ccy::usd);
+
+                if ((r < 1.0) || (r >= 2.0))
+                    ++n_bad;
+            }
+
+            writer.join();
+
+            REQUIRE(n_bad == 0);
+            REQUIRE(fx.rate(ccy::eur, ccy::usd) == 1.0 + static_cast<double>(n_publish - 1) / n_publish);
+        } /*TEST_CASE(fx_matrix.concurrent)*/
+
+        TEST_CASE("fx_matrix.ccy_quantity", "[fx_matrix]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.fx_matrix.ccy_quantity"));
+
+            /* currencies are distinct types */
+            static_assert(addable<usd_type, usd_type>);
+            static_assert(!addable<usd_type, eur_type>);
+            static_assert(!addable<usd_type, quantity<u::currency>>);
+            static_assert(!std::is_convertible_v<usd_type, eur_type>);
+            static_assert(sizeof(usd_type) == sizeof(double));
+
+            usd_type x(qty::currency(10.0));
+            usd_type y(qty::currency(2.5));
+
+            constexpr auto z = usd_type(qty::currency(1.0)) + usd_type(qty::currency(2.0));
+            static_assert(std::is_same_v<std::remove_cv_t<decltype(z)>, usd_type>);
+            static_assert(z.scale() == 3.0);
+
+            REQUIRE((x - y).scale() == 7.5);
+            REQUIRE((x * 2.0).scale() == 20.0);
+            REQUIRE(y < x);
+            REQUIRE(x == usd_type(qty::currency(10.0)));
+
+            /* currency survives currency-free factors */
+            auto px = x / qty::seconds(4.0);
+            static_assert(is_ccy_quantity_v<decltype(px)>);
+            static_assert(decltype(px)::s_ccy == ccy::usd);
+            REQUIRE((px * qty::seconds(2.0)).scale() == 5.0);
+
+            /* .. and cancels against itself */
+            auto r = x / y;
+            static_assert(!is_ccy_quantity_v<decltype(r)>);
+            REQUIRE(r.scale() == 4.0);
+
+            auto x2 = x * x;
+            static_assert(is_ccy_quantity_v<decltype(x2)>);
+            REQUIRE(x2.scale() == 100.0);
+
+            /* conversion needs a rate */
+            fx_matrix<double> fx;
+            fx.publish(ccy::usd, 1.0);
+            fx.publish(ccy::eur, 1.25);
+
+            eur_type e = fx.convert<ccy::eur>(x);
+            REQUIRE(e.scale() == 8.0);
+            REQUIRE(e.currency() == ccy::eur);
+
+            /* power 2 */
+            auto e2 = fx.convert<ccy::eur>(x2);
+            REQUIRE(e2.scale() == Approx(64.0).epsilon(1e-15));
+
+            /* column */
+            std::vector<usd_type> src_v = { x, y };
+            std::vector<eur_type> dest_v(src_v.size());
+
+            fx_convert(fx, std::span<const usd_type>(src_v), std::span<eur_type>(dest_v));
+
+            REQUIRE(dest_v[0].scale() == 8.0);
+            REQUIRE(dest_v[1].scale() == 2.0);
+        } /*TEST_CASE(fx_matrix.ccy_quantity)*/
+
+        TEST_CASE("fx_matrix.seqlock", "[fx_matrix]") {
+            fx_matrix<double> fx;
+
+            std::array<double, n_ccy> q_v;
+            q_v.fill(1.0);
+            fx.publish_all(q_v);
+
+            constexpr std::size_t n_publish = 10000;
+
+            /* writer publishes quotes q[k] = s^k,  with s a power of 2;
+             * so every rate(k, k+1) is exactly 1/s.
+             * rate(usd,eur) is stored first and rate(aud,hkd) last;
+             * a reader that mixes two publishes sees them differ
+             */
+            std::thread writer([&fx]() {
+                std::array<double, n_ccy> w_v;
+
+                for (std::size_t i = 0; i < n_publish; ++i) {
+                    double s = std::ldexp(1.0, static_cast<int>(i % 16) - 8);
+
+                    for (std::size_t k = 0; k < n_ccy; ++k)
+                        w_v[k] = std::pow(s, static_cast<double>(k));
+
+                    fx.publish_all(w_v);
+                }
+            });
+
+            std::size_t n_read = 0;
+            std::size_t n_bad = 0;
+            while (fx.version() < 2 * (n_publish + 1)) {
+                bool ok = fx.read_consistent([](const fx_matrix<double> & m) {
+                    double r0 = m.rate(ccy::usd, ccy::eur);
+                    double r1 = m.rate(ccy::aud, ccy::hkd);
+
+                    return r0 == r1;
+                });
+
+                ++n_read;
+                if (!ok)
+                    ++n_bad;
+            }
+
+            writer.join();
+
+            REQUIRE(n_read > 0);
+            REQUIRE(n_bad == 0);
+            REQUIRE((fx.version() & 1) == 0);
+        } /*TEST_CASE(fx_matrix.seqlock)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end fx_matrix.test.cpp */
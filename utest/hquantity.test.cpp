@@ -0,0 +1,71 @@
+/* @file hquantity.test.cpp */
+
+#include "xo/unit/hquantity.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+
+namespace xo {
+    namespace qty {
+        TEST_CASE("hquantity", "[hquantity]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.hquantity"));
+
+            using speed = hquantity<u::meter / u::second>;
+            using time = hquantity<u::second>;
+
+            static_assert(sizeof(speed) == 16);
+            /* dimension only: any unit with same dimension gives same type */
+            static_assert(std::same_as<speed, hquantity<u::kilometer / u::hour>>);
+            static_assert(std::same_as<speed, hquantity<u::mile / u::millisecond>>);
+
+            /* compile-time dimension checking */
+            static_assert(std::is_constructible_v<speed, decltype(qty::kilometers(1.0) / qty::hours(1.0))>);
+            static_assert(!std::is_constructible_v<speed, decltype(qty::seconds(1.0))>);
+
+            /* runtime unit from config */
+            auto kmh = speed::hunit_type::from_abbrev("km.hr^-1");
+            REQUIRE(kmh.is_valid());
+            REQUIRE(kmh.native_factor() == Approx(1000.0 / 3600.0));
+
+            REQUIRE(!speed::hunit_type::from_abbrev("km.s^-2").is_valid());
+            REQUIRE(!speed::hunit_type::from_abbrev("bogus").is_valid());
+
+            speed v(36.0, kmh);
+            speed w = qty::meters(5.0) / qty::seconds(1.0);
+
+            REQUIRE(v.native_scale() == Approx(10.0));
+            REQUIRE(v.to_quantity<u::meter / u::second>().scale() == Approx(10.0));
+
+            /* sum in lhs unit */
+            auto z = v + w;
+            REQUIRE(z.unit().native_factor() == kmh.native_factor());
+            REQUIRE(z.scale() == Approx(54.0));
+            REQUIRE((v - w).native_scale() == Approx(5.0));
+
+            /* comparisons across units */
+            REQUIRE(w < v);
+            REQUIRE(v == speed(10.0, speed::hunit_type()));
+
+            /* product/quotient: units multiply,  no rescale */
+            time t(2.0, time::hunit_type::from_abbrev("min"));
+            auto d = v * t;
+
+            static_assert(std::same_as<decltype(d), hquantity<u::meter>>);
+            REQUIRE(d.scale() == 72.0);
+            REQUIRE(d.native_scale() == Approx(1200.0));
+            REQUIRE(d.to_quantity<u::kilometer>().scale() == Approx(1.2));
+
+            auto v2 = d / t;
+            static_assert(std::same_as<decltype(v2), speed>);
+            REQUIRE(v2 == v);
+
+            /* rescale */
+            auto v3 = v.rescale(speed::hunit_type::from<u::meter / u::second>());
+            REQUIRE(v3.scale() == Approx(10.0));
+            REQUIRE((2.0 * v3).scale() == Approx(20.0));
+        } /*TEST_CASE(hquantity)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end hquantity.test.cpp */
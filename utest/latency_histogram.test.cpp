@@ -0,0 +1,126 @@
+/* @file latency_histogram.test.cpp */
+
+#include "xo/unit/latency_histogram.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <thread>
+#include <vector>
+
+namespace xo {
+    namespace qty {
+        TEST_CASE("hdr_layout", "[latency_histogram]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.hdr_layout"));
+
+            using layout = detail::hdr::layout<8>;
+
+            static_assert(layout::index(255) == 255);
+            static_assert(layout::index(256) == 256);
+            static_assert(layout::lo(256) == 256);
+            static_assert(layout::hi(256) == 257);
+            static_assert(layout::index(std::numeric_limits<std::uint64_t>::max()) == layout::n_bucket - 1);
+
+            /* buckets tile [0, 2^64) contiguously,  with bounded relative width */
+            for (std::size_t i = 0; i + 1 < layout::n_bucket; ++i) {
+                INFO(xtag("i", i));
+
+                REQUIRE(layout::hi(i) + 1 == layout::lo(i + 1));
+                REQUIRE(layout::index(layout::lo(i)) == i);
+                REQUIRE(layout::index(layout::hi(i)) == i);
+                REQUIRE((layout::hi(i) - layout::lo(i)) * 128 <= layout::lo(i));
+            }
+        } /*TEST_CASE(hdr_layout)*/
+
+        TEST_CASE("latency_histogram", "[latency_histogram]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.latency_histogram"));
+
+            latency_histogram<> h;
+
+            REQUIRE(h.n_sample() == 0);
+            REQUIRE(h.percentile(50.0).scale() == 0.0);
+
+            /* 1..1000 microseconds,  recorded in assorted units */
+            for (int i = 1; i <= 1000; ++i) {
+                if (i % 3 == 0)
+                    h.record(qty::microseconds(i));
+                else if (i % 3 == 1)
+                    h.record(qty::nanoseconds(1000.0 * i));
+                else
+                    h.record(qty::milliseconds(0.001 * i));
+            }
+
+            REQUIRE(h.n_sample() == 1000);
+            REQUIRE(h.min().scale() == 1000.0);
+            REQUIRE(h.max<u::microsecond>().scale() == Approx(1000.0));
+            REQUIRE(h.mean<u::microsecond>().scale() == Approx(500.5));
+
+            /* percentiles within bucket resolution,  never below exact value */
+            auto p50 = h.percentile<u::microsecond>(50.0);
+            auto p99 = h.percentile<u::millisecond>(99.0);
+
+            static_assert(std::same_as<decltype(p99), quantity<u::millisecond, double>>);
+
+            REQUIRE(p50.scale() >= 500.0);
+            REQUIRE(p50.scale() <= 500.0 * 1.008);
+            REQUIRE(p99.scale() >= 0.990);
+            REQUIRE(p99.scale() <= 0.990 * 1.008);
+            REQUIRE(h.percentile(100.0).scale() == h.max().scale());
+
+            /* negative intervals clamp to zero */
+            h.record(qty::nanoseconds(-5.0));
+            REQUIRE(h.min().scale() == 0.0);
+            REQUIRE(h.bucket_count(0) == 1);
+
+            /* merge */
+            latency_histogram<> h2;
+            h2.record(qty::seconds(1.0), 10);
+            h.merge(h2);
+
+            REQUIRE(h.n_sample() == 1011);
+            REQUIRE(h.max<u::second>().scale() == 1.0);
+            REQUIRE(h.percentile<u::second>(99.5).scale() == 1.0);
+
+            h.reset();
+            REQUIRE(h.n_sample() == 0);
+        } /*TEST_CASE(latency_histogram)*/
+
+        TEST_CASE("concurrent_latency_histogram", "[latency_histogram]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.concurrent_latency_histogram"));
+
+            constexpr int c_n_thread = 4;
+            constexpr int c_n_per_thread = 10000;
+
+            concurrent_latency_histogram<u::microsecond, 8, 4> ch;
+
+            std::vector<std::thread> thread_v;
+
+            for (int t = 0; t < c_n_thread; ++t) {
+                thread_v.emplace_back([&ch]() {
+                    for (int i = 1; i <= c_n_per_thread; ++i)
+                        ch.record(qty::nanoseconds(1000.0 * (i % 100 + 1)));
+                });
+            }
+
+            for (auto & th : thread_v)
+                th.join();
+
+            auto h = ch.snapshot();
+
+            REQUIRE(h.n_sample() == c_n_thread * c_n_per_thread);
+            REQUIRE(h.min().scale() == 1.0);
+            REQUIRE(h.max().scale() == 100.0);
+            REQUIRE(h.mean().scale() == Approx(50.5));
+            REQUIRE(h.percentile(50.0).scale() == 50.0);
+
+            ch.reset();
+            REQUIRE(ch.snapshot().n_sample() == 0);
+        } /*TEST_CASE(concurrent_latency_histogram)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end latency_histogram.test.cpp */
@@ -6,6 +6,7 @@
 #include "xo/indentlog/scope.hpp"
 #include "xo/indentlog/print/tag.hpp"
 #include <catch2/catch.hpp>
+#include <limits>
 
 namespace xo {
     using xo::qty::detail::su_product;
@@ -222,7 +223,7 @@ namespace xo {
                 static_assert(rr.outer_scale_sq_ == 1.0);
             }
 
-            /* keep spelled-out test.  Will generalize to other fractional powers when c++26 available */
+            /* keep spelled-out test */
             {
                 constexpr auto p = power_ratio_type(-1, 2);
 
@@ -258,11 +259,12 @@ namespace xo {
                            xtag("rr.outer_scale_sq", rr.outer_scale_sq_));
 
                 static_assert(rr.bpu_rescaled_.power() == power_ratio_type(-1,2));
-                static_assert(rr.outer_scale_factor_ == outer_sf_exact);
-                static_assert(rr.outer_scale_sq_ == 1 / 12.0);
+                /* 12^(-1/2) = (1/2).(1/3)^(1/2):  perfect square 4 extracted exactly */
+                static_assert(rr.outer_scale_factor_ == outer_sf_exact * scalefactor_ratio_type(1, 2));
+                static_assert(rr.outer_scale_sq_ == 1 / 3.0);
             }
 
-            /* keep spelled-out test.  Will generalize to other fractional powers when c++26 available */
+            /* keep spelled-out test */
             {
                 constexpr auto p = power_ratio_type(-3, 2);
 
@@ -297,11 +299,72 @@ namespace xo {
                            xtag("rr.outer_scale_sq", rr.outer_scale_sq_));
 
                 static_assert(rr.bpu_rescaled_.power() == power_ratio_type(-3,2));
-                static_assert(rr.outer_scale_factor_ == outer_sf_exact);
-                static_assert(rr.outer_scale_sq_ == 1 / 12.0);
+                static_assert(rr.outer_scale_factor_ == outer_sf_exact * scalefactor_ratio_type(1, 2));
+                static_assert(rr.outer_scale_sq_ == 1 / 3.0);
             }
         } /*TEST_CASE(bpu_rescale)*/
 
+        TEST_CASE("bpu_rescale_rational_power", "[bpu_rescale]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.bpu_rescale_rational_power"));
+
+            /* integer roots */
+            static_assert(detail::iroot_u64(1000, 3) == 10);
+            static_assert(detail::iroot_u64(999, 3) == 9);
+            static_assert(detail::iroot_u64(std::uint64_t(1) << 62, 2) == (std::uint64_t(1) << 31));
+            static_assert(detail::cx_root(27.0, 3) == 3.0);
+            static_assert(detail::cx_root(16.0, 4) == 2.0);
+
+            {
+                /* 8^(1/3) = 2 -- perfect cube,  exact */
+                constexpr auto rr = bpu2_rescale<int64_t>(bpu<int64_t>(dim::distance,
+                                                                       scalefactor_ratio_type(8, 1),
+                                                                       power_ratio_type(1, 3)),
+                                                          scalefactor_ratio_type(1, 1));
+
+                static_assert(rr.outer_scale_factor_ == scalefactor_ratio_type(2, 1));
+                static_assert(rr.outer_scale_sq_ == 1.0);
+            }
+
+            {
+                /* 8^(-2/3) = 1/4 */
+                constexpr auto rr = bpu2_rescale<int64_t>(bpu<int64_t>(dim::distance,
+                                                                       scalefactor_ratio_type(8, 1),
+                                                                       power_ratio_type(-2, 3)),
+                                                          scalefactor_ratio_type(1, 1));
+
+                static_assert(rr.outer_scale_factor_ == scalefactor_ratio_type(1, 4));
+                static_assert(rr.outer_scale_sq_ == 1.0);
+            }
+
+            {
+                /* 48^(5/4) = 48 * 48^(1/4) = 48 * 2 * 3^(1/4) */
+                constexpr auto rr = bpu2_rescale<int64_t>(bpu<int64_t>(dim::distance,
+                                                                       scalefactor_ratio_type(48, 1),
+                                                                       power_ratio_type(5, 4)),
+                                                          scalefactor_ratio_type(1, 1));
+
+                static_assert(rr.outer_scale_factor_ == scalefactor_ratio_type(96, 1));
+                /* [3^(1/4)]^2 = 3^(1/2) */
+                static_assert(rr.outer_scale_sq_ == detail::cx_sqrt(3.0));
+            }
+
+            {
+                /* 12^(1/3):  no cube factor */
+                constexpr auto rr = bpu2_rescale<int64_t>(bpu<int64_t>(dim::time,
+                                                                       scalefactor_ratio_type(12, 1),
+                                                                       power_ratio_type(1, 3)),
+                                                          scalefactor_ratio_type(1, 1));
+
+                log && log(xtag("rr.outer_scale_sq", rr.outer_scale_sq_));
+
+                static_assert(rr.outer_scale_factor_ == scalefactor_ratio_type(1, 1));
+                /* [12^(1/3)]^2 = 144^(1/3) */
+                REQUIRE(rr.outer_scale_sq_ == Approx(::cbrt(144.0)).epsilon(1e-15));
+            }
+        } /*TEST_CASE(bpu_rescale_rational_power)*/
+
         TEST_CASE("bpu_product", "[bpu_product]") {
             constexpr bool c_debug_flag = false;
 
@@ -415,6 +478,81 @@ namespace xo {
                 static_assert(v.n_bpu() == 2);
             }
         } /*TEST_CASE(bpu_array)*/
+
+        TEST_CASE("natural_unit_from_abbrev", "[natural_unit]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.natural_unit_from_abbrev"));
+
+            /* compile-time */
+            {
+                constexpr auto c_nu = ([]() {
+                    nu64_type nu;
+                    natural_unit_from_abbrev("kg.m.s^-2", &nu);
+                    return nu;
+                })();
+
+                static_assert(c_nu.n_bpu() == 3);
+                static_assert(c_nu[2].power() == power_ratio_type(-2));
+            }
+
+            /* round trip */
+            {
+                nu64_type nu_v[] = {
+                    nu::dimensionless,
+                    nu::milligram, nu::kilogram,
+                    nu::millimeter, nu::meter, nu::kilometer, nu::mile,
+                    nu::nanosecond, nu::second, nu::minute, nu::day,
+                    nu::year250, nu::currency, nu::price,
+                    nu::volatility_30d, nu::volatility_250d,
+                    nu::variance_360d,
+                    nu::meter.reciprocal(),
+                };
+
+                for (const auto & nu : nu_v) {
+                    INFO(xtag("abbrev", nu.abbrev()));
+
+                    nu64_type nu2;
+
+                    REQUIRE(natural_unit_from_abbrev(std::string_view(nu.abbrev().c_str()), &nu2));
+                    REQUIRE(nu2 == nu);
+                }
+            }
+
+            /* fractional power spellings */
+            {
+                nu64_type nu2;
+
+                REQUIRE(natural_unit_from_abbrev("yr250^-1/2", &nu2));
+                REQUIRE(nu2 == nu::volatility_250d);
+                REQUIRE(natural_unit_from_abbrev("yr250^(-1/2)", &nu2));
+                REQUIRE(nu2 == nu::volatility_250d);
+            }
+
+            /* malformed */
+            {
+                nu64_type nu2;
+
+                REQUIRE(!natural_unit_from_abbrev("furlong", &nu2));
+                REQUIRE(!natural_unit_from_abbrev("m^x", &nu2));
+                REQUIRE(!natural_unit_from_abbrev("m^1/0", &nu2));
+                REQUIRE(!natural_unit_from_abbrev("m.km", &nu2));
+                REQUIRE(!natural_unit_from_abbrev("m..s", &nu2));
+                /* exponent overflow rejected,  not wrapped */
+                REQUIRE(!natural_unit_from_abbrev("m^99999999999999999999", &nu2));
+                REQUIRE(!natural_unit_from_abbrev("m^1/18446744073709551617", &nu2));
+                REQUIRE(!natural_unit_from_abbrev("m^+-1", &nu2));
+                REQUIRE(!natural_unit_from_abbrev("m^+", &nu2));
+                REQUIRE(natural_unit_from_abbrev("m^+2", &nu2));
+                REQUIRE(nu2.lookup_dim(dim::distance).power() == power_ratio_type(2));
+
+                /* same checks in constant evaluation */
+                static_assert(![]() { nu64_type nu; return natural_unit_from_abbrev("m^99999999999999999999", &nu); }());
+                static_assert(![]() { nu64_type nu; return natural_unit_from_abbrev("m^+-1", &nu); }());
+                static_assert([]() { std::int64_t x = 0; return detail::parse_int64("-9223372036854775808", &x) && (x == std::numeric_limits<std::int64_t>::min()); }());
+                static_assert(![]() { std::int64_t x = 0; return detail::parse_int64("9223372036854775808", &x); }());
+            }
+        } /*TEST_CASE(natural_unit_from_abbrev)*/
     } /*namespace qty*/
 } /*namespace xo*/
 
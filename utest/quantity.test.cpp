@@ -512,6 +512,55 @@ namespace xo {
             static_assert(q3.unit()[0].power() == power_ratio_type(0,1));
 
         } /*TEST_CASE(quantity.mult2)*/
+
+        TEST_CASE("quantity.memo", "[quantity]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.quantity.memo"));
+
+            using int_type = std::int64_t;
+            using int2x_type = detail::width2x_t<int_type>;
+
+            /* memoized unit algebra agrees with direct evaluation */
+            constexpr auto p1 = detail::su_product_v<int_type, int2x_type, nu::kilometer, nu::meter>;
+            constexpr auto p2 = detail::su_product<int_type, int2x_type>(nu::kilometer, nu::meter);
+
+            static_assert(p1.natural_unit_ == p2.natural_unit_);
+            static_assert(p1.outer_scale_factor_ == p2.outer_scale_factor_);
+            static_assert(p1.outer_scale_sq_ == p2.outer_scale_sq_);
+
+            /* same-scale fast path in bpu product/ratio */
+            constexpr auto r1 = detail::su_ratio_v<int_type, int2x_type, nu::meter, nu::meter>;
+
+            static_assert(r1.natural_unit_.is_dimensionless());
+            static_assert(r1.outer_scale_factor_ == decltype(r1.outer_scale_factor_)(1));
+
+            /* subtraction across units */
+            auto d = qty::kilometers(1.0) - qty::meters(250.0);
+
+            static_assert(std::same_as<decltype(d), quantity<u::kilometer, double>>);
+            REQUIRE(d.scale() == Approx(0.75));
+        } /*TEST_CASE(quantity.memo)*/
+
+        TEST_CASE("quantity.rational_power", "[quantity]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.quantity.rational_power"));
+
+            /* conversion constant-folded:  km^(1/3) -> m^(1/3) is exactly 10 */
+            constexpr auto km3 = u::su_from_bu(detail::bu::kilometer, power_ratio_type(1, 3));
+            constexpr auto m3 = u::su_from_bu(detail::bu::meter, power_ratio_type(1, 3));
+
+            constexpr auto q = quantity<km3>(1.5).rescale_ext<m3>();
+
+            static_assert(q.scale() == 15.0);
+
+            /* volatility:  360d -> 30d multiplies by 12^(-1/2) = (1/2).(1/3)^(1/2) */
+            constexpr auto v = quantity<u::volatility_360d>(1.0).rescale_ext<u::volatility_30d>();
+
+            static_assert(v.scale() == 0.5 * detail::cx_sqrt(1.0 / 3.0));
+            REQUIRE(v.scale() == Approx(1.0 / ::sqrt(12.0)).epsilon(1e-15));
+        } /*TEST_CASE(quantity.rational_power)*/
     } /*namespace qty*/
 } /*namespace xo*/
 
@@ -0,0 +1,86 @@
+/* @file quantity_expr.test.cpp */
+
+#include "xo/unit/quantity_expr.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <vector>
+
+namespace xo {
+    namespace qty {
+        TEST_CASE("quantity_expr", "[quantity_expr]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.quantity_expr"));
+
+            auto d = qty::kilometers(3.0);
+            auto t1 = qty::milliseconds(200.0);
+            auto t2 = qty::seconds(1.5);
+            auto a = qty::meters(2.0) / (qty::seconds(1.0) * qty::seconds(1.0));
+
+            /* pairwise evaluation,  for reference */
+            auto ref = d / (t1 * t2) + a;
+
+            auto e = lazy(d) / (lazy(t1) * lazy(t2)) + lazy(a);
+
+            static_assert(quantity_expr_concept<decltype(e)>);
+
+            auto q = e.eval();
+
+            static_assert(std::same_as<decltype(q), decltype(ref)>);
+            REQUIRE(q.scale() == Approx(ref.scale()).epsilon(1e-14));
+
+            /* conversion to requested unit folded into final multiply */
+            auto q2 = e.eval_as<u::meter / (u::second * u::second)>();
+
+            REQUIRE(q2.scale() == Approx(ref.rescale_ext<u::meter / (u::second * u::second)>().scale()).epsilon(1e-14));
+            REQUIRE(q2.scale() == Approx(3000.0 / 0.3 + 2.0).epsilon(1e-14));
+
+            /* constexpr evaluation */
+            constexpr auto c = (lazy(qty::minutes(1.0)) + lazy(qty::seconds(30.0))).eval_as<u::second>();
+            static_assert(c.scale() == 90.0);
+
+            /* scalar operands,  subtraction */
+            auto e3 = (2.0 * lazy(qty::hours(1.0))) - lazy(qty::minutes(30.0));
+            REQUIRE(e3.eval_as<u::minute>().scale() == Approx(90.0));
+
+            /* mixing lazy node with plain quantity */
+            auto e4 = lazy(d) / t1;
+            REQUIRE(e4.eval_as<u::meter / u::second>().scale() == Approx(15000.0));
+        } /*TEST_CASE(quantity_expr)*/
+
+        TEST_CASE("quantity_expr_column", "[quantity_expr]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.quantity_expr_column"));
+
+            constexpr std::size_t n = 1000;
+
+            std::vector<quantity<u::kilometer>> d_v(n);
+            std::vector<quantity<u::millisecond>> t_v(n);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                d_v[i] = qty::kilometers(1.0 + i);
+                t_v[i] = qty::milliseconds(10.0 + 0.5 * i);
+            }
+
+            auto offset = qty::meters(0.25) / qty::seconds(1.0);
+
+            std::vector<quantity<u::meter / u::second>> out_v(n);
+
+            auto e = lazy_column(d_v) / lazy_column(t_v) + offset;
+
+            REQUIRE(e.size() == n);
+            REQUIRE(eval_column(e, std::span(out_v)) == n);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                INFO(xtag("i", i));
+
+                auto ref = (d_v[i] / t_v[i] + offset).rescale_ext<u::meter / u::second>();
+
+                REQUIRE(out_v[i].scale() == Approx(ref.scale()).epsilon(1e-14));
+            }
+        } /*TEST_CASE(quantity_expr_column)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end quantity_expr.test.cpp */
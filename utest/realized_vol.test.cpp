@@ -0,0 +1,270 @@
+/* @file realized_vol.test.cpp */
+
+#include "xo/unit/realized_vol.hpp"
+#include "xo/unit/quantity_iostream.hpp"
+#include "xo/randomgen/xoshiro256.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <vector>
+#include <limits>
+#include <cmath>
+
+namespace xo {
+    namespace qty {
+        using xo::rng::xoshiro256ss;
+
+        TEST_CASE("realized_vol.close_to_close", "[realized_vol]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.realized_vol.close_to_close"));
+
+            using t_type = quantity<u::day>;
+            using p_type = quantity<u::price>;
+
+            close_to_close_vol<u::volatility_250d, t_type> est;
+
+            static_assert(std::same_as<decltype(est.volatility()), quantity<u::volatility_250d>>);
+            static_assert(std::same_as<decltype(est.variance()), quantity<u::variance_250d>>);
+
+            REQUIRE(std::isnan(est.volatility().scale()));
+
+            /* daily log return of +/- 1%,  over 250 days */
+            double lp = 0.0;
+            for (int i = 0; i <= 250; ++i) {
+                est.add(t_type(i), p_type(100.0 * ::exp(lp)));
+                lp += ((i % 2 == 0) ? 0.01 : -0.01);
+            }
+
+            log && log(xtag("vol", est.volatility()));
+
+            REQUIRE(est.count() == 251);
+            REQUIRE(est.elapsed() == t_type(250.0));
+            /* 250 returns of 1% over 250 days;  variance 250 * 1e-4 per 250-day year */
+            REQUIRE(est.variance().scale() == Approx(0.025).epsilon(1e-9));
+            REQUIRE(est.volatility().scale() == Approx(::sqrt(0.025)).epsilon(1e-9));
+
+            /* same data,  different annualization */
+            close_to_close_vol<u::volatility_365d, t_type> est365;
+            lp = 0.0;
+            for (int i = 0; i <= 250; ++i) {
+                est365.add(t_type(i), p_type(100.0 * ::exp(lp)));
+                lp += ((i % 2 == 0) ? 0.01 : -0.01);
+            }
+
+            REQUIRE(est365.variance().scale() == Approx(0.025 * 365.0 / 250.0).epsilon(1e-9));
+        } /*TEST_CASE(realized_vol.close_to_close)*/
+
+        TEST_CASE("realized_vol.batch", "[realized_vol]") {
+            using t_type = quantity<u::second>;
+            using p_type = quantity<u::price>;
+
+            auto rng = xoshiro256ss(24680);
+
+            std::vector<t_type> t_v;
+            std::vector<p_type> p_v;
+
+            double p = 100.0;
+            for (std::size_t i = 0; i < 1003; ++i) {
+                p *= 1.0 + (static_cast<double>(rng() % 2001) - 1000.0) * 1e-6;
+
+                t_v.push_back(t_type(static_cast<double>(i)));
+                p_v.push_back(p_type(p));
+            }
+
+            close_to_close_vol<u::volatility_365d, t_type> est1;
+            close_to_close_vol<u::volatility_365d, t_type> est2;
+
+            for (std::size_t i = 0; i < t_v.size(); ++i)
+                est1.add(t_v[i], p_v[i]);
+
+            est2.add(std::span<const t_type>(t_v).subspan(0, 10), std::span<const p_type>(p_v).subspan(0, 10));
+            est2.add(std::span<const t_type>(t_v).subspan(10), std::span<const p_type>(p_v).subspan(10));
+
+            REQUIRE(est2.count() == est1.count());
+            REQUIRE(est2.elapsed() == est1.elapsed());
+            REQUIRE(est2.sum_sq() == Approx(est1.sum_sq()).epsilon(1e-13));
+            REQUIRE(est2.volatility().scale() == Approx(est1.volatility().scale()).epsilon(1e-13));
+        } /*TEST_CASE(realized_vol.batch)*/
+
+        TEST_CASE("realized_vol.parkinson", "[realized_vol]") {
+            using t_type = quantity<u::minute>;
+            using p_type = quantity<u::price>;
+
+            /* hourly bars,  timestamps in minutes */
+            parkinson_vol<u::volatility_365d, t_type> est(qty::hours(1));
+
+            REQUIRE(est.bar_width() == t_type(60.0));
+
+            /* two bars from ticks,  each with range e^0.02;  third bar left open */
+            est.add(t_type(0.0), p_type(100.0));
+            est.add(t_type(30.0), p_type(100.0 * ::exp(0.02)));
+            est.add(t_type(60.0), p_type(100.0));
+            est.add(t_type(90.0), p_type(100.0 * ::exp(-0.02)));
+            est.add(t_type(120.0), p_type(100.0));
+
+            REQUIRE(est.n_bar() == 2);
+
+            double bar_var = 0.02 * 0.02 / (4.0 * ::log(2.0));
+            /* 2 bars per 2 hours -> per-hour variance bar_var;  24*365 hours per year */
+            REQUIRE(est.variance().scale() == Approx(bar_var * 24.0 * 365.0).epsilon(1e-9));
+        } /*TEST_CASE(realized_vol.parkinson)*/
+
+        TEST_CASE("realized_vol.subsampled", "[realized_vol]") {
+            using t_type = quantity<u::second>;
+            using p_type = quantity<u::price>;
+
+            /* single grid,  5-second sampling */
+            subsampled_vol<u::volatility_250d, t_type> est1(qty::seconds(5));
+            /* two staggered grids */
+            subsampled_vol<u::volatility_250d, t_type, p_type, 2> est2(qty::seconds(5));
+
+            /* price alternates every second;  on a 5-second grid
+             * (t=0,5,10,..) sampled prices alternate too
+             */
+            for (int i = 0; i <= 20; ++i) {
+                t_type t(static_cast<double>(i));
+                p_type p((i % 2 == 0) ? 100.0 : 101.0);
+
+                est1.add(t, p);
+                est2.add(t, p);
+            }
+
+            /* grid 0: t=0,5,10,15,20 -> 4 returns;
+             * grid 1: t=2.5,7.5,12.5,17.5 -> 3 returns
+             */
+            REQUIRE(est1.n_return() == 4);
+            REQUIRE(est2.n_return() == 7);
+
+            double r = ::log(101.0 / 100.0);
+            double sec_per_year250 = 250.0 * 24.0 * 3600.0;
+
+            REQUIRE(est1.variance().scale() == Approx(4 * r * r / 20.0 * sec_per_year250).epsilon(1e-9));
+            REQUIRE(est2.variance().scale() == Approx(7 * r * r / 35.0 * sec_per_year250).epsilon(1e-9));
+        } /*TEST_CASE(realized_vol.subsampled)*/
+
+        TEST_CASE("realized_vol.log_normal", "[realized_vol]") {
+            auto rng = xoshiro256ss(13579);
+
+            /* batched path's log agrees with ::log to 1ulp */
+            for (std::size_t i = 0; i < 20000; ++i) {
+                double e = static_cast<double>(rng() % 1400001) * 1e-3 - 700.0;
+                double x = ((i % 2 == 0)
+                            ? ::exp(e)
+                            : 1.0 + e * 1e-9);
+                double y = ::log(x);
+
+                INFO(tostr(xtag("x", x), xtag("y", y)));
+
+                REQUIRE(detail::is_log_normal(x));
+                REQUIRE(::fabs(detail::log_normal(x) - y)
+                        <= ::fabs(std::nextafter(y, 0.0) - y));
+            }
+
+            REQUIRE(detail::log_normal(1.0) == 0.0);
+            REQUIRE(!detail::is_log_normal(0.0));
+            REQUIRE(!detail::is_log_normal(-1.0));
+            REQUIRE(!detail::is_log_normal(std::numeric_limits<double>::denorm_min()));
+            REQUIRE(!detail::is_log_normal(std::numeric_limits<double>::infinity()));
+            REQUIRE(!detail::is_log_normal(std::numeric_limits<double>::quiet_NaN()));
+
+            /* batched path falls back to ::log on a zero price */
+            using t_type = quantity<u::second>;
+            using p_type = quantity<u::price>;
+
+            std::vector<t_type> t_v = { t_type(0.0), t_type(1.0), t_type(2.0), t_type(3.0) };
+            std::vector<p_type> p_v = { p_type(100.0), p_type(101.0), p_type(0.0), p_type(100.0) };
+
+            close_to_close_vol<u::volatility_365d, t_type> est1;
+            close_to_close_vol<u::volatility_365d, t_type> est2;
+
+            for (std::size_t i = 0; i < t_v.size(); ++i)
+                est1.add(t_v[i], p_v[i]);
+            est2.add(std::span<const t_type>(t_v), std::span<const p_type>(p_v));
+
+            REQUIRE(std::isinf(est1.sum_sq()));
+            REQUIRE(std::isinf(est2.sum_sq()));
+        } /*TEST_CASE(realized_vol.log_normal)*/
+
+        TEST_CASE("realized_vol.parkinson_gap", "[realized_vol]") {
+            using t_type = quantity<u::minute>;
+            using p_type = quantity<u::price>;
+
+            parkinson_vol<u::volatility_365d, t_type> est(qty::hours(1));
+
+            /* bar [0,60) has range e^0.02;  bars [60,120) .. [240,300) are empty;
+             * bar [300,360) has range e^0.02
+             */
+            est.add(t_type(0.0), p_type(100.0));
+            est.add(t_type(30.0), p_type(100.0 * ::exp(0.02)));
+            est.add(t_type(310.0), p_type(100.0));
+            est.add(t_type(320.0), p_type(100.0 * ::exp(-0.02)));
+            est.add(t_type(360.0), p_type(100.0));
+
+            /* empty bars skipped */
+            REQUIRE(est.n_bar() == 2);
+
+            double bar_var = 0.02 * 0.02 / (4.0 * ::log(2.0));
+            REQUIRE(est.variance().scale() == Approx(bar_var * 24.0 * 365.0).epsilon(1e-9));
+        } /*TEST_CASE(realized_vol.parkinson_gap)*/
+
+        TEST_CASE("realized_vol.int_time", "[realized_vol]") {
+            using p_type = quantity<u::price>;
+
+            /* millisecond timestamps;  500us bar rounds to 1ms, not 0 */
+            {
+                using t_type = quantity<u::millisecond, std::int64_t>;
+
+                parkinson_vol<u::volatility_250d, t_type> est(qty::microseconds(500.0));
+
+                REQUIRE(est.bar_width().scale() == 1);
+
+                /* 400us rounds to zero;  clamped to one tick */
+                parkinson_vol<u::volatility_250d, t_type> est2(qty::microseconds(400.0));
+
+                REQUIRE(est2.bar_width().scale() == 1);
+
+                est.add(t_type(0), p_type(100.0));
+                est.add(t_type(1), p_type(101.0));
+                est.add(t_type(1000), p_type(100.0));
+
+                REQUIRE(est.n_bar() == 2);
+
+                /* zero width:  ignores ticks */
+                parkinson_vol<u::volatility_250d, t_type> est0(qty::seconds(0.0));
+
+                REQUIRE(est0.bar_width().scale() == 0);
+
+                est0.add(t_type(0), p_type(100.0));
+                est0.add(t_type(5), p_type(101.0));
+
+                REQUIRE(est0.n_bar() == 0);
+                REQUIRE(std::isnan(est0.volatility().scale()));
+            }
+
+            /* nanosecond timestamps;  1.5us interval is 1500ns, not 1000ns */
+            {
+                using t_type = quantity<u::nanosecond, std::int64_t>;
+
+                subsampled_vol<u::volatility_250d, t_type> est(qty::microseconds(1.5));
+
+                REQUIRE(est.interval().scale() == 1500);
+
+                for (int i = 0; i <= 6; ++i)
+                    est.add(t_type(i * 500), p_type((i % 2 == 0) ? 100.0 : 101.0));
+
+                /* grid points at 0, 1500, 3000 */
+                REQUIRE(est.n_return() == 2);
+
+                subsampled_vol<u::volatility_250d, t_type> est0(qty::nanoseconds(0));
+
+                est0.add(t_type(0), p_type(100.0));
+                est0.add(t_type(10), p_type(101.0));
+
+                REQUIRE(est0.n_return() == 0);
+                REQUIRE(std::isnan(est0.volatility().scale()));
+            }
+        } /*TEST_CASE(realized_vol.int_time)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end realized_vol.test.cpp */
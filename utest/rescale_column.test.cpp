@@ -0,0 +1,137 @@
+/* @file rescale_column.test.cpp */
+
+#include "xo/unit/rescale_column.hpp"
+#include "xo/unit/quantity_iostream.hpp"
+#include "xo/randomgen/xoshiro256.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <bit>
+#include <cmath>
+#include <vector>
+
+namespace xo {
+    namespace qty {
+        using xo::rng::xoshiro256ss;
+
+        TEST_CASE("cx_sqrt", "[constexpr_math]") {
+            using detail::cx_sqrt;
+
+            static_assert(cx_sqrt(0.0) == 0.0);
+            static_assert(cx_sqrt(1.0) == 1.0);
+            static_assert(cx_sqrt(4.0) == 2.0);
+            static_assert(cx_sqrt(0.25) == 0.5);
+            static_assert(cx_sqrt(2.0) == 1.4142135623730951);
+            static_assert(cx_sqrt(365.0 / 250.0) == 1.2083045973594573);
+            static_assert(cx_sqrt(-1.0) != cx_sqrt(-1.0));
+
+            REQUIRE(cx_sqrt(std::numeric_limits<double>::denorm_min()) == ::sqrt(std::numeric_limits<double>::denorm_min()));
+            REQUIRE(cx_sqrt(std::numeric_limits<double>::max()) == ::sqrt(std::numeric_limits<double>::max()));
+            REQUIRE(cx_sqrt(std::numeric_limits<double>::infinity()) == std::numeric_limits<double>::infinity());
+
+            /* random bit patterns for positive finite doubles: must match ::sqrt bit-for-bit */
+            auto rng = xoshiro256ss(1234567);
+
+            for (std::size_t i = 0; i < 100000; ++i) {
+                std::uint64_t bits = rng() & ~(std::uint64_t(1) << 63);
+                double x = std::bit_cast<double>(bits);
+
+                if (!std::isfinite(x))
+                    continue;
+
+                INFO(xtag("x", x));
+
+                REQUIRE(std::bit_cast<std::uint64_t>(cx_sqrt(x)) == std::bit_cast<std::uint64_t>(::sqrt(x)));
+            }
+        } /*TEST_CASE(cx_sqrt)*/
+
+        TEST_CASE("rescale_column.raw", "[rescale_column]") {
+            std::vector<double> src_v = { 1.0, 2.5, -3.0 };
+            std::vector<double> dest_v(src_v.size());
+
+            static_assert(detail::rescale_factor<u::millisecond, u::microsecond, double>() == 1000.0);
+
+            rescale_column<u::millisecond, u::microsecond, double>(src_v, dest_v);
+
+            REQUIRE(dest_v[0] == 1000.0);
+            REQUIRE(dest_v[1] == 2500.0);
+            REQUIRE(dest_v[2] == -3000.0);
+        } /*TEST_CASE(rescale_column.raw)*/
+
+        TEST_CASE("rescale_column.reannualize", "[rescale_column]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.rescale_column.reannualize"));
+
+            auto rng = xoshiro256ss(7654321);
+
+            constexpr std::size_t n = 1000;
+
+            /* volatilities */
+            {
+                using vol250_type = quantity<u::volatility_250d>;
+                using vol365_type = quantity<u::volatility_365d>;
+                using vol30_type = quantity<u::volatility_30d>;
+
+                std::vector<vol250_type> src_v;
+                for (std::size_t i = 0; i < n; ++i)
+                    src_v.push_back(vol250_type(static_cast<double>(rng() % 1000000) * 1e-6));
+
+                std::vector<vol365_type> dest_v(n);
+                std::vector<vol30_type> dest2_v(n);
+
+                reannualize(std::span<const vol250_type>(src_v), std::span<vol365_type>(dest_v));
+                reannualize(std::span<const vol250_type>(src_v), std::span<vol30_type>(dest2_v));
+
+                for (std::size_t i = 0; i < n; ++i) {
+                    auto x1 = src_v[i].rescale_ext<u::volatility_365d>();
+                    auto x2 = src_v[i].rescale_ext<u::volatility_30d>();
+
+                    REQUIRE(std::bit_cast<std::uint64_t>(dest_v[i].scale()) == std::bit_cast<std::uint64_t>(x1.scale()));
+                    REQUIRE(std::bit_cast<std::uint64_t>(dest2_v[i].scale()) == std::bit_cast<std::uint64_t>(x2.scale()));
+                }
+
+                log && log(xtag("src[0]", src_v[0]), xtag("dest[0]", dest_v[0]));
+
+                REQUIRE(dest_v[1].scale() == Approx(src_v[1].scale() * ::sqrt(365.0 / 250.0)).epsilon(1e-15));
+            }
+
+            /* variances */
+            {
+                using var250_type = quantity<u::variance_250d>;
+                using var360_type = quantity<u::variance_360d>;
+
+                static_assert(detail::rescale_factor<u::variance_250d, u::variance_360d, double>() == 360.0 / 250.0);
+
+                std::vector<var250_type> src_v;
+                for (std::size_t i = 0; i < n; ++i)
+                    src_v.push_back(var250_type(static_cast<double>(rng() % 1000000) * 1e-6));
+
+                std::vector<var360_type> dest_v(n);
+
+                reannualize(std::span<const var250_type>(src_v), std::span<var360_type>(dest_v));
+
+                for (std::size_t i = 0; i < n; ++i) {
+                    auto x1 = src_v[i].rescale_ext<u::variance_360d>();
+
+                    REQUIRE(std::bit_cast<std::uint64_t>(dest_v[i].scale()) == std::bit_cast<std::uint64_t>(x1.scale()));
+                }
+            }
+        } /*TEST_CASE(rescale_column.reannualize)*/
+
+        TEST_CASE("rescale_column.xquantity", "[rescale_column]") {
+            using xq_type = xquantity<double>;
+
+            std::vector<xq_type> src_v = { xq_type(0.2, nu::volatility_250d), xq_type(0.4, nu::volatility_250d) };
+            std::vector<xq_type> dest_v(src_v.size());
+
+            rescale_column(std::span<const xq_type>(src_v), nu::volatility_365d, std::span<xq_type>(dest_v));
+
+            for (std::size_t i = 0; i < src_v.size(); ++i) {
+                REQUIRE(dest_v[i].unit() == nu::volatility_365d);
+                REQUIRE(dest_v[i].scale() == src_v[i].rescale(nu::volatility_365d).scale());
+            }
+        } /*TEST_CASE(rescale_column.xquantity)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end rescale_column.test.cpp */
@@ -0,0 +1,157 @@
+/* @file running_stats.test.cpp */
+
+#include "xo/unit/running_stats.hpp"
+#include "xo/unit/quantity_iostream.hpp"
+#include "xo/unit/xquantity_iostream.hpp"
+#include "xo/randomgen/xoshiro256.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <vector>
+#include <cmath>
+
+namespace xo {
+    namespace qty {
+        using xo::rng::xoshiro256ss;
+
+        TEST_CASE("running_stats.quantity", "[running_stats]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.running_stats.quantity"));
+
+            using q_type = quantity<u::millisecond>;
+
+            running_stats<q_type> stats;
+
+            REQUIRE(stats.count() == 0);
+            REQUIRE(std::isnan(stats.mean().scale()));
+            REQUIRE(std::isnan(stats.variance().scale()));
+
+            std::vector<q_type> x_v = { q_type(2.0), q_type(4.0), q_type(4.0), q_type(4.0),
+                                        q_type(5.0), q_type(5.0), q_type(7.0), q_type(9.0) };
+
+            stats.add(x_v);
+
+            log && log(xtag("mean", stats.mean()), xtag("var", stats.variance()), xtag("stddev", stats.stddev()));
+
+            /* result types carry units */
+            static_assert(std::same_as<decltype(stats.mean()), q_type>);
+            static_assert(std::same_as<decltype(stats.stddev()), q_type>);
+            static_assert(std::same_as<decltype(stats.variance()), quantity<u::millisecond * u::millisecond>>);
+
+            REQUIRE(stats.count() == 8);
+            REQUIRE(stats.sum() == q_type(40.0));
+            REQUIRE(stats.mean() == q_type(5.0));
+            REQUIRE(stats.pop_variance().scale() == 4.0);
+            REQUIRE(stats.variance().scale() == Approx(32.0 / 7.0).epsilon(1e-15));
+            REQUIRE(stats.stddev().scale() == Approx(::sqrt(32.0 / 7.0)).epsilon(1e-15));
+            REQUIRE(stats.min() == q_type(2.0));
+            REQUIRE(stats.max() == q_type(9.0));
+        } /*TEST_CASE(running_stats.quantity)*/
+
+        TEST_CASE("running_stats.merge", "[running_stats]") {
+            using q_type = quantity<u::volatility_250d>;
+
+            auto rng = xoshiro256ss(98765);
+
+            constexpr std::size_t n = 1000;
+            constexpr std::size_t n_part = 4;
+
+            running_stats<q_type> whole;
+            running_stats<q_type> part_v[n_part];
+
+            for (std::size_t i = 0; i < n; ++i) {
+                q_type x(1e6 + static_cast<double>(rng() % 1000) * 1e-3);
+
+                whole.add(x);
+                part_v[i % n_part].add(x);
+            }
+
+            running_stats<q_type> merged;
+            for (const auto & p : part_v)
+                merged.merge(p);
+
+            REQUIRE(merged.count() == whole.count());
+            REQUIRE(merged.mean().scale() == Approx(whole.mean().scale()).epsilon(1e-14));
+            REQUIRE(merged.variance().scale() == Approx(whole.variance().scale()).epsilon(1e-9));
+            REQUIRE(merged.min() == whole.min());
+            REQUIRE(merged.max() == whole.max());
+            REQUIRE(merged.sum().scale() == Approx(whole.sum().scale()).epsilon(1e-15));
+        } /*TEST_CASE(running_stats.merge)*/
+
+        TEST_CASE("running_stats.xquantity", "[running_stats]") {
+            using xq_type = xquantity<double>;
+
+            running_stats<xq_type> stats;
+
+            /* mixed units;  established by first sample */
+            stats.add(xq_type(1.0, nu::second));
+            stats.add(xq_type(3000.0, nu::millisecond));
+
+            REQUIRE(stats.mean().unit() == nu::second);
+            REQUIRE(stats.mean().scale() == 2.0);
+            REQUIRE(stats.variance().unit() == (xq_type(1.0, nu::second) * xq_type(1.0, nu::second)).unit());
+            REQUIRE(stats.variance().scale() == 2.0);
+            REQUIRE(stats.stddev().unit() == nu::second);
+
+            /* merge accumulator with different unit */
+            running_stats<xq_type> stats2;
+            stats2.add(xq_type(5000.0, nu::millisecond));
+
+            stats.merge(stats2);
+
+            REQUIRE(stats.count() == 3);
+            REQUIRE(stats.mean().unit() == nu::second);
+            REQUIRE(stats.mean().scale() == Approx(3.0).epsilon(1e-15));
+            REQUIRE(stats.max().scale() == 5.0);
+        } /*TEST_CASE(running_stats.xquantity)*/
+
+        TEST_CASE("running_covariance", "[running_stats]") {
+            using qa_type = quantity<u::meter>;
+            using qb_type = quantity<u::second>;
+
+            running_covariance<qa_type, qb_type> cov;
+            running_covariance<qa_type, qb_type> cov1;
+            running_covariance<qa_type, qb_type> cov2;
+
+            for (int i = 0; i < 10; ++i) {
+                qa_type a(static_cast<double>(i));
+                qb_type b(2.0 * i + 1.0);
+
+                cov.add(a, b);
+                ((i < 3) ? cov1 : cov2).add(a, b);
+            }
+
+            static_assert(std::same_as<decltype(cov.covariance()), quantity<u::meter * u::second>>);
+
+            /* var(i) = 55/6 for i in 0..9 */
+            REQUIRE(cov.covariance().scale() == Approx(2.0 * 55.0 / 6.0).epsilon(1e-14));
+            REQUIRE(cov.correlation() == Approx(1.0).epsilon(1e-14));
+            REQUIRE(cov.mean_b() == qb_type(10.0));
+
+            cov1.merge(cov2);
+
+            REQUIRE(cov1.count() == 10);
+            REQUIRE(cov1.covariance().scale() == Approx(cov.covariance().scale()).epsilon(1e-14));
+        } /*TEST_CASE(running_covariance)*/
+
+        TEST_CASE("running_ewma", "[running_stats]") {
+            using q_type = quantity<u::second>;
+
+            running_ewma<q_type> ewma(0.5);
+
+            REQUIRE(std::isnan(ewma.value().scale()));
+
+            ewma.add(q_type(4.0));
+            REQUIRE(ewma.value() == q_type(4.0));
+
+            ewma.add(q_type(8.0));
+            REQUIRE(ewma.value() == q_type(6.0));
+
+            ewma.add(q_type(0.0));
+            REQUIRE(ewma.value() == q_type(3.0));
+            REQUIRE(ewma.count() == 3);
+        } /*TEST_CASE(running_ewma)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end running_stats.test.cpp */
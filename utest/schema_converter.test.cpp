@@ -0,0 +1,111 @@
+/* @file schema_converter.test.cpp */
+
+#include "xo/unit/schema_converter.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <vector>
+
+namespace xo {
+    namespace qty {
+        namespace {
+            struct fill_record {
+                quantity<u::millisecond> latency_;
+                quantity<u::kilometer> distance_;
+                quantity<u::nanosecond, std::int64_t> ts_;
+            };
+
+            using fill_converter = schema_converter<fill_record,
+                                                    &fill_record::latency_,
+                                                    &fill_record::distance_,
+                                                    &fill_record::ts_>;
+        }
+
+        TEST_CASE("schema_converter.compile", "[schema_converter]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.schema_converter.compile"));
+
+            static_assert(fill_converter::n_field == 3);
+
+            fill_converter cvt;
+
+            REQUIRE(!cvt.is_compiled());
+
+            /* source feed: different order,  different units,  extra field */
+            schema_field src[] = {
+                {"ts", nu::microsecond},
+                {"venue", nu::dimensionless},
+                {"lat", nu::microsecond},
+                {"dist", nu::meter},
+            };
+
+            REQUIRE(cvt.compile(src, {"lat", "dist", "ts"}));
+            REQUIRE(cvt.is_compiled());
+            REQUIRE(cvt.stride() == 4);
+            REQUIRE(cvt.source_index(0) == 2);
+            REQUIRE(cvt.source_index(1) == 3);
+            REQUIRE(cvt.source_index(2) == 0);
+            REQUIRE(cvt.factor(0) == Approx(1e-3));
+            REQUIRE(cvt.factor(1) == Approx(1e-3));
+            REQUIRE(cvt.factor(2) == Approx(1e3));
+
+            /* missing field */
+            REQUIRE(!cvt.compile(src, {"lat", "distance", "ts"}));
+            REQUIRE(!cvt.is_compiled());
+            REQUIRE(cvt.error_field() == 1);
+
+            /* dimension mismatch */
+            REQUIRE(!cvt.compile(src, {"lat", "dist", "dist"}));
+            REQUIRE(cvt.error_field() == 2);
+        } /*TEST_CASE(schema_converter.compile)*/
+
+        TEST_CASE("schema_converter.convert", "[schema_converter]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.schema_converter.convert"));
+
+            fill_converter cvt;
+
+            schema_field src[] = {
+                {"dist", nu::mile},
+                {"lat", nu::second},
+                {"ts", nu::nanosecond},
+            };
+
+            REQUIRE(cvt.compile(src, {"lat", "dist", "ts"}));
+
+            constexpr std::size_t c_n = 1000;
+
+            std::vector<double> row_v;
+            for (std::size_t i = 0; i < c_n; ++i) {
+                row_v.push_back(0.5 * i);
+                row_v.push_back(1e-3 * i);
+                row_v.push_back(1e9 + i);
+            }
+
+            /* one short partial record at end is ignored */
+            row_v.push_back(7.0);
+
+            std::vector<fill_record> out_v(c_n + 10);
+
+            REQUIRE(cvt.convert(std::span<const double>(row_v), std::span<fill_record>(out_v)) == c_n);
+
+            for (std::size_t i = 0; i < c_n; ++i) {
+                INFO(xtag("i", i));
+
+                REQUIRE(out_v[i].latency_.scale() == Approx(i));
+                REQUIRE(out_v[i].distance_.scale() == Approx(0.5 * i * 1.609344));
+                REQUIRE(out_v[i].ts_.scale() == static_cast<std::int64_t>(1e9 + i));
+            }
+
+            /* destination smaller than source */
+            REQUIRE(cvt.convert(std::span<const double>(row_v), std::span<fill_record>(out_v).subspan(0, 5)) == 5);
+
+            /* not compiled */
+            fill_converter cvt2;
+            REQUIRE(cvt2.convert(std::span<const double>(row_v), std::span<fill_record>(out_v)) == 0);
+        } /*TEST_CASE(schema_converter.convert)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end schema_converter.test.cpp */
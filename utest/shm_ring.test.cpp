@@ -0,0 +1,258 @@
+/* @file shm_ring.test.cpp */
+
+#include "xo/unit/shm_ring.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace xo {
+    namespace qty {
+        namespace {
+            struct fill_w {
+                quantity<u::microsecond> latency_;
+                quantity<u::meter> distance_;
+                quantity<u::nanosecond, std::int64_t> ts_;
+            };
+
+            /* same layout as fill_w,  different units */
+            struct fill_r {
+                quantity<u::millisecond> latency_;
+                quantity<u::kilometer> distance_;
+                quantity<u::microsecond, std::int64_t> ts_;
+            };
+
+            std::string ring_name(const char * tag) {
+                return std::string("/xo_unit_") + tag + "_" + std::to_string(::getpid());
+            }
+        }
+
+        TEST_CASE("shm_ring.scalar", "[shm_ring]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.shm_ring.scalar"));
+
+            using w_type = quantity<u::millisecond>;
+
+            std::string name = ring_name("scalar");
+
+            shm_ring_writer<w_type> w;
+
+            REQUIRE(w.create(name.c_str(), 5));
+            REQUIRE(w.capacity() == 8);
+
+            /* identity reader */
+            {
+                shm_ring_reader<w_type> r;
+
+                REQUIRE(r.attach(name.c_str()));
+                REQUIRE(r.is_identity());
+                REQUIRE(r.capacity() == 8);
+
+                for (int i = 0; i < 8; ++i)
+                    REQUIRE(w.try_push(w_type(i)));
+                REQUIRE(!w.try_push(w_type(99)));
+                REQUIRE(r.size() == 8);
+
+                w_type x;
+                for (int i = 0; i < 8; ++i) {
+                    REQUIRE(r.try_pop(&x));
+                    REQUIRE(x.scale() == i);
+                }
+                REQUIRE(!r.try_pop(&x));
+            }
+
+            /* converting reader */
+            {
+                shm_ring_reader<quantity<u::second>> r;
+
+                REQUIRE(r.attach(name.c_str()));
+                REQUIRE(!r.is_identity());
+                REQUIRE(r.factor(0) == Approx(1e-3));
+
+                w_type v[] = { w_type(1500), w_type(2500) };
+                REQUIRE(w.push(v) == 2);
+
+                std::vector<quantity<u::second>> out(4);
+                REQUIRE(r.pop(out) == 2);
+                REQUIRE(out[0].scale() == Approx(1.5));
+                REQUIRE(out[1].scale() == Approx(2.5));
+            }
+
+            /* dimension mismatch */
+            {
+                shm_ring_reader<quantity<u::meter>> r;
+
+                REQUIRE(!r.attach(name.c_str()));
+            }
+
+            /* representation mismatch */
+            {
+                shm_ring_reader<quantity<u::millisecond, std::int64_t>> r;
+
+                REQUIRE(!r.attach(name.c_str()));
+            }
+
+            w.close();
+            REQUIRE(shm_ring_writer<w_type>::unlink(name.c_str()));
+
+            /* no such segment */
+            {
+                shm_ring_reader<w_type> r;
+
+                REQUIRE(!r.attach(name.c_str()));
+            }
+        } /*TEST_CASE(shm_ring.scalar)*/
+
+        TEST_CASE("shm_ring.struct", "[shm_ring]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.shm_ring.struct"));
+
+            std::string name = ring_name("struct");
+
+            using writer_type = shm_ring_writer<fill_w, &fill_w::latency_, &fill_w::distance_, &fill_w::ts_>;
+            using reader_type = shm_ring_reader<fill_r, &fill_r::latency_, &fill_r::distance_, &fill_r::ts_>;
+
+            writer_type w;
+
+            REQUIRE(w.create(name.c_str(), 64));
+
+            reader_type r;
+
+            REQUIRE(r.attach(name.c_str()));
+            REQUIRE(!r.is_identity());
+            REQUIRE(r.factor(0) == Approx(1e-3));
+            REQUIRE(r.factor(1) == Approx(1e-3));
+            REQUIRE(r.factor(2) == Approx(1e-3));
+
+            constexpr std::size_t c_n = 100000;
+
+            /* producer on separate thread;  ring much smaller than message count */
+            std::thread producer([&w]() {
+                for (std::size_t i = 0; i < c_n; ) {
+                    fill_w x{ quantity<u::microsecond>(1000.0 * i),
+                              quantity<u::meter>(2.0 * i),
+                              quantity<u::nanosecond, std::int64_t>(1000 * i) };
+
+                    if (w.try_push(x))
+                        ++i;
+                }
+            });
+
+            std::size_t n_bad = 0;
+
+            for (std::size_t i = 0; i < c_n; ) {
+                fill_r x;
+
+                if (!r.try_pop(&x))
+                    continue;
+
+                if ((std::abs(x.latency_.scale() - i) > 1e-9 * i)
+                    || (std::abs(x.distance_.scale() - 2e-3 * i) > 1e-9 * i)
+                    || (x.ts_.scale() != static_cast<std::int64_t>(i)))
+                    ++n_bad;
+
+                ++i;
+            }
+
+            producer.join();
+
+            REQUIRE(n_bad == 0);
+            REQUIRE(r.size() == 0);
+
+            w.close();
+            writer_type::unlink(name.c_str());
+        } /*TEST_CASE(shm_ring.struct)*/
+
+        TEST_CASE("shm_ring.int_exact", "[shm_ring]") {
+            /* integer timestamps beyond 2^53 convert exactly (ns <-> us) */
+            using ns_type = quantity<u::nanosecond, std::int64_t>;
+            using us_type = quantity<u::microsecond, std::int64_t>;
+
+            std::string name = ring_name("int_exact");
+
+            shm_ring_writer<ns_type> w;
+
+            REQUIRE(w.create(name.c_str(), 4));
+
+            shm_ring_reader<us_type> r;
+
+            REQUIRE(r.attach(name.c_str()));
+            REQUIRE(!r.is_identity());
+
+            ns_type v[] = { ns_type(1700000000123456789), ns_type(-1700000000123456500), ns_type(1700000000123456499) };
+            REQUIRE(w.push(v) == 3);
+
+            std::vector<us_type> out(3);
+            REQUIRE(r.pop(out) == 3);
+            REQUIRE(out[0].scale() == 1700000000123457);
+            /* half away from zero */
+            REQUIRE(out[1].scale() == -1700000000123457);
+            REQUIRE(out[2].scale() == 1700000000123456);
+
+            w.close();
+            shm_ring_writer<ns_type>::unlink(name.c_str());
+
+            shm_ring_writer<us_type> w2;
+
+            REQUIRE(w2.create(name.c_str(), 4));
+
+            shm_ring_reader<ns_type> r2;
+
+            REQUIRE(r2.attach(name.c_str()));
+
+            us_type v2[] = { us_type(1700000000123457) };
+            REQUIRE(w2.push(v2) == 1);
+
+            ns_type x;
+            REQUIRE(r2.try_pop(&x));
+            REQUIRE(x.scale() == 1700000000123457000);
+
+            w2.close();
+            shm_ring_writer<us_type>::unlink(name.c_str());
+        } /*TEST_CASE(shm_ring.int_exact)*/
+
+        TEST_CASE("shm_ring.unpublished", "[shm_ring]") {
+            /* reader refuses a segment whose header ready word is not yet set */
+            using w_type = quantity<u::millisecond>;
+
+            std::string name = ring_name("unpublished");
+
+            shm_ring_writer<w_type> w;
+
+            REQUIRE(w.create(name.c_str(), 4));
+
+            int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+            REQUIRE(fd >= 0);
+            void * base = ::mmap(nullptr, detail::shm::c_header_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            ::close(fd);
+            REQUIRE(base != MAP_FAILED);
+
+            auto * ready = reinterpret_cast<std::atomic<std::uint64_t> *>(base);
+
+            REQUIRE(ready->load() == detail::shm::c_magic);
+
+            ready->store(0, std::memory_order_relaxed);
+
+            shm_ring_reader<w_type> r;
+
+            REQUIRE(!r.attach(name.c_str()));
+
+            ready->store(detail::shm::c_magic, std::memory_order_release);
+
+            REQUIRE(r.attach(name.c_str()));
+
+            ::munmap(base, detail::shm::c_header_bytes);
+
+            w.close();
+            shm_ring_writer<w_type>::unlink(name.c_str());
+        } /*TEST_CASE(shm_ring.unpublished)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end shm_ring.test.cpp */
@@ -0,0 +1,68 @@
+/* @file si_quantity.test.cpp */
+
+#include "xo/unit/si_quantity.hpp"
+#include "xo/unit/si_quantity_iostream.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <sstream>
+
+namespace xo {
+    namespace qty {
+        TEST_CASE("si_quantity", "[si_quantity]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.si_quantity"));
+
+            static_assert(sizeof(si_quantity<u::millisecond>) == sizeof(double));
+            static_assert(si_quantity<u::kilometer / u::millisecond>::s_native_unit.natural_unit_.abbrev()
+                          == (u::meter / u::second).natural_unit_.abbrev());
+
+            /* conversion at construction */
+            constexpr si_quantity<u::millisecond> t1 = qty::microseconds(250.0);
+            constexpr si_quantity<u::second> t2 = qty::seconds(1.0);
+
+            static_assert(t1.native_scale() == 0.00025);
+            static_assert(t2.native_scale() == 1.0);
+
+            /* sum: plain add,  left display unit */
+            constexpr auto t = t1 + t2;
+
+            static_assert(std::same_as<std::remove_cv_t<decltype(t)>, si_quantity<u::millisecond>>);
+            static_assert(t.native_scale() == 1.00025);
+            REQUIRE(t.display().scale() == Approx(1000.25));
+            REQUIRE(t.as<u::microsecond>().scale() == Approx(1000250.0));
+
+            /* comparison */
+            static_assert(t1 < t2);
+            static_assert(si_quantity<u::minute>(qty::seconds(60.0)) == si_quantity<u::second>(qty::minutes(1.0)));
+
+            /* product/quotient */
+            si_quantity<u::kilometer> d = qty::meters(1500.0);
+            auto v = d / t2;
+
+            static_assert(std::same_as<decltype(v)::repr_type, double>);
+            REQUIRE(v.native_scale() == 1500.0);
+            REQUIRE(v.as<u::meter / u::second>().scale() == Approx(1500.0));
+            REQUIRE(v.display().scale() == Approx(1.5));
+
+            auto area = d * d;
+            REQUIRE(area.native_scale() == 1500.0 * 1500.0);
+
+            /* scalar ops,  compound assignment */
+            auto t3 = 2.0 * t1;
+            t3 += t2;
+            t3 -= si_quantity<u::microsecond>(qty::microseconds(500.0));
+            REQUIRE(t3.native_scale() == Approx(1.0));
+
+            /* display-unit conversion copies native value */
+            si_quantity<u::hour> t4 = t3;
+            REQUIRE(t4.native_scale() == t3.native_scale());
+
+            std::stringstream ss;
+            ss << t;
+            REQUIRE(ss.str() == "1000.25ms");
+        } /*TEST_CASE(si_quantity)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end si_quantity.test.cpp */
@@ -0,0 +1,123 @@
+/* @file throughput.test.cpp */
+
+#include "xo/unit/throughput.hpp"
+#include "xo/unit/natural_unit.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+
+namespace xo {
+    namespace qty {
+        TEST_CASE("information", "[information]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.information"));
+
+            /* SI vs IEC prefixes */
+            static_assert(qty::kibibytes(1.0).rescale_ext<u::byte>().scale() == 1024.0);
+            static_assert(qty::kilobytes(1.0).rescale_ext<u::byte>().scale() == 1000.0);
+            static_assert(qty::bytes(1.0).rescale_ext<u::bit>().scale() == 8.0);
+
+            REQUIRE(qty::gibibytes(1.0).rescale_ext<u::megabyte>().scale() == Approx(1073.741824));
+            REQUIRE(qty::tebibytes(1.0).rescale_ext<u::terabyte>().scale() == Approx(1.099511627776));
+
+            /* mixed-unit arithmetic */
+            auto z = qty::kibibytes(1.0) + qty::bytes(512.0);
+            REQUIRE(z.rescale_ext<u::byte>().scale() == 1536.0);
+
+            REQUIRE(nu::mebibyte.abbrev() == nu_abbrev_type::from_chars("MiB"));
+            REQUIRE(u::byte_per_second.natural_unit_.abbrev() == nu_abbrev_type::from_chars("B.s^-1"));
+
+            natural_unit<std::int64_t> nu2;
+            REQUIRE(natural_unit_from_abbrev("GiB.ms^-1", &nu2));
+            REQUIRE(nu2.n_bpu() == 2);
+            REQUIRE(nu2[0].native_dim() == dim::information);
+        } /*TEST_CASE(information)*/
+
+        TEST_CASE("throughput", "[throughput]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.throughput"));
+
+            /* 5MB in 2.5ms = 2GB/s */
+            constexpr auto r = throughput<u::gigabyte_per_second>(qty::bytes(std::int64_t(5000000)),
+                                                                  qty::nanoseconds(std::int64_t(2500000)));
+            static_assert(r.scale() == 2.0);
+
+            REQUIRE(throughput<u::megabyte_per_second>(qty::mebibytes(1.0), qty::seconds(1.0)).scale()
+                    == Approx(1.048576));
+
+            /* message rate: messages per microsecond */
+            constexpr auto c_msg_per_us = u::message / u::microsecond;
+            REQUIRE(throughput<c_msg_per_us>(qty::messages(std::int64_t(3000)),
+                                             qty::milliseconds(1.0)).scale()
+                    == Approx(3.0));
+        } /*TEST_CASE(throughput)*/
+
+        TEST_CASE("packet_message", "[throughput]") {
+            /* packets and messages are distinct dimensions */
+            static_assert(u::packet.natural_unit_[0].native_dim() == dim::packet);
+            static_assert(u::message.natural_unit_[0].native_dim() == dim::message);
+
+            /* bytes/packet is a checked unit,  not a bare number */
+            auto z = qty::bytes(15000.0) / qty::packets(10.0);
+
+            static_assert(std::same_as<decltype(z), quantity<u::byte_per_packet, double>>);
+            REQUIRE(z.scale() == 1500.0);
+
+            /* kB/pkt -> B/pkt */
+            REQUIRE((qty::kilobytes(3.0) / qty::packets(2.0)).rescale_ext<u::byte_per_packet>().scale() == 1500.0);
+
+            /* packet rate */
+            REQUIRE(throughput<u::packet_per_second>(qty::packets(std::int64_t(500)),
+                                                     qty::milliseconds(std::int64_t(250))).scale()
+                    == Approx(2000.0));
+
+            /* msg counter on a meter */
+            using m_type = quantity<u::message, std::int64_t>;
+            using t_type = quantity<u::nanosecond, std::int64_t>;
+
+            throughput_meter<m_type, t_type> m;
+
+            static_assert(std::same_as<decltype(m)::rate_type, quantity<u::message_per_second, double>>);
+
+            m.sample(m_type(0), t_type(0));
+            REQUIRE(m.sample(m_type(50), t_type(1000000)).scale() == Approx(50000.0));
+
+            REQUIRE(nu::packet.abbrev() == nu_abbrev_type::from_chars("pkt"));
+            REQUIRE(u::byte_per_message.natural_unit_.abbrev() == nu_abbrev_type::from_chars("B.msg^-1"));
+
+            natural_unit<std::int64_t> nu2;
+            REQUIRE(natural_unit_from_abbrev("msg.s^-1", &nu2));
+            REQUIRE(nu2 == u::message_per_second.natural_unit_);
+        } /*TEST_CASE(packet_message)*/
+
+        TEST_CASE("throughput_meter", "[throughput]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.throughput_meter"));
+
+            throughput_meter<> m;
+
+            static_assert(std::same_as<decltype(m)::rate_type, quantity<u::byte_per_second, double>>);
+
+            using b = quantity<u::byte, std::int64_t>;
+            using t = quantity<u::nanosecond, std::int64_t>;
+
+            REQUIRE(m.sample(b(0), t(0)).scale() == 0.0);
+            REQUIRE(m.sample(b(1000), t(1000000)).scale() == Approx(1e6));
+            REQUIRE(m.sample(b(4000), t(2000000)).scale() == Approx(3e6));
+            /* time did not advance: ignored */
+            REQUIRE(m.sample(b(9000), t(2000000)).scale() == Approx(3e6));
+            REQUIRE(m.n_sample() == 3);
+            REQUIRE(m.mean_rate().scale() == Approx(2e6));
+
+            /* kibibytes per millisecond */
+            throughput_meter<b, t, u::kibibyte / u::millisecond> m2;
+
+            m2.sample(b(0), t(0));
+            REQUIRE(m2.sample(b(2048), t(1000000)).scale() == Approx(2.0));
+        } /*TEST_CASE(throughput_meter)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end throughput.test.cpp */
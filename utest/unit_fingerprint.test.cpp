@@ -0,0 +1,113 @@
+/* @file unit_fingerprint.test.cpp */
+
+#include "xo/unit/unit_wire.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <unordered_map>
+#include <string>
+
+namespace xo {
+    namespace qty {
+        namespace {
+            template <typename Unit, std::size_t N>
+            constexpr bool
+            distinct_fingerprints(const Unit (&unit_v)[N])
+            {
+                for (std::size_t i = 0; i < N; ++i) {
+                    for (std::size_t j = i + 1; j < N; ++j) {
+                        if (unit_v[i].fingerprint() == unit_v[j].fingerprint())
+                            return false;
+                    }
+                }
+                return true;
+            }
+
+            constexpr scaled_unit<std::int64_t> c_scaled_unit_v[] = {
+                u::meter, u::kilometer, u::second, u::millisecond, u::hour,
+                u::gram, u::kilogram,
+                u::meter / u::second, u::kilometer / u::hour, u::mile / u::hour,
+                u::meter * u::meter, u::kilometer * u::meter,
+                u::byte_per_second, u::kilobyte_per_second, u::mebibyte_per_second,
+                u::meter.reciprocal(), u::second.reciprocal(),
+            };
+
+            const char *
+            describe(const natural_unit<std::int64_t> & nu)
+            {
+                switch (nu.fingerprint()) {
+                case nu::meter.fingerprint(): return "distance";
+                case nu::second.fingerprint(): return "time";
+                default: return "other";
+                }
+            }
+        }
+
+        TEST_CASE("unit_fingerprint-collisions", "[unit_fingerprint]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.unit_fingerprint-collisions"));
+
+            /* every built-in natural unit */
+            static_assert(distinct_fingerprints(detail::wire::builtin_unit_v));
+            /* assorted scaled units,  including non-natural products */
+            static_assert(distinct_fingerprints(c_scaled_unit_v));
+
+            REQUIRE(describe(nu::meter) == std::string("distance"));
+            REQUIRE(describe(nu::second) == std::string("time"));
+            REQUIRE(describe(nu::kilometer) == std::string("other"));
+        } /*TEST_CASE(unit_fingerprint-collisions)*/
+
+        TEST_CASE("unit_fingerprint-stable", "[unit_fingerprint]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.unit_fingerprint-stable"));
+
+            /* pinned: fingerprints may be persisted,  so must not change */
+            static_assert(nu::dimensionless.fingerprint() == detail::c_fnv1a_basis);
+            static_assert(nu::meter.fingerprint() == 0xb0eeedac6bd5e5e4ull);
+            static_assert((u::meter / u::second).fingerprint() == 0xae76cf550fc5c15full);
+
+            /* bpu order and Int don't matter */
+            constexpr auto mps = (u::meter / u::second).natural_unit_;
+            constexpr auto spm = (u::second.reciprocal() * u::meter).natural_unit_;
+
+            static_assert(mps.fingerprint() == spm.fingerprint());
+            static_assert(mps.fingerprint() == mps.to_repr<std::int32_t>().fingerprint());
+
+            /* natural scaled unit agrees with its natural unit */
+            static_assert(u::kilometer.fingerprint() == nu::kilometer.fingerprint());
+            /* outer scale participates */
+            static_assert(!(u::kilometer * u::meter).is_natural());
+            static_assert((u::kilometer * u::meter).fingerprint()
+                          != (u::kilometer * u::meter).natural_unit_.fingerprint());
+        } /*TEST_CASE(unit_fingerprint-stable)*/
+
+        TEST_CASE("unit_fingerprint-hash", "[unit_fingerprint]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.unit_fingerprint-hash"));
+
+            std::unordered_map<natural_unit<std::int64_t>, std::string> nu_map;
+
+            nu_map[nu::meter] = "m";
+            nu_map[nu::second] = "s";
+            nu_map[(u::meter / u::second).natural_unit_] = "m/s";
+
+            REQUIRE(nu_map.size() == 3);
+            REQUIRE(nu_map.at((u::second.reciprocal() * u::meter).natural_unit_) == "m/s");
+            REQUIRE(nu_map.count(nu::kilometer) == 0);
+
+            std::unordered_map<scaled_unit<std::int64_t>, int> su_map;
+
+            su_map[u::meter] = 1;
+            su_map[u::kilometer * u::meter] = 2;
+
+            REQUIRE(su_map.at(u::meter) == 1);
+            REQUIRE(su_map.at(u::kilometer * u::meter) == 2);
+            REQUIRE(std::hash<scaled_unit<std::int64_t>>()(u::meter)
+                    == std::hash<natural_unit<std::int64_t>>()(nu::meter));
+        } /*TEST_CASE(unit_fingerprint-hash)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end unit_fingerprint.test.cpp */
@@ -0,0 +1,99 @@
+/* @file unit_instrument.test.cpp */
+
+#include "xo/unit/xquantity.hpp"
+#include "xo/unit/quantity.hpp"
+#include "xo/unit/unit_instrument.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <sstream>
+#include <cstring>
+
+namespace xo {
+    namespace qty {
+        namespace {
+            /** total count at sites of kind @p op whose function name contains @p fn **/
+            std::uint64_t
+            count_for(instrument::op op, const char * fn = "") {
+                std::uint64_t n = 0;
+
+                for (const auto & x : instrument::snapshot()) {
+                    if ((x.op_ == op) && std::strstr(x.function_, fn))
+                        n += x.count_;
+                }
+
+                return n;
+            }
+        }
+
+        TEST_CASE("instrument_registry", "[unit_instrument]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.instrument_registry"));
+
+            instrument::set_dump_at_exit(false);
+            instrument::reset();
+
+            REQUIRE(count_for(instrument::op::rescale) == 0);
+
+            auto here = std::source_location::current();
+
+            for (int i = 0; i < 10; ++i)
+                instrument::record(instrument::op::rescale, here, 0.001);
+            instrument::record(instrument::op::sqrt, here, 2.0);
+
+            auto v = instrument::snapshot();
+
+            REQUIRE(v.size() >= 2);
+            REQUIRE(count_for(instrument::op::rescale, here.function_name()) == 10);
+            REQUIRE(count_for(instrument::op::sqrt, here.function_name()) == 1);
+
+            /* busiest first */
+            REQUIRE(v[0].count_ >= v[1].count_);
+
+            std::stringstream ss;
+            instrument::dump(ss);
+
+            REQUIRE(ss.str().find("rescale factor=0.001") != std::string::npos);
+
+            instrument::reset();
+
+            REQUIRE(count_for(instrument::op::rescale, here.function_name()) == 0);
+        } /*TEST_CASE(instrument_registry)*/
+
+#ifdef XO_UNIT_INSTRUMENT
+        TEST_CASE("instrument_hooks", "[unit_instrument]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.instrument_hooks"));
+
+            instrument::reset();
+
+            const char * here = std::source_location::current().function_name();
+
+            auto x = natural_unit_qty(nu::meter) * 1500.0;
+            auto y = natural_unit_qty(nu::second) * 3.0;
+
+            /* rescale reports caller's location */
+            auto x2 = x.rescale(nu::kilometer);
+            REQUIRE(x2.scale() == 1.5);
+            REQUIRE(count_for(instrument::op::rescale, here) == 1);
+
+            /* identity rescale is not counted */
+            x.rescale(nu::meter);
+            REQUIRE(count_for(instrument::op::rescale, here) == 1);
+
+            /* dimension mismatch */
+            auto z = x + y;
+            REQUIRE(std::isnan(z.scale()));
+            REQUIRE(count_for(instrument::op::dim_mismatch) == 1);
+
+            /* runtime unit algebra */
+            auto r = x / y;
+            REQUIRE(r.scale() == 500.0);
+            REQUIRE(count_for(instrument::op::su_ratio) >= 1);
+        } /*TEST_CASE(instrument_hooks)*/
+#endif
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end unit_instrument.test.cpp */
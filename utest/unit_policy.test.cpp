@@ -0,0 +1,62 @@
+/* @file unit_policy.test.cpp */
+
+#include "xo/unit/unit_policy.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+
+namespace xo {
+    namespace qty {
+        namespace {
+            template <auto S1, auto S2>
+            constexpr bool same_unit() {
+                return (S1.natural_unit_.abbrev() == S2.natural_unit_.abbrev());
+            }
+        }
+
+        TEST_CASE("unit_policy", "[unit_policy]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.unit_policy"));
+
+            constexpr auto x = qty::kilometers(2.0);
+            constexpr auto y = qty::meters(3.0);
+
+            /* left_wins agrees with operator* */
+            constexpr auto a0 = multiply<unit_policy::left_wins>(x, y);
+            auto ref = x * y;
+
+            static_assert(std::same_as<std::remove_cv_t<decltype(a0)>, decltype(ref)>);
+            REQUIRE(a0.scale() == Approx(ref.scale()));
+            REQUIRE(a0.scale() == Approx(0.006));
+
+            /* finest_unit: m^2 */
+            constexpr auto a1 = multiply<unit_policy::finest_unit>(x, y);
+            static_assert(same_unit<a1.s_scaled_unit, u::meter * u::meter>());
+            static_assert(a1.scale() == 6000.0);
+
+            /* si_canonical: kilogram for mass */
+            constexpr auto p = multiply<unit_policy::si_canonical>(qty::grams(500.0), qty::kilometers(1.0));
+            static_assert(same_unit<p.s_scaled_unit, u::kilogram * u::meter>());
+            REQUIRE(p.scale() == Approx(500.0));
+
+            /* divide */
+            constexpr auto v = divide<unit_policy::si_canonical>(qty::kilometers(36.0), qty::hours(1.0));
+            static_assert(same_unit<v.s_scaled_unit, u::meter / u::second>());
+            REQUIRE(v.scale() == Approx(10.0));
+
+            constexpr auto v2 = divide<unit_policy::finest_unit>(qty::kilometers(36.0), qty::milliseconds(1.0));
+            static_assert(same_unit<v2.s_scaled_unit, u::kilometer / u::millisecond>());
+            static_assert(v2.scale() == 36.0);
+
+            /* per-namespace alias: chain stays in one unit */
+            using arith = policy_arith<unit_policy::finest_unit>;
+
+            auto m2 = arith::multiply(qty::meters(2.0), qty::meters(3.0));
+            auto m3 = arith::multiply(m2, qty::meters(4.0));
+            static_assert(same_unit<decltype(m3)::s_scaled_unit, u::meter * u::meter * u::meter>());
+            REQUIRE(m3.scale() == 24.0);
+        } /*TEST_CASE(unit_policy)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end unit_policy.test.cpp */
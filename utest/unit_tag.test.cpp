@@ -0,0 +1,110 @@
+/* @file unit_tag.test.cpp */
+
+#include "xo/unit/unit_tag.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <typeinfo>
+#include <cstring>
+
+namespace xo {
+    namespace qty {
+        namespace {
+            XO_UNIT_TAG(m_tag, u::meter);
+            XO_UNIT_TAG(s_tag, u::second);
+            XO_UNIT_TAG(mps_tag, u::meter / u::second);
+
+            using distance_t = tagged_quantity<m_tag>;
+            using duration_t = tagged_quantity<s_tag>;
+            using speed_t = tagged_quantity<mps_tag>;
+
+            speed_t
+            average_speed(distance_t d, duration_t t)
+            {
+                return d / t;
+            }
+        }
+
+        TEST_CASE("unit_tag-layout", "[unit_tag]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.unit_tag-layout"));
+
+            static_assert(quantity_concept<speed_t>);
+            static_assert(is_tagged_quantity_v<speed_t>);
+            static_assert(!is_tagged_quantity_v<quantity<u::meter / u::second>>);
+            static_assert(sizeof(speed_t) == sizeof(double));
+            static_assert(std::is_trivially_copyable_v<speed_t>);
+            static_assert(speed_t::s_scaled_unit == (u::meter / u::second));
+
+            /* the point:  type name doesn't spell out the unit */
+            std::size_t tagged_len = std::strlen(typeid(speed_t).name());
+            std::size_t plain_len = std::strlen(typeid(quantity<u::meter / u::second>).name());
+
+            log && log(xtag("tagged_len", tagged_len), xtag("plain_len", plain_len));
+
+            REQUIRE(tagged_len * 4 < plain_len);
+        } /*TEST_CASE(unit_tag-layout)*/
+
+        TEST_CASE("unit_tag-convert", "[unit_tag]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.unit_tag-convert"));
+
+            /* from quantity in same unit;  no arithmetic */
+            constexpr distance_t d1 = qty::meters(2.5);
+            static_assert(d1.scale() == 2.5);
+
+            /* from quantity in another unit of the same dimension */
+            distance_t d2 = qty::kilometers(1.5);
+            REQUIRE(d2.scale() == 1500.0);
+
+            /* explicit from repr */
+            constexpr duration_t t1(4.0);
+            static_assert(t1.scale() == 4.0);
+
+            /* to quantity,  either unit */
+            quantity<u::meter> q1 = d2;
+            REQUIRE(q1.scale() == 1500.0);
+            quantity<u::kilometer> q2 = d2;
+            REQUIRE(q2.scale() == 1.5);
+            REQUIRE(d2.to_quantity().scale() == 1500.0);
+
+            /* assignment */
+            speed_t v;
+            v = qty::kilometers(36.0) / qty::hours(1.0);
+            REQUIRE(v.scale() == Approx(10.0).epsilon(1e-12));
+        } /*TEST_CASE(unit_tag-convert)*/
+
+        TEST_CASE("unit_tag-arith", "[unit_tag]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.unit_tag-arith"));
+
+            distance_t d = qty::meters(100.0);
+            duration_t t = qty::seconds(8.0);
+
+            speed_t v = average_speed(d, t);
+            REQUIRE(v.scale() == 12.5);
+
+            /* arithmetic yields plain quantities */
+            auto d2 = v * qty::minutes(1.0);
+            static_assert(!is_tagged_quantity_v<decltype(d2)>);
+            REQUIRE(d2.rescale_ext<u::meter>().scale() == Approx(750.0).epsilon(1e-12));
+
+            auto d3 = d + qty::kilometers(1.0);
+            REQUIRE(d3.scale() == 1100.0);
+
+            auto d4 = d - distance_t(30.0);
+            REQUIRE(d4.scale() == 70.0);
+
+            REQUIRE(d < qty::kilometers(1.0));
+            REQUIRE(d == qty::meters(100.0));
+            REQUIRE(distance_t(1000.0) == qty::kilometers(1.0));
+
+            d += qty::meters(5.0);
+            REQUIRE(d.scale() == 105.0);
+        } /*TEST_CASE(unit_tag-arith)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end unit_tag.test.cpp */
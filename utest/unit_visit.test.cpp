@@ -0,0 +1,86 @@
+/* @file unit_visit.test.cpp */
+
+#include "xo/unit/unit_visit.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <vector>
+
+namespace xo {
+    namespace qty {
+        TEST_CASE("visit_unit", "[unit_visit]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.visit_unit"));
+
+            auto kernel = [](std::size_t * p_match, double * p_ms)
+                {
+                    return [p_match, p_ms]<typename Quantity>(std::type_identity<Quantity>, Quantity q) {
+                        if constexpr (Quantity::s_scaled_unit.natural_unit_ == u::second.natural_unit_)
+                            *p_match = 0;
+                        else if constexpr (Quantity::s_scaled_unit.natural_unit_ == u::millisecond.natural_unit_)
+                            *p_match = 1;
+                        else
+                            *p_match = 2;
+
+                        *p_ms = q.template rescale_ext<u::millisecond>().scale();
+                    };
+                };
+
+            std::size_t match = 99;
+            double ms = 0.0;
+
+            REQUIRE(visit<u::second, u::millisecond, u::microsecond>(xquantity(2.5, u::second.natural_unit_),
+                                                                     kernel(&match, &ms)));
+            REQUIRE(match == 0);
+            REQUIRE(ms == Approx(2500.0));
+
+            REQUIRE(visit<u::second, u::millisecond, u::microsecond>(xquantity(500.0, u::microsecond.natural_unit_),
+                                                                     kernel(&match, &ms)));
+            REQUIRE(match == 2);
+            REQUIRE(ms == Approx(0.5));
+
+            /* not in list: kernel not invoked */
+            match = 99;
+            REQUIRE(!visit<u::second, u::millisecond, u::microsecond>(xquantity(1.0, u::minute.natural_unit_),
+                                                                      kernel(&match, &ms)));
+            REQUIRE(!visit<u::second, u::millisecond, u::microsecond>(xquantity(1.0, u::meter.natural_unit_),
+                                                                      kernel(&match, &ms)));
+            REQUIRE(match == 99);
+        } /*TEST_CASE(visit_unit)*/
+
+        TEST_CASE("visit_column", "[unit_visit]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.visit_column"));
+
+            std::vector<double> col = { 1.0, 2.0, 3.5 };
+
+            auto total_mps = [&col](const natural_unit<std::int64_t> & nu, double * p_total) {
+                *p_total = 0.0;
+
+                return visit_column<u::meter / u::second,
+                                    u::kilometer / u::hour,
+                                    u::mile / u::hour>
+                    (std::span<const double>(col), nu,
+                     [p_total]<typename Quantity>(std::type_identity<Quantity>, std::span<const double> v) {
+                         for (double x : v)
+                             *p_total += Quantity(x).template rescale_ext<u::meter / u::second>().scale();
+                     });
+            };
+
+            double total = 0.0;
+
+            REQUIRE(total_mps((u::meter / u::second).natural_unit_, &total));
+            REQUIRE(total == Approx(6.5));
+
+            natural_unit<std::int64_t> kmh;
+            REQUIRE(natural_unit_from_abbrev("hr^-1.km", &kmh));
+            REQUIRE(total_mps(kmh, &total));
+            REQUIRE(total == Approx(6.5 / 3.6));
+
+            REQUIRE(!total_mps((u::meter / u::minute).natural_unit_, &total));
+        } /*TEST_CASE(visit_column)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end unit_visit.test.cpp */
@@ -0,0 +1,253 @@
+/* @file unit_wire.test.cpp */
+
+#include "xo/unit/unit_wire.hpp"
+#include "xo/unit/xquantity_iostream.hpp"
+#include "xo/indentlog/scope.hpp"
+#include <catch2/catch.hpp>
+#include <array>
+
+namespace xo {
+    namespace qty {
+        TEST_CASE("unit_wire.builtin", "[unit_wire]") {
+            /* compile-time code lookup */
+            static_assert(detail::wire::builtin_code(nu::dimensionless) == 0);
+            static_assert(detail::wire::builtin_code(nu::meter) != detail::wire::c_escape);
+            static_assert(detail::wire::builtin_code(u::meter.natural_unit_) == detail::wire::builtin_code(nu::meter));
+
+            for (unit_code_type i = 0; i < detail::wire::n_builtin; ++i) {
+                INFO(xtag("i", i));
+
+                REQUIRE(detail::wire::builtin_code(detail::wire::builtin_unit_v[i]) == i);
+            }
+        } /*TEST_CASE(unit_wire.builtin)*/
+
+        TEST_CASE("unit_wire.xquantity", "[unit_wire]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.unit_wire.xquantity"));
+
+            using xq_type = xquantity<double>;
+
+            std::array<std::byte, 1024> buf;
+            wire_writer<> w(buf);
+
+            xq_type q1(1.5, nu::meter);
+            /* not built-in: goes to dictionary */
+            xq_type q2 = xq_type(2.0, nu::kilogram) * xq_type(3.0, nu::meter) / (xq_type(1.0, nu::second) * xq_type(1.0, nu::second));
+            xq_type q3(-7.25, nu::volatility_250d);
+
+            REQUIRE(w.write(q1));
+            REQUIRE(w.size() == 2 + 8);
+            REQUIRE(w.write(q2));
+            REQUIRE(w.dictionary().size() == 1);
+            std::size_t z2 = w.size();
+            /* second occurrence uses dictionary code */
+            REQUIRE(w.write(q2));
+            REQUIRE(w.size() == z2 + 2 + 8);
+            REQUIRE(w.write(q3));
+            REQUIRE(w.write_unit(nu::hour));
+
+            log && log(xtag("size", w.size()));
+
+            wire_reader<> r(w.written());
+
+            xq_type x;
+            REQUIRE(r.read(&x));
+            REQUIRE(x.scale() == q1.scale());
+            REQUIRE(x.unit() == q1.unit());
+            REQUIRE(r.read(&x));
+            REQUIRE(x.scale() == q2.scale());
+            REQUIRE(x.unit() == q2.unit());
+            REQUIRE(r.read(&x));
+            REQUIRE(x.unit() == q2.unit());
+            REQUIRE(r.read(&x));
+            REQUIRE(x.scale() == q3.scale());
+            REQUIRE(x.unit() == q3.unit());
+
+            natural_unit<std::int64_t> nu;
+            REQUIRE(r.read_unit(&nu));
+            REQUIRE(nu == nu::hour);
+            REQUIRE(r.at_end());
+
+            /* reading past end fails without moving */
+            REQUIRE(!r.read(&x));
+            REQUIRE(r.position() == w.size());
+        } /*TEST_CASE(unit_wire.xquantity)*/
+
+        TEST_CASE("unit_wire.quantity", "[unit_wire]") {
+            std::array<std::byte, 256> buf;
+            wire_writer<> w(buf);
+
+            auto q1 = qty::milliseconds(250.0);
+            auto q2 = qty::meters(3.0) / qty::seconds(2.0);
+
+            REQUIRE(w.write(q1));
+            REQUIRE(w.write(q2));
+            REQUIRE(w.write(q1));
+
+            wire_reader<> r(w.written());
+
+            /* same unit */
+            quantity<u::millisecond> x1;
+            REQUIRE(r.read(&x1));
+            REQUIRE(x1 == q1);
+
+            /* non-built-in unit via dictionary */
+            decltype(q2) x2;
+            REQUIRE(r.read(&x2));
+            REQUIRE(x2 == q2);
+
+            /* rescaled on read */
+            quantity<u::second> x3;
+            REQUIRE(r.read(&x3));
+            REQUIRE(x3.scale() == 0.25);
+        } /*TEST_CASE(unit_wire.quantity)*/
+
+        TEST_CASE("unit_wire.retry", "[unit_wire]") {
+            constexpr bool c_debug_flag = false;
+
+            scope log(XO_DEBUG2(c_debug_flag, "TEST_CASE.unit_wire.retry"));
+
+            using xq_type = xquantity<double>;
+
+            std::array<std::byte, 1024> buf;
+            wire_writer<> w(buf);
+
+            /* not built-in: first write defines,  second uses dictionary code */
+            xq_type q1 = xq_type(2.0, nu::kilogram) * xq_type(3.0, nu::meter);
+            xq_type q2(5.0, nu::meter);
+
+            REQUIRE(w.write(q1));
+            std::size_t z1 = w.size();
+            REQUIRE(w.write(q2));
+            REQUIRE(w.write(q1));
+
+            std::span<const std::byte> all = w.written();
+
+            /* define record truncated inside payload */
+            wire_reader<> r(all.first(z1 - 1));
+
+            xq_type x;
+            REQUIRE(!r.read(&x));
+            REQUIRE(r.position() == 0);
+            REQUIRE(r.dictionary().size() == 0);
+
+            /* failed retry on the same short buffer doesn't change anything either */
+            REQUIRE(!r.read(&x));
+            REQUIRE(r.dictionary().size() == 0);
+
+            /* rest of input arrives */
+            r.extend(all);
+
+            REQUIRE(r.read(&x));
+            REQUIRE(x.scale() == q1.scale());
+            REQUIRE(x.unit() == q1.unit());
+            REQUIRE(r.dictionary().size() == 1);
+
+            REQUIRE(r.read(&x));
+            REQUIRE(x.unit() == q2.unit());
+
+            /* dictionary-coded record decodes to the defined unit */
+            REQUIRE(r.read(&x));
+            REQUIRE(x.scale() == q1.scale());
+            REQUIRE(x.unit() == q1.unit());
+            REQUIRE(r.at_end());
+        } /*TEST_CASE(unit_wire.retry)*/
+
+        TEST_CASE("unit_wire.limits", "[unit_wire]") {
+            using xq_type = xquantity<double>;
+
+            /* buffer too small: no partial writes */
+            {
+                std::array<std::byte, 9> buf;
+                wire_writer<> w(buf);
+
+                REQUIRE(!w.write(xq_type(1.0, nu::meter)));
+                REQUIRE(w.size() == 0);
+            }
+
+            /* dictionary full: falls back to inline escape */
+            {
+                std::array<std::byte, 1024> buf;
+                wire_writer<1> w(buf);
+
+                xq_type q1 = xq_type(1.0, nu::meter) / xq_type(1.0, nu::second);
+                xq_type q2 = xq_type(1.0, nu::meter) / xq_type(1.0, nu::minute);
+
+                REQUIRE(w.write(q1));
+                REQUIRE(w.write(q2));
+                REQUIRE(w.write(q2));
+                REQUIRE(w.dictionary().size() == 1);
+
+                wire_reader<1> r(w.written());
+                xq_type x;
+
+                for (std::size_t i = 0; i < 3; ++i) {
+                    REQUIRE(r.read(&x));
+                    REQUIRE(x.unit() == ((i == 0) ? q1.unit() : q2.unit()));
+                }
+            }
+
+            /* unknown dictionary code */
+            {
+                std::array<std::byte, 10> buf = {};
+                detail::wire::put_le(&buf[0], static_cast<unit_code_type>(detail::wire::n_builtin + 3));
+
+                wire_reader<> r(buf);
+                xq_type x;
+
+                REQUIRE(!r.read(&x));
+                REQUIRE(r.position() == 0);
+            }
+        } /*TEST_CASE(unit_wire.limits)*/
+
+        TEST_CASE("unit_wire.malformed_unit", "[unit_wire]") {
+            using detail::wire::c_bpu_bytes;
+
+            /* encode m.s^-1,  then corrupt it */
+            natural_unit<std::int64_t> mps = (xquantity<double>(1.0, nu::meter)
+                                              / xquantity<double>(1.0, nu::second)).unit();
+            std::array<std::byte, 1 + 2 * c_bpu_bytes> good;
+
+            REQUIRE(detail::wire::put_unit(good.data(), mps) == good.data() + good.size());
+
+            natural_unit<std::int64_t> x;
+
+            REQUIRE(detail::wire::get_unit(good, &x) == good.size());
+            REQUIRE(x == mps);
+
+            /* repeated dimension:  m.m^-1 */
+            {
+                auto buf = good;
+                buf[1 + c_bpu_bytes] = static_cast<std::byte>(dim::distance);
+
+                REQUIRE(detail::wire::get_unit(buf, &x) == 0);
+            }
+
+            /* zero power */
+            {
+                auto buf = good;
+                detail::wire::put_le(&buf[1 + c_bpu_bytes + 17], std::int16_t(0));
+
+                REQUIRE(detail::wire::get_unit(buf, &x) == 0);
+            }
+
+            /* non-positive scalefactor */
+            {
+                auto buf = good;
+                detail::wire::put_le(&buf[1 + 1], std::int64_t(0));
+
+                REQUIRE(detail::wire::get_unit(buf, &x) == 0);
+
+                detail::wire::put_le(&buf[1 + 1], std::int64_t(-1));
+
+                REQUIRE(detail::wire::get_unit(buf, &x) == 0);
+            }
+
+            /* x unchanged by rejected records */
+            REQUIRE(x == mps);
+        } /*TEST_CASE(unit_wire.malformed_unit)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end unit_wire.test.cpp */
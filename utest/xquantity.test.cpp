@@ -128,8 +128,19 @@ namespace xo {
         vector<natural_unit<int64_t>> price_unit_v
         = { nu::price };
 
+        vector<natural_unit<int64_t>> information_unit_v
+        = { nu::bit, nu::byte, nu::kilobyte, nu::megabyte, nu::gigabyte, nu::terabyte,
+            nu::kibibyte, nu::mebibyte, nu::gibibyte, nu::tebibyte };
+
+        vector<natural_unit<int64_t>> packet_unit_v
+        = { nu::packet };
+
+        vector<natural_unit<int64_t>> message_unit_v
+        = { nu::message };
+
         vector<vector<natural_unit<int64_t>> *> all_unit_v = {
-            &mass_unit_v, &distance_unit_v, &time_unit_v, &currency_unit_v, &price_unit_v
+            &mass_unit_v, &distance_unit_v, &time_unit_v, &currency_unit_v, &price_unit_v,
+            &information_unit_v, &packet_unit_v, &message_unit_v
         };
 
         template <typename Rng>